@@ -23,6 +23,11 @@ UOpenXRHandPoseComponent::UOpenXRHandPoseComponent(const FObjectInitializer& Obj
 	bDetectGestures = true;
 	SetIsReplicatedByDefault(true);
 	bGetMockUpPoseForDebugging = false;
+
+	bUseDeltaSkeletalReplication = false;
+	SkeletalDeltaKeyframeInterval = 10;
+	SkeletalDeltaAngleThreshold = 0.5f;
+	SkeletalDeltaPositionThreshold = 0.05f;
 }
 
 void UOpenXRHandPoseComponent::GetLifetimeReplicatedProps(TArray< class FLifetimeProperty > & OutLifetimeProps) const
@@ -34,8 +39,22 @@ void UOpenXRHandPoseComponent::GetLifetimeReplicatedProps(TArray< class FLifetim
 	DOREPLIFETIME_CONDITION(UOpenXRHandPoseComponent, RightHandRep, COND_SkipOwner);
 }
 
-void UOpenXRHandPoseComponent::Server_SendSkeletalTransforms_Implementation(const FBPXRSkeletalRepContainer& SkeletalInfo)
+void UOpenXRHandPoseComponent::Server_SendSkeletalTransforms_Implementation(const FBPXRSkeletalRepContainer& SkeletalInfoIn)
 {
+	FBPXRSkeletalRepContainer SkeletalInfo = SkeletalInfoIn;
+
+	if (SkeletalInfo.bUseDeltaEncoding)
+	{
+		FBPXRSkeletalRepDeltaState& DeltaState = SkeletalInfo.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left ? LeftHandDeltaState : RightHandDeltaState;
+
+		// Missed the keyframe this is against, wait for the next one
+		if (!SkeletalInfo.ResolveDelta(DeltaState))
+			return;
+
+		// Property replication can skip values so simulated proxies always get full frames
+		SkeletalInfo.MarkAsKeyframe();
+	}
+
 	for (int i = 0; i < HandSkeletalActions.Num(); i++)
 	{
 		if (HandSkeletalActions[i].TargetHand == SkeletalInfo.TargetHand)
@@ -185,6 +204,13 @@ void UOpenXRHandPoseComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 						{
 							FBPXRSkeletalRepContainer ContainerSend;
 							ContainerSend.CopyForReplication(actionInfo);
+
+							if (bUseDeltaSkeletalReplication && ContainerSend.bHasValidData())
+							{
+								FBPXRSkeletalRepDeltaState& DeltaState = actionInfo.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left ? LeftHandDeltaState : RightHandDeltaState;
+								ContainerSend.EncodeDelta(DeltaState, SkeletalDeltaAngleThreshold, SkeletalDeltaPositionThreshold, SkeletalDeltaKeyframeInterval);
+							}
+
 							Server_SendSkeletalTransforms(ContainerSend);
 						}
 					}
@@ -192,10 +218,13 @@ void UOpenXRHandPoseComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 					{
 						if (actionInfo.bHasValidData)
 						{
-							if (actionInfo.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left)
-								LeftHandRep.CopyForReplication(actionInfo);
-							else
-								RightHandRep.CopyForReplication(actionInfo);
+							FBPXRSkeletalRepContainer& HandRep = actionInfo.TargetHand == EVRSkeletalHandIndex::EActionHandIndex_Left ? LeftHandRep : RightHandRep;
+							HandRep.CopyForReplication(actionInfo);
+
+							if (bUseDeltaSkeletalReplication && HandRep.bHasValidData())
+							{
+								HandRep.MarkAsKeyframe();
+							}
 						}
 					}
 				}
@@ -730,6 +759,172 @@ void FBPXRSkeletalRepContainer::CopyReplicatedTo(const FBPXRSkeletalRepContainer
 	Other.bHasValidData = true;
 }
 
+void FBPXRSkeletalRepContainer::EncodeDelta(FBPXRSkeletalRepDeltaState& State, float AngleThresholdDegrees, float PositionThreshold, int32 KeyframeInterval)
+{
+	const int32 NumBones = SkeletalTransforms.Num();
+
+	bool bSendKeyframe = !State.bHasKeyframe ||
+		State.SendsSinceKeyframe >= FMath::Max(KeyframeInterval, 1) ||
+		State.KeyframeTransforms.Num() != NumBones ||
+		State.bKeyframeAllowsDeforming != bAllowDeformingMesh ||
+		State.bKeyframeUsesRepSavings != bEnableUE4HandRepSavings;
+
+	uint32 NewMask = 0;
+	int32 NumChanged = 0;
+
+	if (!bSendKeyframe)
+	{
+		const float AngleThreshold = FMath::DegreesToRadians(AngleThresholdDegrees);
+		const float PositionThresholdSq = FMath::Square(PositionThreshold);
+
+		for (int32 i = 0; i < NumBones; i++)
+		{
+			const FTransform& Current = SkeletalTransforms[i];
+			const FTransform& Keyframe = State.KeyframeTransforms[i];
+
+			bool bChanged = Current.GetRotation().AngularDistance(Keyframe.GetRotation()) > AngleThreshold;
+
+			if (!bChanged && bAllowDeformingMesh)
+			{
+				bChanged = FVector::DistSquared(Current.GetLocation(), Keyframe.GetLocation()) > PositionThresholdSq;
+			}
+
+			if (bChanged)
+			{
+				NewMask |= (1u << i);
+				NumChanged++;
+			}
+		}
+
+		// Past around half of the bones the mask costs more than it saves, refresh the keyframe instead
+		bSendKeyframe = NumChanged > (NumBones / 2);
+	}
+
+	bUseDeltaEncoding = true;
+
+	if (bSendKeyframe)
+	{
+		MarkAsKeyframe();
+		KeyframeID = ++State.KeyframeID;
+
+		State.KeyframeTransforms = SkeletalTransforms;
+		State.SendsSinceKeyframe = 0;
+		State.bHasKeyframe = true;
+		State.bKeyframeAllowsDeforming = bAllowDeformingMesh;
+		State.bKeyframeUsesRepSavings = bEnableUE4HandRepSavings;
+	}
+	else
+	{
+		bIsKeyframe = false;
+		KeyframeID = State.KeyframeID;
+		ChangedBoneMask = NewMask;
+		State.SendsSinceKeyframe++;
+	}
+}
+
+bool FBPXRSkeletalRepContainer::ResolveDelta(FBPXRSkeletalRepDeltaState& State)
+{
+	if (!bUseDeltaEncoding)
+		return true;
+
+	if (bIsKeyframe)
+	{
+		// Unreliable sends drop out of order packets, so any keyframe that arrives is the newest one
+		State.KeyframeTransforms = SkeletalTransforms;
+		State.KeyframeID = KeyframeID;
+		State.bHasKeyframe = true;
+		State.bKeyframeAllowsDeforming = bAllowDeformingMesh;
+		State.bKeyframeUsesRepSavings = bEnableUE4HandRepSavings;
+		return true;
+	}
+
+	if (!State.bHasKeyframe ||
+		State.KeyframeID != KeyframeID ||
+		State.KeyframeTransforms.Num() != SkeletalTransforms.Num() ||
+		State.bKeyframeAllowsDeforming != bAllowDeformingMesh ||
+		State.bKeyframeUsesRepSavings != bEnableUE4HandRepSavings)
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < SkeletalTransforms.Num(); i++)
+	{
+		if (!(ChangedBoneMask & (1u << i)))
+		{
+			SkeletalTransforms[i] = State.KeyframeTransforms[i];
+		}
+	}
+
+	MarkAsKeyframe();
+	KeyframeID = State.KeyframeID;
+	return true;
+}
+
+void FBPXRSkeletalRepContainer::MarkAsKeyframe()
+{
+	bUseDeltaEncoding = true;
+	bIsKeyframe = true;
+	ChangedBoneMask = SkeletalTransforms.Num() >= 32 ? MAX_uint32 : ((1u << SkeletalTransforms.Num()) - 1);
+}
+
+// Smallest three quaternion packing, 2 bits for the dropped component and 10 bits for each of the other three
+static const float SkeletalQuatComponentRange = 0.70710678f;
+
+static uint32 PackSkeletalQuat(FQuat Quat)
+{
+	Quat.Normalize();
+
+	float Components[4] = { (float)Quat.X, (float)Quat.Y, (float)Quat.Z, (float)Quat.W };
+
+	uint32 LargestIndex = 0;
+	for (uint32 i = 1; i < 4; i++)
+	{
+		if (FMath::Abs(Components[i]) > FMath::Abs(Components[LargestIndex]))
+			LargestIndex = i;
+	}
+
+	// q and -q are the same rotation, flip so the dropped component is positive
+	const float Sign = Components[LargestIndex] < 0.0f ? -1.0f : 1.0f;
+
+	uint32 Packed = LargestIndex;
+	uint32 Shift = 2;
+	for (uint32 i = 0; i < 4; i++)
+	{
+		if (i == LargestIndex)
+			continue;
+
+		const float Normalized = (FMath::Clamp(Components[i] * Sign, -SkeletalQuatComponentRange, SkeletalQuatComponentRange) + SkeletalQuatComponentRange) / (2.0f * SkeletalQuatComponentRange);
+		Packed |= ((uint32)FMath::RoundToInt(Normalized * 1023.0f) & 0x3FF) << Shift;
+		Shift += 10;
+	}
+
+	return Packed;
+}
+
+static FQuat UnpackSkeletalQuat(uint32 Packed)
+{
+	const uint32 LargestIndex = Packed & 0x3;
+
+	float Components[4];
+	float SumSquares = 0.0f;
+	uint32 Shift = 2;
+	for (uint32 i = 0; i < 4; i++)
+	{
+		if (i == LargestIndex)
+			continue;
+
+		Components[i] = (((Packed >> Shift) & 0x3FF) / 1023.0f) * (2.0f * SkeletalQuatComponentRange) - SkeletalQuatComponentRange;
+		SumSquares += FMath::Square(Components[i]);
+		Shift += 10;
+	}
+
+	Components[LargestIndex] = FMath::Sqrt(FMath::Max(0.0f, 1.0f - SumSquares));
+
+	FQuat Quat(Components[0], Components[1], Components[2], Components[3]);
+	Quat.Normalize();
+	return Quat;
+}
+
 bool FBPXRSkeletalRepContainer::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
 	bOutSuccess = true;
@@ -743,6 +938,67 @@ bool FBPXRSkeletalRepContainer::NetSerialize(FArchive& Ar, class UPackageMap* Ma
 
 	//Ar << TransformCount;
 
+	Ar.SerializeBits(&bUseDeltaEncoding, 1);
+
+	if (bUseDeltaEncoding)
+	{
+		Ar << KeyframeID;
+		Ar.SerializeBits(&bIsKeyframe, 1);
+
+		if (Ar.IsLoading())
+		{
+			SkeletalTransforms.Reset(TransformCount);
+			ChangedBoneMask = 0;
+		}
+
+		if (bIsKeyframe)
+		{
+			ChangedBoneMask = TransformCount >= 32 ? MAX_uint32 : ((1u << TransformCount) - 1);
+		}
+		else
+		{
+			Ar.SerializeBits(&ChangedBoneMask, TransformCount);
+		}
+
+		FVector DeltaPosition = FVector::ZeroVector;
+		uint32 PackedRot = 0;
+
+		for (int i = 0; i < TransformCount; i++)
+		{
+			if (!(ChangedBoneMask & (1u << i)))
+			{
+				// Filled in from the keyframe by ResolveDelta
+				if (Ar.IsLoading())
+					SkeletalTransforms.Add(FTransform::Identity);
+
+				continue;
+			}
+
+			if (Ar.IsSaving())
+			{
+				if (bAllowDeformingMesh)
+					DeltaPosition = SkeletalTransforms[i].GetLocation();
+
+				PackedRot = PackSkeletalQuat(SkeletalTransforms[i].GetRotation());
+			}
+
+			if (bAllowDeformingMesh)
+				bOutSuccess &= SerializePackedVector<10, 11>(DeltaPosition, Ar);
+
+			Ar.SerializeBits(&PackedRot, 32);
+
+			if (Ar.IsLoading())
+			{
+				if (bAllowDeformingMesh)
+					SkeletalTransforms.Add(FTransform(UnpackSkeletalQuat(PackedRot), DeltaPosition));
+				else
+					SkeletalTransforms.Add(FTransform(UnpackSkeletalQuat(PackedRot)));
+			}
+		}
+
+		return bOutSuccess;
+	}
+
 	if (Ar.IsLoading())
 	{
 		SkeletalTransforms.Reset(TransformCount);
@@ -14,6 +14,32 @@
 
 #include "OpenXRHandPoseComponent.generated.h"
 
+// Keyframe that delta encoded skeletal containers are relative to, one per hand on both the sender and the receiver
+struct OPENXREXPANSIONPLUGIN_API FBPXRSkeletalRepDeltaState
+{
+	TArray<FTransform> KeyframeTransforms;
+	uint8 KeyframeID;
+	int32 SendsSinceKeyframe;
+	bool bHasKeyframe;
+	bool bKeyframeAllowsDeforming;
+	bool bKeyframeUsesRepSavings;
+
+	FBPXRSkeletalRepDeltaState()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		KeyframeTransforms.Reset();
+		KeyframeID = 0;
+		SendsSinceKeyframe = 0;
+		bHasKeyframe = false;
+		bKeyframeAllowsDeforming = false;
+		bKeyframeUsesRepSavings = false;
+	}
+};
+
 USTRUCT(BlueprintType, Category = "VRExpansionFunctions|OpenXR|HandSkeleton")
 struct OPENXREXPANSIONPLUGIN_API FBPXRSkeletalRepContainer
 {
@@ -37,6 +63,21 @@ public:
 	UPROPERTY(Transient, NotReplicated)
 		uint8 BoneCount;
 
+	// If true then bones are sent with smallest three quaternions, either as a keyframe or
+	// as only the bones that changed past the threshold since the keyframe with KeyframeID
+	UPROPERTY(Transient, NotReplicated)
+		bool bUseDeltaEncoding;
+
+	UPROPERTY(Transient, NotReplicated)
+		bool bIsKeyframe;
+
+	UPROPERTY(Transient, NotReplicated)
+		uint8 KeyframeID;
+
+	// Bit per replicated bone, set if it is sent in this delta
+	UPROPERTY(Transient, NotReplicated)
+		uint32 ChangedBoneMask;
+
 
 	FBPXRSkeletalRepContainer()
 	{
@@ -44,6 +85,10 @@ public:
 		bAllowDeformingMesh = false;
 		bEnableUE4HandRepSavings = false;
 		BoneCount = 0;
+		bUseDeltaEncoding = false;
+		bIsKeyframe = false;
+		KeyframeID = 0;
+		ChangedBoneMask = 0;
 	}
 
 	bool bHasValidData()
@@ -54,6 +99,16 @@ public:
 	void CopyForReplication(FBPOpenXRActionSkeletalData& Other);
 	static void CopyReplicatedTo(const FBPXRSkeletalRepContainer& Container, FBPOpenXRActionSkeletalData& Other);
 
+	// Sender side, turns freshly copied transforms into a keyframe or a delta against the senders last keyframe
+	void EncodeDelta(FBPXRSkeletalRepDeltaState& State, float AngleThresholdDegrees, float PositionThreshold, int32 KeyframeInterval);
+
+	// Receiver side, fills in the bones that weren't sent from the keyframe
+	// Returns false if we don't have the keyframe that this delta is against and it should be thrown out
+	bool ResolveDelta(FBPXRSkeletalRepDeltaState& State);
+
+	// Sends every bone in the delta format without referencing a previous keyframe
+	void MarkAsKeyframe();
+
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
 };
 
@@ -257,9 +312,16 @@ public:
 	FTransformLerpManager LeftHandRepManager;
 	FTransformLerpManager RightHandRepManager;
 
+	// Keyframes for delta encoding, sending side on the owner and receiving side everywhere else
+	FBPXRSkeletalRepDeltaState LeftHandDeltaState;
+	FBPXRSkeletalRepDeltaState RightHandDeltaState;
+
 	UFUNCTION()
 	virtual void OnRep_SkeletalTransformLeft()
 	{
+		if (!LeftHandRep.ResolveDelta(LeftHandDeltaState))
+			return;
+
 		for (int i = 0; i < HandSkeletalActions.Num(); i++)
 		{
 			if (HandSkeletalActions[i].TargetHand == LeftHandRep.TargetHand)
@@ -284,6 +346,9 @@ public:
 	UFUNCTION()
 	virtual void OnRep_SkeletalTransformRight()
 	{
+		if (!RightHandRep.ResolveDelta(RightHandDeltaState))
+			return;
+
 		for (int i = 0; i < HandSkeletalActions.Num(); i++)
 		{
 			if (HandSkeletalActions[i].TargetHand == RightHandRep.TargetHand)
@@ -323,6 +388,23 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SkeletalData)
 		float ReplicationRateForSkeletalAnimations;
 
+	// If true then the owner sends keyframes and per bone deltas to the server instead of every bone on every update
+	// Lossy, bones moving less than the thresholds hold their last value until the next keyframe
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkeletalData|Delta")
+		bool bUseDeltaSkeletalReplication;
+
+	// Number of sends between full keyframes, a lost keyframe can't be recovered from until the next one
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkeletalData|Delta", meta = (editcondition = "bUseDeltaSkeletalReplication", ClampMin = "1", UIMin = "1"))
+		int32 SkeletalDeltaKeyframeInterval;
+
+	// Bones that have rotated less than this many degrees from the keyframe are not sent
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkeletalData|Delta", meta = (editcondition = "bUseDeltaSkeletalReplication", ClampMin = "0.0", UIMin = "0.0"))
+		float SkeletalDeltaAngleThreshold;
+
+	// When deforming the mesh, bones that have moved less than this many units from the keyframe are not sent
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SkeletalData|Delta", meta = (editcondition = "bUseDeltaSkeletalReplication", ClampMin = "0.0", UIMin = "0.0"))
+		float SkeletalDeltaPositionThreshold;
+
 	// Used in Tick() to accumulate before sending updates, didn't want to use a timer in this case, also used for remotes to lerp position
 	float SkeletalNetUpdateCount;
 	// Used in Tick() to accumulate before sending updates, didn't want to use a timer in this case, also used for remotes to lerp position
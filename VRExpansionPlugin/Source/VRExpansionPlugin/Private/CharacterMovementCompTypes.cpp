@@ -13,7 +13,189 @@
 #include "VRBaseCharacter.h"
 #include "VRRootComponent.h"
 #include "VRPlayerController.h"
-	
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Math/RandomStream.h"
+#include "UObject/CoreNet.h"
+
+namespace CharacterMovementCompTypesCVars
+{
+	static int32 CompactVRMoveRep = 1;
+	FAutoConsoleVariableRef CVarCompactVRMoveRep(
+		TEXT("vre.CompactVRMoveRep"),
+		CompactVRMoveRep,
+		TEXT("When on, the VR capsule location of moves is delta encoded against the last acked move and the capsule half height is sent separately from LFDiff.\n")
+		TEXT("Only the sending side reads this, each move carries a bit for which format it was written in.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+
+	static float MaxRoomscaleCombineDelta = 10.0f;
+	FAutoConsoleVariableRef CVarMaxRoomscaleCombineDelta(
+		TEXT("vre.MaxRoomscaleCombineDelta"),
+		MaxRoomscaleCombineDelta,
+		TEXT("Moves without input acceleration can combine regardless of the direction of their roomscale movement while the combined movement is under this length.\n")
+		TEXT("0: Disable"),
+		ECVF_Default);
+}
+
+// Matches the precision of FVector_NetQuantize100 so that both sides agree on delta bases
+static FORCEINLINE FVector QuantizeVRCapsuleLocation(const FVector& Location)
+{
+	return FVector(
+		FMath::RoundToDouble(Location.X * 100.0) / 100.0,
+		FMath::RoundToDouble(Location.Y * 100.0) / 100.0,
+		FMath::RoundToDouble(Location.Z * 100.0) / 100.0
+	);
+}
+
+static FORCEINLINE float QuantizeVRCapsuleHalfHeight(float HalfHeight)
+{
+	return FMath::RoundToFloat(HalfHeight * 100.f) / 100.f;
+}
+
+// Zig zag encoded so that small values of either sign pack into a single byte
+static void SerializeQuantizedAxis(FArchive& Ar, FVector::FReal& Value, double Scale)
+{
+	const int32 Quantized = Ar.IsSaving() ? (int32)FMath::RoundToDouble(Value * Scale) : 0;
+	uint32 ZigZag = ((uint32)Quantized << 1) ^ (uint32)(Quantized >> 31);
+	Ar.SerializeIntPacked(ZigZag);
+
+	if (Ar.IsLoading())
+	{
+		Value = (FVector::FReal)((int32)(ZigZag >> 1) ^ -(int32)(ZigZag & 1)) / Scale;
+	}
+}
+
+FVRMoveDeltaBase::FVRMoveDeltaBase(float InTimeStamp, const FVector& InCapsuleLocation, float InCapsuleHalfHeight) :
+	TimeStamp(InTimeStamp),
+	VRCapsuleLocation(QuantizeVRCapsuleLocation(InCapsuleLocation)),
+	CapsuleHalfHeight(QuantizeVRCapsuleHalfHeight(InCapsuleHalfHeight))
+{
+}
+
+void FVRMoveDeltaHistory::Add(const FVRMoveDeltaBase& Entry)
+{
+	// Old moves are re-sent until acked, only keep the first copy
+	for (const FVRMoveDeltaBase& Existing : Entries)
+	{
+		if (Existing.TimeStamp == Entry.TimeStamp)
+		{
+			return;
+		}
+	}
+
+	if (Entries.Num() < MaxEntries)
+	{
+		Entries.Add(Entry);
+		NextEntry = Entries.Num() % MaxEntries;
+	}
+	else
+	{
+		Entries[NextEntry] = Entry;
+		NextEntry = (NextEntry + 1) % MaxEntries;
+	}
+}
+
+const FVRMoveDeltaBase* FVRMoveDeltaHistory::Find(float BaseTimeStamp) const
+{
+	const FVRMoveDeltaBase* Closest = nullptr;
+	float ClosestDelta = 0.001f;
+
+	for (const FVRMoveDeltaBase& Entry : Entries)
+	{
+		const float Delta = FMath::Abs(Entry.TimeStamp - BaseTimeStamp);
+		if (Delta <= ClosestDelta)
+		{
+			Closest = &Entry;
+			ClosestDelta = Delta;
+		}
+	}
+
+	return Closest;
+}
+
+void FVRMoveDeltaHistory::Reset()
+{
+	Entries.Reset();
+	NextEntry = 0;
+	MovesSinceKeyframe = KeyframeInterval;
+}
+
+bool FVRFloorCache::Find(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, float SweepRadius, float CapsuleHalfHeight, float Tolerance, uint64 MaxAgeFrames, FFindFloorResult& OutFloorResult) const
+{
+	for (const FEntry& Entry : Entries)
+	{
+		if (!Entry.bValid || (GFrameCounter - Entry.FrameStored) > MaxAgeFrames)
+			continue;
+
+		if (!FMath::IsNearlyEqual(Entry.LineDistance, LineDistance) || !FMath::IsNearlyEqual(Entry.SweepDistance, SweepDistance) ||
+			!FMath::IsNearlyEqual(Entry.SweepRadius, SweepRadius) || !FMath::IsNearlyEqual(Entry.CapsuleHalfHeight, CapsuleHalfHeight))
+			continue;
+
+		const FVector Offset = CapsuleLocation - Entry.CapsuleLocation;
+		if (Offset.SizeSquared2D() > FMath::Square(Tolerance) || FMath::Abs(Offset.Z) > Tolerance)
+			continue;
+
+		// The floor has to be in the same place, a moving base or a destroyed floor always re-sweeps
+		const UPrimitiveComponent* FloorComponent = Entry.FloorComponent.Get();
+		if (!IsValid(FloorComponent) || !FloorComponent->GetComponentTransform().Equals(Entry.FloorTransform, UE_KINDA_SMALL_NUMBER))
+			continue;
+
+		FFindFloorResult FloorResult = Entry.FloorResult;
+		FloorResult.FloorDist += Offset.Z;
+		if (FloorResult.bLineTrace)
+		{
+			FloorResult.LineDist += Offset.Z;
+		}
+
+		// Moved out of the range the stored result was valid for
+		if (FloorResult.FloorDist > SweepDistance || (FloorResult.bLineTrace && FloorResult.LineDist > LineDistance))
+			continue;
+
+		FloorResult.HitResult.TraceStart += Offset;
+		FloorResult.HitResult.TraceEnd += Offset;
+		FloorResult.HitResult.Location += FVector(Offset.X, Offset.Y, 0.0f);
+
+		OutFloorResult = FloorResult;
+		return true;
+	}
+
+	return false;
+}
+
+void FVRFloorCache::Add(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, float SweepRadius, float CapsuleHalfHeight, const FFindFloorResult& FloorResult)
+{
+	// Bones of a skeletal floor can move without the component moving
+	UPrimitiveComponent* FloorComponent = FloorResult.HitResult.GetComponent();
+	if (!FloorResult.IsWalkableFloor() || !IsValid(FloorComponent) || FloorComponent->IsSimulatingPhysics() || FloorResult.HitResult.BoneName != NAME_None)
+		return;
+
+	FEntry& Entry = Entries[NextEntry];
+	NextEntry = (NextEntry + 1) % MaxEntries;
+
+	Entry.FloorResult = FloorResult;
+	Entry.CapsuleLocation = CapsuleLocation;
+	Entry.LineDistance = LineDistance;
+	Entry.SweepDistance = SweepDistance;
+	Entry.SweepRadius = SweepRadius;
+	Entry.CapsuleHalfHeight = CapsuleHalfHeight;
+	Entry.FloorComponent = FloorComponent;
+	Entry.FloorTransform = FloorComponent->GetComponentTransform();
+	Entry.FrameStored = GFrameCounter;
+	Entry.bValid = true;
+}
+
+void FVRFloorCache::Invalidate()
+{
+	for (FEntry& Entry : Entries)
+	{
+		Entry.bValid = false;
+		Entry.FloorComponent.Reset();
+	}
+
+	NextEntry = 0;
+}
+
 FSavedMove_VRBaseCharacter::FSavedMove_VRBaseCharacter() : FSavedMove_Character()
 {
 	VRCapsuleLocation = FVector::ZeroVector;
@@ -65,7 +247,12 @@ bool FSavedMove_VRBaseCharacter::CanCombineWith(const FSavedMovePtr& NewMove, AC
 	if (!FMath::IsNearlyEqual(LFDiff.Z, nMove->LFDiff.Z))
 		return false;
 
-	if (!FVector2D(LFDiff.X, LFDiff.Y).IsZero() && !FVector2D(nMove->LFDiff.X, nMove->LFDiff.Y).IsZero() && !FVector::Coincident(LFDiff.GetSafeNormal2D(), nMove->LFDiff.GetSafeNormal2D(), AccelDotThresholdCombine))
+	// Roomscale only moves sum their LFDiff exactly in CombineWith, so the direction of the relative movement doesn't need to match
+	// as long as the combined movement stays small enough to be swept in one step
+	const bool bRoomscaleOnlyMoves = Acceleration.IsZero() && nMove->Acceleration.IsZero() &&
+		FVector2D(LFDiff.X + nMove->LFDiff.X, LFDiff.Y + nMove->LFDiff.Y).SizeSquared() <= FMath::Square(CharacterMovementCompTypesCVars::MaxRoomscaleCombineDelta);
+
+	if (!bRoomscaleOnlyMoves && !FVector2D(LFDiff.X, LFDiff.Y).IsZero() && !FVector2D(nMove->LFDiff.X, nMove->LFDiff.Y).IsZero() && !FVector::Coincident(LFDiff.GetSafeNormal2D(), nMove->LFDiff.GetSafeNormal2D(), AccelDotThresholdCombine))
 		return false;
 
 	return FSavedMove_Character::CanCombineWith(NewMove, Character, MaxDelta);
@@ -395,7 +582,6 @@ bool FVRCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& Charact
 
 	SerializeOptionalValue<uint8>(bIsSaving, Ar, CompressedMoveFlags, 0);
 	SerializeOptionalValue<uint8>(bIsSaving, Ar, MovementMode, MOVE_Walking);
-	VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
 	Ar << VRCapsuleRotation;
 
 	// Location is only used for error checking, so only save for the final move.
@@ -424,30 +610,197 @@ bool FVRCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& Charact
 	// Rep out our custom move settings
 	ConditionalMoveReps.NetSerialize(Ar, PackageMap, bLocalSuccess);
 
-	//VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
-	if (AVRBaseCharacter* VRChar = Cast<AVRBaseCharacter>(CharacterOwner))
+	// Non retained roomscale sends LFDiff at a higher precision as it is rounded to that in the root component
+	const AVRBaseCharacter* VRChar = Cast<AVRBaseCharacter>(CharacterOwner);
+	const bool bRoomscalePrecision = !VRChar || VRChar->bRetainRoomscale;
+
+	UVRBaseCharacterMovementComponent* BaseMovement = Cast<UVRBaseCharacterMovementComponent>(&CharacterMovement);
+
+	// Written into the move so that the reader never depends on its own cvar state
+	bool bCompact = bIsSaving ? CharacterMovementCompTypesCVars::CompactVRMoveRep > 0 : false;
+	Ar.SerializeBits(&bCompact, 1);
+
+	// The client deltas against the last move that the server acked, the server already has that moves values in its history
+	FVRMoveDeltaBase AckedBase;
+	const FVRMoveDeltaBase* DeltaBase = nullptr;
+	if (bCompact && bIsSaving && CharacterMovement.HasPredictionData_Client())
+	{
+		FNetworkPredictionData_Client_Character* ClientData = CharacterMovement.GetPredictionData_Client_Character();
+		if (ClientData && ClientData->LastAckedMove.IsValid())
+		{
+			const FSavedMove_VRBaseCharacter* AckedMove = (const FSavedMove_VRBaseCharacter*)ClientData->LastAckedMove.Get();
+			AckedBase = FVRMoveDeltaBase(AckedMove->TimeStamp, AckedMove->VRCapsuleLocation, AckedMove->LFDiff.Z);
+			DeltaBase = &AckedBase;
+		}
+	}
+
+	SerializeVRCapsuleValues(Ar, PackageMap, bCompact, bRoomscalePrecision, DeltaBase, BaseMovement ? &BaseMovement->MoveDeltaHistory : nullptr);
+
+	return !Ar.IsError();
+}
+
+bool FVRCharacterNetworkMoveData::SerializeVRCapsuleValues(FArchive& Ar, UPackageMap* PackageMap, bool bCompact, bool bRetainRoomscale, const FVRMoveDeltaBase* DeltaBase, FVRMoveDeltaHistory* DeltaHistory)
+{
+	bool bLocalSuccess = true;
+	const bool bIsSaving = Ar.IsSaving();
+
+	if (!bCompact)
 	{
-		if (!VRChar->bRetainRoomscale)
+		VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
+
+		if (bRetainRoomscale)
+		{
+			SerializePackedVector<100, 30>(LFDiff, Ar);
+		}
+		else
 		{
 			SerializePackedVector<10000, 32>(LFDiff, Ar);
 		}
+
+		// Keep the history going so that a switch to the compact format can delta against these moves
+		if (DeltaHistory)
+		{
+			if (bIsSaving)
+			{
+				DeltaHistory->MovesSinceKeyframe = 0;
+			}
+			else
+			{
+				DeltaHistory->Add(FVRMoveDeltaBase(TimeStamp, VRCapsuleLocation, LFDiff.Z));
+			}
+		}
+
+		return bLocalSuccess;
+	}
+
+	// Only delta against a recent base, and periodically send the full location
+	bool bDeltaCapsule = false;
+	FVector CapsuleDelta = FVector::ZeroVector;
+	if (bIsSaving && DeltaHistory)
+	{
+		bDeltaCapsule = DeltaBase && DeltaHistory->MovesSinceKeyframe < FVRMoveDeltaHistory::KeyframeInterval &&
+			TimeStamp > DeltaBase->TimeStamp && (TimeStamp - DeltaBase->TimeStamp) <= FVRMoveDeltaHistory::MaxBaseAge;
+
+		if (bDeltaCapsule)
+		{
+			// Don't let the packed vector clamp a large move (teleports), send the full location instead
+			CapsuleDelta = QuantizeVRCapsuleLocation(VRCapsuleLocation) - DeltaBase->VRCapsuleLocation;
+			bDeltaCapsule = CapsuleDelta.GetAbsMax() <= FVRMoveDeltaHistory::MaxCapsuleDelta;
+		}
+
+		DeltaHistory->MovesSinceKeyframe = bDeltaCapsule ? DeltaHistory->MovesSinceKeyframe + 1 : 0;
+	}
+
+	Ar.SerializeBits(&bDeltaCapsule, 1);
+
+	const FVRMoveDeltaBase* LoadedBase = nullptr;
+	if (bDeltaCapsule)
+	{
+		// The base is referenced by its age in milliseconds, moves are never that close together
+		uint32 BaseAgeMs = bIsSaving ? (uint32)FMath::RoundToInt((TimeStamp - DeltaBase->TimeStamp) * 1000.f) : 0;
+		Ar.SerializeIntPacked(BaseAgeMs);
+
+		if (!SerializePackedVector<100, 24>(CapsuleDelta, Ar))
+		{
+			// Range is checked before saving, so this is a corrupt or clamped delta and the location can't be trusted
+			UE_LOG(LogVRBaseCharacterMovement, Verbose, TEXT("Packed capsule delta for move %f failed to serialize"), TimeStamp);
+			Ar.SetError();
+			bLocalSuccess = false;
+		}
+
+		if (!bIsSaving && bLocalSuccess)
+		{
+			LoadedBase = DeltaHistory ? DeltaHistory->Find(TimeStamp - (BaseAgeMs / 1000.f)) : nullptr;
+
+			if (LoadedBase)
+			{
+				VRCapsuleLocation = QuantizeVRCapsuleLocation(LoadedBase->VRCapsuleLocation + CapsuleDelta);
+			}
+			else
+			{
+				// Guessing a base would simulate the move from the wrong location, drop it and let the client resend or keyframe
+				UE_LOG(LogVRBaseCharacterMovement, Verbose, TEXT("Missing delta base for move %f with base age %ums, rejecting move"), TimeStamp, BaseAgeMs);
+				Ar.SetError();
+				bLocalSuccess = false;
+			}
+		}
+	}
+	else
+	{
+		VRCapsuleLocation.NetSerialize(Ar, PackageMap, bLocalSuccess);
+	}
+
+	// LFDiff.Z is the capsule half height, it rarely changes and was forcing the packed vector up to its bit count
+	float HalfHeight = bIsSaving ? LFDiff.Z : 0.0f;
+	bool bHasHalfHeight = HalfHeight > 0.0f;
+	Ar.SerializeBits(&bHasHalfHeight, 1);
+
+	if (bHasHalfHeight)
+	{
+		bool bSameHalfHeight = bIsSaving && bDeltaCapsule && QuantizeVRCapsuleHalfHeight(HalfHeight) == DeltaBase->CapsuleHalfHeight;
+		if (bDeltaCapsule)
+		{
+			Ar.SerializeBits(&bSameHalfHeight, 1);
+		}
+
+		if (bSameHalfHeight)
+		{
+			HalfHeight = bIsSaving ? HalfHeight : (LoadedBase ? LoadedBase->CapsuleHalfHeight : 0.0f);
+		}
 		else
 		{
-			SerializePackedVector<100, 30>(LFDiff, Ar);
+			uint32 QuantizedHalfHeight = bIsSaving ? (uint32)FMath::RoundToInt(HalfHeight * 100.f) : 0;
+			Ar.SerializeIntPacked(QuantizedHalfHeight);
+			HalfHeight = QuantizedHalfHeight / 100.f;
 		}
 	}
 	else
 	{
-		SerializePackedVector<100, 30>(LFDiff, Ar);
+		HalfHeight = 0.0f;
 	}
 
-	//LFDiff.NetSerialize(Ar, PackageMap, bLocalSuccess);
-	//Ar << VRCapsuleRotation;
+	bool bHasLFDiff = bIsSaving ? (LFDiff.X != 0.0f || LFDiff.Y != 0.0f) : false;
+	Ar.SerializeBits(&bHasLFDiff, 1);
 
-	return !Ar.IsError();
+	if (bHasLFDiff)
+	{
+		const double LFDiffScale = bRetainRoomscale ? 100.0 : 10000.0;
+		SerializeQuantizedAxis(Ar, LFDiff.X, LFDiffScale);
+		SerializeQuantizedAxis(Ar, LFDiff.Y, LFDiffScale);
+	}
+	else if (!bIsSaving)
+	{
+		LFDiff.X = 0.0f;
+		LFDiff.Y = 0.0f;
+	}
+
+	if (!bIsSaving)
+	{
+		LFDiff.Z = HalfHeight;
+
+		if (DeltaHistory && bLocalSuccess)
+		{
+			DeltaHistory->Add(FVRMoveDeltaBase(TimeStamp, VRCapsuleLocation, HalfHeight));
+		}
+	}
+
+	return bLocalSuccess;
 }
 
 
+void FVRCharacterNetworkMoveDataContainer::CopyMoveData(const FCharacterNetworkMoveDataContainer& Other)
+{
+	bIsDualHybridRootMotionMove = Other.bIsDualHybridRootMotionMove;
+	bHasPendingMove = Other.bHasPendingMove;
+	bHasOldMove = Other.bHasOldMove;
+	bDisableCombinedScopedMove = Other.bDisableCombinedScopedMove;
+
+	// Only our own container type is ever batched
+	*(FVRCharacterNetworkMoveData*)NewMoveData = *(const FVRCharacterNetworkMoveData*)Other.GetNewMoveData();
+	*(FVRCharacterNetworkMoveData*)PendingMoveData = *(const FVRCharacterNetworkMoveData*)Other.GetPendingMoveData();
+	*(FVRCharacterNetworkMoveData*)OldMoveData = *(const FVRCharacterNetworkMoveData*)Other.GetOldMoveData();
+}
+
 void FVRCharacterMoveResponseDataContainer::ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement, const FClientAdjustment& PendingAdjustment)
 {
 	FCharacterMoveResponseDataContainer::ServerFillResponseData(CharacterMovement, PendingAdjustment);
@@ -479,4 +832,131 @@ FScopedMeshBoneUpdateOverrideVR::~FScopedMeshBoneUpdateOverrideVR()
 		// Restore bone update flag.
 		MeshRef->KinematicBonesUpdateType = SavedUpdateSetting;
 	}
-}
\ No newline at end of file
+}
+
+namespace CharacterMovementCompTypesCVars
+{
+	// Replays an HMD trace through the move capsule value serialization and compares the full and compact formats.
+	// Acks are simulated by treating every move older than the ack latency as acked.
+	static void RunMoveBandwidthBenchmark(const TArray<FString>& Args)
+	{
+		const FString TracePath = Args.Num() > 0 ? Args[0] : FString();
+		const float AckLatency = (Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 0.0f) : 100.0f) / 1000.f;
+		const float FrameRate = Args.Num() > 2 ? FMath::Max(FCString::Atof(*Args[2]), 1.0f) : 90.0f;
+		const bool bRetainRoomscale = Args.Num() > 3 ? FCString::Atoi(*Args[3]) != 0 : true;
+		const float HalfHeight = 88.0f;
+
+		// XYZ is the HMD location relative to the tracking origin, W is the time
+		TArray<FVector4> Trace;
+		if (!TracePath.IsEmpty() && TracePath != TEXT("none"))
+		{
+			TArray<FString> Lines;
+			if (!FFileHelper::LoadFileToStringArray(Lines, *TracePath))
+			{
+				UE_LOG(LogVRBaseCharacterMovement, Warning, TEXT("Move bandwidth benchmark: failed to load trace %s"), *TracePath);
+				return;
+			}
+
+			// Lines are "Time,X,Y,Z", anything else (headers) is skipped
+			for (const FString& Line : Lines)
+			{
+				TArray<FString> Values;
+				if (Line.ParseIntoArray(Values, TEXT(",")) >= 4 && Values[0].TrimStartAndEnd().IsNumeric())
+				{
+					Trace.Add(FVector4(FCString::Atof(*Values[1]), FCString::Atof(*Values[2]), FCString::Atof(*Values[3]), FCString::Atof(*Values[0])));
+				}
+			}
+		}
+		else
+		{
+			// Slow walk around the play space with some head sway on top
+			FRandomStream Stream(1337);
+			FVector Sway = FVector::ZeroVector;
+			const int32 NumSamples = FMath::CeilToInt(30.0f * FrameRate);
+			for (int32 i = 0; i < NumSamples; ++i)
+			{
+				const float Time = i / FrameRate;
+				Sway = (Sway * 0.95f) + (Stream.GetUnitVector() * 0.05f);
+				const FVector Walk(FMath::Cos(Time * 0.3f) * 100.0f, FMath::Sin(Time * 0.3f) * 100.0f, 165.0f + FMath::Sin(Time * 4.0f) * 1.5f);
+				Trace.Add(FVector4(Walk + Sway, Time));
+			}
+		}
+
+		if (Trace.Num() < 2)
+		{
+			UE_LOG(LogVRBaseCharacterMovement, Warning, TEXT("Move bandwidth benchmark: trace needs at least two samples"));
+			return;
+		}
+
+		FVRMoveDeltaHistory ClientHistory;
+		FVRMoveDeltaHistory ServerHistory;
+		FVRCharacterNetworkMoveData ClientMove;
+		FVRCharacterNetworkMoveData ServerMove;
+		TArray<FVector> SentLocations;
+		SentLocations.Reserve(Trace.Num());
+
+		const double LFDiffScale = bRetainRoomscale ? 100.0 : 10000.0;
+		int64 FullBits = 0;
+		int64 CompactBits = 0;
+		int32 NumKeyframes = 0;
+		int32 NumRejected = 0;
+		double MaxLocationError = 0.0;
+		double MaxLFDiffError = 0.0;
+		int32 AckedIndex = INDEX_NONE;
+
+		for (int32 i = 1; i < Trace.Num(); ++i)
+		{
+			const float TimeStamp = Trace[i].W;
+			const FVector Diff = FVector(Trace[i]) - FVector(Trace[i - 1]);
+
+			while (AckedIndex + 1 < i - 1 && Trace[AckedIndex + 2].W <= TimeStamp - AckLatency)
+			{
+				++AckedIndex;
+			}
+
+			ClientMove.TimeStamp = TimeStamp;
+			ClientMove.VRCapsuleLocation = bRetainRoomscale ? QuantizeVRCapsuleLocation(FVector(Trace[i])) : FVector(Trace[i]);
+			ClientMove.LFDiff = FVector(FMath::RoundToDouble(Diff.X * LFDiffScale) / LFDiffScale, FMath::RoundToDouble(Diff.Y * LFDiffScale) / LFDiffScale, HalfHeight);
+			SentLocations.Add(ClientMove.VRCapsuleLocation);
+
+			FNetBitWriter FullWriter(256);
+			ClientMove.SerializeVRCapsuleValues(FullWriter, nullptr, false, bRetainRoomscale, nullptr, nullptr);
+			FullBits += FullWriter.GetNumBits();
+
+			// SentLocations is offset by one as the trace replay starts at the second sample
+			FVRMoveDeltaBase AckedBase;
+			if (AckedIndex != INDEX_NONE)
+			{
+				AckedBase = FVRMoveDeltaBase(Trace[AckedIndex + 1].W, SentLocations[AckedIndex], HalfHeight);
+			}
+
+			FNetBitWriter CompactWriter(256);
+			ClientMove.SerializeVRCapsuleValues(CompactWriter, nullptr, true, bRetainRoomscale, AckedIndex != INDEX_NONE ? &AckedBase : nullptr, &ClientHistory);
+			CompactBits += CompactWriter.GetNumBits();
+			NumKeyframes += ClientHistory.MovesSinceKeyframe == 0 ? 1 : 0;
+
+			// Read it back the way that the server would
+			FNetBitReader Reader(nullptr, CompactWriter.GetData(), CompactWriter.GetNumBits());
+			ServerMove.TimeStamp = TimeStamp;
+			if (!ServerMove.SerializeVRCapsuleValues(Reader, nullptr, true, bRetainRoomscale, nullptr, &ServerHistory))
+			{
+				++NumRejected;
+				continue;
+			}
+
+			MaxLocationError = FMath::Max(MaxLocationError, FVector::Dist(ServerMove.VRCapsuleLocation, ClientMove.VRCapsuleLocation));
+			MaxLFDiffError = FMath::Max(MaxLFDiffError, FVector::Dist(ServerMove.LFDiff, ClientMove.LFDiff));
+		}
+
+		const int32 NumMoves = Trace.Num() - 1;
+		UE_LOG(LogVRBaseCharacterMovement, Log, TEXT("Move bandwidth benchmark: %i moves, ack latency %.0f ms, retained roomscale %i"), NumMoves, AckLatency * 1000.f, bRetainRoomscale ? 1 : 0);
+		UE_LOG(LogVRBaseCharacterMovement, Log, TEXT("  Full:    %.1f bits per move"), (double)FullBits / NumMoves);
+		UE_LOG(LogVRBaseCharacterMovement, Log, TEXT("  Compact: %.1f bits per move, %i full location sends, %i rejected, max location error %f, max LFDiff error %f"), (double)CompactBits / NumMoves, NumKeyframes, NumRejected, MaxLocationError, MaxLFDiffError);
+	}
+
+	static FAutoConsoleCommand CmdBenchmarkMoveBandwidth(
+		TEXT("vre.BenchmarkMoveBandwidth"),
+		TEXT("Replays an HMD trace through the VR move capsule value serialization and logs the bits per move of the full and compact formats.\n")
+		TEXT("Args: [TraceFile=none (synthetic), lines of Time,X,Y,Z] [AckLatencyMs=100] [FrameRate=90, synthetic only] [RetainRoomscale=1]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunMoveBandwidthBenchmark));
+}
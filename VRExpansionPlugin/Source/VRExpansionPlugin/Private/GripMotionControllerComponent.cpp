@@ -53,6 +53,7 @@
 #include "Chaos/PhysicsObjectInterface.h"
 
 #include "Misc/CollisionIgnoreSubsystem.h"
+#include "Misc/VRTrackingSmoothingSubsystem.h"
 
 #include "Features/IModularFeatures.h"
 
@@ -60,6 +61,9 @@ DEFINE_LOG_CATEGORY(LogVRMotionController);
 //For UE4 Profiler ~ Stat
 DECLARE_CYCLE_STAT(TEXT("TickGrip ~ TickingGrip"), STAT_TickGrip, STATGROUP_TickGrip);
 DECLARE_CYCLE_STAT(TEXT("GetGripWorldTransform ~ GettingTransform"), STAT_GetGripTransform, STATGROUP_TickGrip);
+DECLARE_CYCLE_STAT(TEXT("Resolve Grip Dispatch ~ Cached"), STAT_ResolveGripDispatchCached, STATGROUP_GripDispatch);
+DECLARE_CYCLE_STAT(TEXT("Resolve Grip Dispatch ~ Uncached"), STAT_ResolveGripDispatchUncached, STATGROUP_GripDispatch);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Grip Dispatch Cache Rebuilds"), STAT_GripDispatchCacheRebuilds, STATGROUP_GripDispatch);
 
 // MAGIC NUMBERS
 // Constraint multipliers for angular, to avoid having to have two sets of stiffness/damping variables
@@ -136,6 +140,14 @@ namespace GripMotionControllerCvars
 		TEXT("When on, will draw debug speheres for physics grips COM.\n")
 		TEXT("0: Disable, 1: Enable"),
 		ECVF_Default);
+
+	static int32 UseCachedGripDispatch = 1;
+	FAutoConsoleVariableRef CVarUseCachedGripDispatch(
+		TEXT("vr.UseCachedGripDispatch"),
+		UseCachedGripDispatch,
+		TEXT("When on, grips will use their cached interface and grip script resolution during the tick instead of querying it every frame.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
 }
 
   //=============================================================================
@@ -190,6 +202,12 @@ UGripMotionControllerComponent::UGripMotionControllerComponent(const FObjectInit
 	EuroSmoothingParams.MinCutoff = 0.1f;
 	EuroSmoothingParams.DeltaCutoff = 10.f;
 	EuroSmoothingParams.CutoffSlope = 10.f;
+	bRegisteredForBankedSmoothing = false;
+	PrePolledTrackingFrame = 0;
+	PrePolledPosition = FVector::ZeroVector;
+	PrePolledOrientation = FRotator::ZeroRotator;
+	bPrePolledTrackedState = false;
+	PrePolledLastTrackingStatus = ETrackingStatus::NotTracked;
 
 	bIsPostTeleport = false;
 
@@ -435,6 +453,16 @@ void UGripMotionControllerComponent::EndPlay(const EEndPlayReason::Type EndPlayR
 	// Cancel end physics tick
 	RegisterEndPhysicsTick(false);
 
+	if (bRegisteredForBankedSmoothing)
+	{
+		if (UVRTrackingSmoothingSubsystem* SmoothingSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UVRTrackingSmoothingSubsystem>() : nullptr)
+		{
+			SmoothingSubsystem->UnregisterController(this);
+		}
+
+		bRegisteredForBankedSmoothing = false;
+	}
+
 	if (NewControllerProfileEvent_Handle.IsValid())
 	{
 		UVRGlobalSettings* VRSettings = GetMutableDefault<UVRGlobalSettings>();
@@ -2703,6 +2731,74 @@ void UGripMotionControllerComponent::DropAndSocket_Implementation(const FBPActor
 }
 
 
+void UGripMotionControllerComponent::BuildGripDispatchCache(FBPActorGripInformation& Grip, UPrimitiveComponent* root, AActor* actor)
+{
+	INC_DWORD_STAT(STAT_GripDispatchCacheRebuilds);
+
+	FBPGripDispatchCache& Cache = Grip.DispatchCache;
+	Cache.Reset();
+
+	if (!root || !actor)
+		return;
+
+	Cache.CachedRoot = root;
+	Cache.CachedActor = actor;
+
+	// Matches the tick logic, actor grip interface is checked after component
+	if (root->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+	{
+		Cache.bRootHasInterface = true;
+	}
+	else if (actor->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+	{
+		Cache.bActorHasInterface = true;
+	}
+
+	if (Cache.bRootHasInterface || Cache.bActorHasInterface)
+	{
+		TArray<UVRGripScriptBase*> GripScripts;
+		IVRGripInterface::Execute_GetGripScripts(Cache.bRootHasInterface ? (UObject*)root : (UObject*)actor, GripScripts);
+
+		for (UVRGripScriptBase* Script : GripScripts)
+		{
+			if (Script)
+			{
+				Cache.GripScripts.Add(Script);
+
+				if (Script->GetWorldTransformOverrideType() != EGSTransformOverrideType::None)
+				{
+					Cache.bHasWorldTransformScript = true;
+				}
+			}
+		}
+	}
+
+	Cache.bIsValid = true;
+}
+
+void UGripMotionControllerComponent::RefreshGripDispatchCache(UObject* GrippedObjectToRefresh)
+{
+	if (!GrippedObjectToRefresh)
+		return;
+
+	// Invalidating them here, the tick will rebuild them on next use
+	for (FBPActorGripInformation& Grip : GrippedObjects)
+	{
+		if (Grip.GrippedObject == GrippedObjectToRefresh)
+		{
+			Grip.DispatchCache.Reset();
+		}
+	}
+
+	for (FBPActorGripInformation& Grip : LocallyGrippedObjects)
+	{
+		if (Grip.GrippedObject == GrippedObjectToRefresh)
+		{
+			Grip.DispatchCache.Reset();
+		}
+	}
+}
+
 // No longer an RPC, now is called from RepNotify so that joining clients also correctly set up grips
 bool UGripMotionControllerComponent::NotifyGrip(FBPActorGripInformation &NewGrip, bool bIsReInit)
 {
@@ -2952,6 +3048,9 @@ bool UGripMotionControllerComponent::NotifyGrip(FBPActorGripInformation &NewGrip
 	}break;
 	}
 
+	// Resolve the interface and script dispatch now so that the tick doesn't have to
+	BuildGripDispatchCache(NewGrip, root, pActor);
+
 	switch (NewGrip.GripMovementReplicationSetting)
 	{
 	case EGripMovementReplicationSettings::ForceClientSideMovement:
@@ -4558,7 +4657,19 @@ void UGripMotionControllerComponent::OnRep_ReplicatedControllerTransform()
 		ApplyTrackingParameters(ReplicatedControllerTransform.Position, true, false);
 	}
 
-	if (bSmoothReplicatedMotion)
+	if (bSmoothReplicatedMotion && SnapshotInterpolation.bUseSnapshotInterpolation)
+	{
+		if (!bReppedOnce || (SnapshotBuffer.Snapshots.Num() > 0 && FVector::DistSquared(SnapshotBuffer.Snapshots.Last().Position, ReplicatedControllerTransform.Position) >= FMath::Square(NetworkNoSmoothUpdateDistance)))
+		{
+			SnapshotBuffer.Reset();
+			SetRelativeLocationAndRotation(ReplicatedControllerTransform.Position, ReplicatedControllerTransform.Rotation);
+			bReppedOnce = true;
+		}
+
+		SnapshotBuffer.AddSnapshot(ReplicatedControllerTransform.Position, ReplicatedControllerTransform.Rotation, GetWorld()->GetRealTimeSeconds(), 1.0f / FMath::Max(ControllerNetUpdateRate, 1.0f), SnapshotInterpolation);
+		bLerpingPosition = true;
+	}
+	else if (bSmoothReplicatedMotion)
 	{
 		if (bReppedOnce)
 		{
@@ -4596,6 +4707,55 @@ void UGripMotionControllerComponent::OnRep_ReplicatedControllerTransform()
 		SetRelativeLocationAndRotation(ReplicatedControllerTransform.Position, ReplicatedControllerTransform.Rotation);
 }
 
+void UGripMotionControllerComponent::UpdateBankedSmoothingRegistration()
+{
+	const bool bWantsBankedSmoothing = bSmoothHandTracking && bSmoothWithEuroLowPassFunction && UVRTrackingSmoothingSubsystem::IsBankingTrackingSmoothing();
+	if (bWantsBankedSmoothing == bRegisteredForBankedSmoothing)
+		return;
+
+	if (UVRTrackingSmoothingSubsystem* SmoothingSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UVRTrackingSmoothingSubsystem>() : nullptr)
+	{
+		if (bWantsBankedSmoothing)
+		{
+			SmoothingSubsystem->RegisterController(this);
+		}
+		else
+		{
+			SmoothingSubsystem->UnregisterController(this);
+		}
+
+		bRegisteredForBankedSmoothing = bWantsBankedSmoothing;
+	}
+}
+
+void UGripMotionControllerComponent::PrePollTrackingForSmoothing()
+{
+	// Same conditions that UpdateTracking smooths under, anything else polls during its own tick as normal
+	if (!bHasAuthority || bUseWithoutTracking || !bSmoothHandTracking || !bSmoothWithEuroLowPassFunction || !EuroSmoothingParams.IsBoundToBank() || !IsActive() || !IsComponentTickEnabled())
+		return;
+
+	if (bOffsetByControllerProfile && !NewControllerProfileEvent_Handle.IsValid())
+	{
+		GetCurrentProfileTransform(true);
+	}
+
+	FVector Position = GetRelativeLocation();
+	FRotator Orientation = GetRelativeRotation();
+
+	float WorldToMeters = GetWorld() ? GetWorld()->GetWorldSettings()->WorldToMeters : 100.0f;
+	PrePolledLastTrackingStatus = CurrentTrackingStatus;
+	bPrePolledTrackedState = GripPollControllerState(Position, Orientation, WorldToMeters);
+	PrePolledPosition = Position;
+	PrePolledOrientation = Orientation;
+	PrePolledTrackingFrame = GFrameCounter;
+
+	// Untracked controllers keep their filter history untouched, same as when filtering in UpdateTracking
+	if (bPrePolledTrackedState && (bIgnoreTrackingStatus || CurrentTrackingStatus != ETrackingStatus::NotTracked))
+	{
+		EuroSmoothingParams.SetBankInput(FTransform(Orientation, Position, this->GetRelativeScale3D()));
+	}
+}
+
 void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 {
 	// Server/remote clients don't set the controller position in VR
@@ -4617,9 +4777,25 @@ void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 				GripViewExtension = FSceneViewExtensions::NewExtension<FGripViewExtension>(this);
 			}
 			
-			float WorldToMeters = GetWorld() ? GetWorld()->GetWorldSettings()->WorldToMeters : 100.0f;
+			UpdateBankedSmoothingRegistration();
+
 			ETrackingStatus LastTrackingStatus = CurrentTrackingStatus;
-			const bool bNewTrackedState = GripPollControllerState(Position, Orientation, WorldToMeters);
+			bool bNewTrackedState = false;
+
+			// The smoothing pass already polled us this frame
+			const bool bUsePrePolledTracking = PrePolledTrackingFrame == GFrameCounter;
+			if (bUsePrePolledTracking)
+			{
+				Position = PrePolledPosition;
+				Orientation = PrePolledOrientation;
+				LastTrackingStatus = PrePolledLastTrackingStatus;
+				bNewTrackedState = bPrePolledTrackedState;
+			}
+			else
+			{
+				float WorldToMeters = GetWorld() ? GetWorld()->GetWorldSettings()->WorldToMeters : 100.0f;
+				bNewTrackedState = GripPollControllerState(Position, Orientation, WorldToMeters);
+			}
 
 			// Pull a reference to the private display component if it should exist
 			if (bDisplayDeviceModel && !IsValid(DisplayComponentReference.Get()))
@@ -4662,7 +4838,15 @@ void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 					
 					if (bSmoothWithEuroLowPassFunction)
 					{
-						SetRelativeTransform(EuroSmoothingParams.RunFilterSmoothing(CalcedTransform, DeltaTime));
+						if (bUsePrePolledTracking)
+						{
+							// Filtered along with every other controller in the smoothing pass
+							SetRelativeTransform(EuroSmoothingParams.GetBankOutput());
+						}
+						else
+						{
+							SetRelativeTransform(EuroSmoothingParams.RunFilterSmoothing(CalcedTransform, DeltaTime));
+						}
 					}
 					else
 					{
@@ -4712,8 +4896,15 @@ void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 			FVector RelLoc = GetRelativeLocation();
 			FRotator RelRot = GetRelativeRotation();
 
+			AVRBaseCharacter* OwningChar = Cast<AVRBaseCharacter>(GetOwner());
+			if (OwningChar != nullptr && OwningChar->IsBundlingPoseFor(this))
+			{
+				// The character samples this on its own rate and sends it in its pose packet
+				ReplicatedControllerTransform.Position = RelLoc;
+				ReplicatedControllerTransform.Rotation = RelRot;
+			}
 			// Don't rep if no changes
-			if (!RelLoc.Equals(ReplicatedControllerTransform.Position) || !RelRot.Equals(ReplicatedControllerTransform.Rotation))
+			else if (!RelLoc.Equals(ReplicatedControllerTransform.Position) || !RelRot.Equals(ReplicatedControllerTransform.Rotation))
 			{
 				ControllerNetUpdateCount += DeltaTime;
 				if (ControllerNetUpdateCount >= (1.0f / ControllerNetUpdateRate))
@@ -4729,7 +4920,6 @@ void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 					// Perf difference.
 					if (!IsServer()/* && !IsTornOff()*/)
 					{
-						AVRBaseCharacter* OwningChar = Cast<AVRBaseCharacter>(GetOwner());
 						if (OverrideSendTransform != nullptr && OwningChar != nullptr)
 						{
 							(OwningChar->* (OverrideSendTransform))(ReplicatedControllerTransform);
@@ -4763,6 +4953,18 @@ void UGripMotionControllerComponent::UpdateTracking(float DeltaTime)
 
 void UGripMotionControllerComponent::RunNetworkedSmoothing(float DeltaTime)
 {
+	if (bSmoothReplicatedMotion && SnapshotInterpolation.bUseSnapshotInterpolation)
+	{
+		FVector SampledPosition;
+		FRotator SampledRotation;
+		if (SnapshotBuffer.Sample(GetWorld()->GetRealTimeSeconds(), SnapshotInterpolation, SampledPosition, SampledRotation))
+		{
+			SetRelativeLocationAndRotation(SampledPosition, SampledRotation);
+		}
+
+		return;
+	}
+
 	if (bLerpingPosition)
 	{
 		if (!bUseExponentialSmoothing)
@@ -5064,15 +5266,49 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 				// Check if either implements the interface
 				bool bRootHasInterface = false;
 				bool bActorHasInterface = false;
-				
-				if (root->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+				bool bHasWorldTransformScript = true;
+				TArray<UVRGripScriptBase*> UncachedGripScripts;
+				TArray<UVRGripScriptBase*>* GripScriptsPtr = &UncachedGripScripts;
+
+				if (GripMotionControllerCvars::UseCachedGripDispatch > 0)
 				{
-					bRootHasInterface = true;
+					SCOPE_CYCLE_COUNTER(STAT_ResolveGripDispatchCached);
+
+					if (!Grip->DispatchCache.IsValidFor(root, actor))
+					{
+						BuildGripDispatchCache(*Grip, root, actor);
+					}
+
+					bRootHasInterface = Grip->DispatchCache.bRootHasInterface;
+					bActorHasInterface = Grip->DispatchCache.bActorHasInterface;
+					bHasWorldTransformScript = Grip->DispatchCache.bHasWorldTransformScript;
+					GripScriptsPtr = &ToRawPtrTArrayUnsafe(Grip->DispatchCache.GripScripts);
 				}
-				else if (actor->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+				else
 				{
-					// Actor grip interface is checked after component
-					bActorHasInterface = true;
+					SCOPE_CYCLE_COUNTER(STAT_ResolveGripDispatchUncached);
+
+					if (root->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+					{
+						bRootHasInterface = true;
+					}
+					else if (actor->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+					{
+						// Actor grip interface is checked after component
+						bActorHasInterface = true;
+					}
+
+					if (Grip->GripCollisionType != EGripCollisionType::CustomGrip)
+					{
+						if (bRootHasInterface)
+						{
+							IVRGripInterface::Execute_GetGripScripts(root, UncachedGripScripts);
+						}
+						else if (bActorHasInterface)
+						{
+							IVRGripInterface::Execute_GetGripScripts(actor, UncachedGripScripts);
+						}
+					}
 				}
 
 				if (Grip->GripCollisionType == EGripCollisionType::CustomGrip)
@@ -5088,22 +5324,14 @@ void UGripMotionControllerComponent::HandleGripArray(TArray<FBPActorGripInformat
 
 				bool bRescalePhysicsGrips = false;
 				
-				TArray<UVRGripScriptBase*> GripScripts;
-
-				if (bRootHasInterface)
-				{
-					IVRGripInterface::Execute_GetGripScripts(root, GripScripts);
-				}
-				else if (bActorHasInterface)
-				{
-					IVRGripInterface::Execute_GetGripScripts(actor, GripScripts);
-				}
-
+				TArray<UVRGripScriptBase*>& GripScripts = *GripScriptsPtr;
+				TArray<UVRGripScriptBase*> NoTransformScripts;
 
 				bool bForceADrop = false;
 
 				// Get the world transform for this grip after handling secondary grips and interaction differences
-				bool bHasValidWorldTransform = GetGripWorldTransform(GripScripts, DeltaTime, WorldTransform, ParentTransform, *Grip, actor, root, bRootHasInterface, bActorHasInterface, false, bForceADrop);
+				// If none of the scripts touch the world transform then we can skip iterating them
+				bool bHasValidWorldTransform = GetGripWorldTransform(bHasWorldTransformScript ? GripScripts : NoTransformScripts, DeltaTime, WorldTransform, ParentTransform, *Grip, actor, root, bRootHasInterface, bActorHasInterface, false, bForceADrop);
 
 				// If a script or behavior is telling us to skip this and continue on (IE: it dropped the grip)
 				if (bForceADrop)
@@ -7897,6 +8125,7 @@ void UGripMotionControllerComponent::GetControllerDeviceID(FXRDeviceId & DeviceI
 FExpandedLateUpdateManager::FExpandedLateUpdateManager()
 	: LateUpdateGameWriteIndex(0)
 	, LateUpdateRenderReadIndex(0)
+	, GatherCount(0)
 {
 }
 
@@ -7910,6 +8139,8 @@ void FExpandedLateUpdateManager::Setup(const FTransform& ParentToWorld, UGripMot
 
 	UpdateStates[LateUpdateGameWriteIndex].Primitives.Reset();
 	UpdateStates[LateUpdateGameWriteIndex].ParentToWorld = ParentToWorld;
+	GatheredSceneInfos.Reset();
+	++GatherCount;
 
 	//Add additional late updates registered to this controller that aren't children and aren't gripped
 	//This array is editable in blueprint and can be used for things like arms or the like.
@@ -7925,6 +8156,15 @@ void FExpandedLateUpdateManager::Setup(const FTransform& ParentToWorld, UGripMot
 	GatherLateUpdatePrimitives(Component);
 	//GatherLateUpdatePrimitives(Component);
 
+	// Forget the hierarchies of anything that was dropped or removed
+	for (auto It = CachedHierarchies.CreateIterator(); It; ++It)
+	{
+		if (It.Value().LastUsedGather != GatherCount)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
 	UpdateStates[LateUpdateGameWriteIndex].bSkip = bSkipLateUpdate;
 	++UpdateStates[LateUpdateGameWriteIndex].TrackingNumber;
 
@@ -7954,61 +8194,38 @@ void FExpandedLateUpdateManager::Apply_RenderThread(FSceneInterface* Scene, cons
 	const FTransform NewCameraTransform = NewRelativeTransform * UpdateStates[LateUpdateRenderReadIndex].ParentToWorld;
 	const FMatrix LateUpdateTransform = (OldCameraTransform.Inverse() * NewCameraTransform).ToMatrixWithScale();
 
-	bool bIndicesHaveChanged = false;
-
-	/*
-	// Under HMD late-latching senario, Apply_RenderThread will be called twice in same frame under PreRenderViewFamily_RenderThread and 
-	// LateLatchingViewFamily_RenderThread. We don't want to apply PrimitivePair.Value = -1 directly on UpdateStates[LateUpdateRenderReadIndex].Primitives
-	// because the modification will affect second Apply_RenderThread's logic under LateLatchingViewFamily_RenderThread.
-	// Since the list is very small(only affect stuff attaching to the controller),  we just make a local copy PrimitivesLocal.
-	TMap<FPrimitiveSceneInfo*, int32> PrimitivesLocal = UpdateStates[LateUpdateRenderReadIndex].Primitives;
-	for (auto& PrimitivePair : PrimitivesLocal)*/
-	for (auto& PrimitivePair : UpdateStates[LateUpdateRenderReadIndex].Primitives)
+	for (FLateUpdatePrimitive& Primitive : UpdateStates[LateUpdateRenderReadIndex].Primitives)
 	{
-		if (PrimitivePair.Value == -1)
+		if (Primitive.Index == -1)
 			continue;
 
-		FPrimitiveSceneInfo* RetrievedSceneInfo = Scene->GetPrimitiveSceneInfo(PrimitivePair.Value);
-		FPrimitiveSceneInfo* CachedSceneInfo = PrimitivePair.Key;
+		FPrimitiveSceneInfo* RetrievedSceneInfo = Scene->GetPrimitiveSceneInfo(Primitive.Index);
 
 		// If the retrieved scene info is different than our cached scene info then the scene has changed in the meantime
-		// and we need to search through the entire scene to make sure it still exists.
-		if (CachedSceneInfo != RetrievedSceneInfo)
+		// Re-resolve only this primitive through its persistent index instead of searching the entire scene
+		// The cached pointer is only compared against, never dereferenced, until the scene confirms it still exists
+		if (RetrievedSceneInfo != Primitive.SceneInfo)
 		{
-			bIndicesHaveChanged = true;
-			break; // No need to continue here, as we are going to brute force the scene primitives below anyway.
+			RetrievedSceneInfo = Primitive.PersistentIndex != INDEX_NONE ? Scene->GetPrimitiveSceneInfo(FPersistentPrimitiveIndex{ Primitive.PersistentIndex }) : nullptr;
+
+			if (RetrievedSceneInfo != Primitive.SceneInfo)
+			{
+				// Removed from the scene, next frames gather will pick up its replacement
+				Primitive.Index = -1;
+				continue;
+			}
 		}
-		else if (CachedSceneInfo->Proxy)
+
+		if (RetrievedSceneInfo->Proxy)
 		{
-			CachedSceneInfo->Proxy->ApplyLateUpdateTransform(LateUpdateTransform);
-			PrimitivePair.Value = -1; // Set the cached index to -1 to indicate that this primitive was already processed
+			RetrievedSceneInfo->Proxy->ApplyLateUpdateTransform(LateUpdateTransform);
+			Primitive.Index = -1; // Set the cached index to -1 to indicate that this primitive was already processed
 			/*if (FrameNumber >= 0)
 			{
 				CachedSceneInfo->Proxy->SetPatchingFrameNumber(FrameNumber);
 			}*/
 		}
 	}
-
-	// Indices have changed, so we need to scan the entire scene for primitives that might still exist
-	if (bIndicesHaveChanged)
-	{
-		int32 Index = 0;
-		FPrimitiveSceneInfo* RetrievedSceneInfo = Scene->GetPrimitiveSceneInfo(Index++);
-		while (RetrievedSceneInfo)
-		{
-			/*int32* PrimitiveIndex = PrimitivesLocal.Find(RetrievedSceneInfo);
-			if (RetrievedSceneInfo->Proxy && PrimitiveIndex != nullptr && *PrimitiveIndex >= 0)*/
-			if (RetrievedSceneInfo->Proxy && UpdateStates[LateUpdateRenderReadIndex].Primitives.Contains(RetrievedSceneInfo) && UpdateStates[LateUpdateRenderReadIndex].Primitives[RetrievedSceneInfo] >= 0)
-			{
-				RetrievedSceneInfo->Proxy->ApplyLateUpdateTransform(LateUpdateTransform);
-				/*if (FrameNumber >= 0)
-				{
-					RetrievedSceneInfo->Proxy->SetPatchingFrameNumber(FrameNumber);
-				}*/
-			}
-			RetrievedSceneInfo = Scene->GetPrimitiveSceneInfo(Index++);
-		}
-	}
 }
 
 void FExpandedLateUpdateManager::CacheSceneInfo(USceneComponent* Component)
@@ -8021,30 +8238,89 @@ void FExpandedLateUpdateManager::CacheSceneInfo(USceneComponent* Component)
 		FPrimitiveSceneInfo* PrimitiveSceneInfo = PrimitiveComponent->SceneProxy->GetPrimitiveSceneInfo();
 		if (PrimitiveSceneInfo && PrimitiveSceneInfo->IsIndexValid())
 		{
-			UpdateStates[LateUpdateGameWriteIndex].Primitives.Emplace(PrimitiveSceneInfo, PrimitiveSceneInfo->GetIndex());
+			bool bAlreadyGathered = false;
+			GatheredSceneInfos.Add(PrimitiveSceneInfo, &bAlreadyGathered);
+
+			if (!bAlreadyGathered)
+			{
+				FLateUpdatePrimitive& NewPrimitive = UpdateStates[LateUpdateGameWriteIndex].Primitives.AddDefaulted_GetRef();
+				NewPrimitive.SceneInfo = PrimitiveSceneInfo;
+				NewPrimitive.Index = PrimitiveSceneInfo->GetIndex();
+				NewPrimitive.PersistentIndex = PrimitiveSceneInfo->GetPersistentIndex().Index;
+			}
 		}
 	}
 }
 
 void FExpandedLateUpdateManager::GatherLateUpdatePrimitives(USceneComponent* ParentComponent)
 {
-	CacheSceneInfo(ParentComponent);
-	TArray<USceneComponent*> DirectComponents;
+	FLateUpdateHierarchy& Hierarchy = CachedHierarchies.FindOrAdd(TObjectKey<USceneComponent>(ParentComponent));
+	Hierarchy.LastUsedGather = GatherCount;
+
+	// Only walk the attachment tree again if something was attached, detached, or destroyed under this root
+	if (!Hierarchy.IsValidFor(ParentComponent))
+	{
+		Hierarchy.Rebuild(ParentComponent);
+	}
 
 	// Std late updates
-	ParentComponent->GetChildrenComponents(true, DirectComponents);
-	for (USceneComponent* Component : DirectComponents)
+	for (const TWeakObjectPtr<USceneComponent>& Component : Hierarchy.Components)
+	{
+		if (USceneComponent* SceneComponent = Component.Get())
+		{
+			CacheSceneInfo(SceneComponent);
+		}
+	}
+}
+
+bool FExpandedLateUpdateManager::FLateUpdateHierarchy::IsValidFor(const USceneComponent* Root) const
+{
+	if (Components.Num() < 1 || Components[0].Get() != Root)
+		return false;
+
+	for (int32 i = 0; i < Components.Num(); i++)
 	{
-		if (Component != nullptr)
+		const USceneComponent* Component = Components[i].Get();
+		if (!Component || Component->GetAttachChildren().Num() != ChildCounts[i])
+			return false;
+
+		// Re-parented within the hierarchy
+		if (i > 0 && Component->GetAttachParent() != Components[ParentIndices[i]].Get())
+			return false;
+	}
+
+	return true;
+}
+
+void FExpandedLateUpdateManager::FLateUpdateHierarchy::Rebuild(USceneComponent* Root)
+{
+	Components.Reset();
+	ParentIndices.Reset();
+	ChildCounts.Reset();
+
+	Components.Add(Root);
+	ParentIndices.Add(INDEX_NONE);
+
+	// Breadth first walk, the arrays double as the queue
+	for (int32 i = 0; i < Components.Num(); i++)
+	{
+		const TArray<TObjectPtr<USceneComponent>>& AttachChildren = Components[i]->GetAttachChildren();
+		ChildCounts.Add(AttachChildren.Num());
+
+		for (USceneComponent* Child : AttachChildren)
 		{
-			CacheSceneInfo(Component);
+			if (Child != nullptr)
+			{
+				Components.Add(Child);
+				ParentIndices.Add(i);
+			}
 		}
 	}
 }
 
-void FExpandedLateUpdateManager::ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent * MotionControllerComponent, TArray<FBPActorGripInformation> & GripArray)
+void FExpandedLateUpdateManager::ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent * MotionControllerComponent, const TArray<FBPActorGripInformation> & GripArray)
 {
-	for (FBPActorGripInformation actor : GripArray)
+	for (const FBPActorGripInformation& actor : GripArray)
 	{
 		// Skip actors that are colliding if turning off late updates during collision.
 		// Also skip turning off late updates for SweepWithPhysics, as it should always be locked to the hand
@@ -8100,11 +8376,11 @@ void FExpandedLateUpdateManager::ProcessGripArrayLateUpdatePrimitives(UGripMotio
 		// Don't run late updates if we have a grip script that denies it
 		if (actor.GrippedObject->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
 		{
-			TArray<UVRGripScriptBase*> GripScripts;
-			if (IVRGripInterface::Execute_GetGripScripts(actor.GrippedObject, GripScripts))
+			GripScriptsScratch.Reset();
+			if (IVRGripInterface::Execute_GetGripScripts(actor.GrippedObject, GripScriptsScratch))
 			{
 				bool bContinueOn = false;
-				for (UVRGripScriptBase* Script : GripScripts)
+				for (UVRGripScriptBase* Script : GripScriptsScratch)
 				{
 					if (Script && Script->IsScriptActive() && Script->Wants_DenyLateUpdates())
 					{
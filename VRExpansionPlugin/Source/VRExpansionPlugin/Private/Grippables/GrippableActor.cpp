@@ -3,6 +3,8 @@
 #include "Grippables/GrippableActor.h"
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GrippableActor)
 
+#include "Misc/VRClientAuthThrowBatchSubsystem.h"
+#include "VRPlayerController.h"
 #include "TimerManager.h"
 #include "Net/UnrealNetwork.h"
 #include "PhysicsReplication.h"
@@ -444,9 +446,13 @@ bool AGrippableActor::AddToClientReplicationBucket()
 {
 	if (ShouldWeSkipAttachmentReplication(false))
 	{
-		// The subsystem automatically removes entries with the same function signature so its safe to just always add here
-		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->AddObjectToBucket(ClientAuthReplicationData.UpdateRate, this, FName(TEXT("PollReplicationEvent")));
+		// Bound natively to skip ProcessEvent, remove any previous entry since handles don't replace each other
+		UBucketUpdateSubsystem* BucketSubsystem = GetWorld()->GetSubsystem<UBucketUpdateSubsystem>();
+		BucketSubsystem->RemoveFromBucketByHandle(ClientAuthBucketHandle);
+		ClientAuthBucketHandle = BucketSubsystem->AddNativeObjectToBucket(ClientAuthReplicationData.UpdateRate, this, &AGrippableActor::PollReplicationEvent, GET_FUNCTION_NAME_CHECKED(AGrippableActor, PollReplicationEvent));
 		ClientAuthReplicationData.bIsCurrentlyClientAuth = true;
+		ClientAuthReplicationData.QuantizationProfile = IVRGripInterface::Execute_AdvancedGripSettings(this).MovementQuantizationProfile;
+		ClientAuthReplicationData.BatchingController = UVRClientAuthThrowBatchSubsystem::GetBatchingController(this);
 
 		if (UWorld * World = GetWorld())
 			ClientAuthReplicationData.TimeAtInitialThrow = World->GetTimeSeconds();
@@ -461,7 +467,7 @@ bool AGrippableActor::RemoveFromClientReplicationBucket()
 {
 	if (ClientAuthReplicationData.bIsCurrentlyClientAuth)
 	{
-		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->RemoveObjectFromBucketByFunctionName(this, FName(TEXT("PollReplicationEvent")));
+		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->RemoveFromBucketByHandle(ClientAuthBucketHandle);
 		CeaseReplicationBlocking();
 		return true;
 	}
@@ -558,9 +564,14 @@ bool AGrippableActor::PollReplicationEvent()
 				if (PrimComp->IsSimulatingPhysics() && ShouldWeSkipAttachmentReplication(false))
 				{
 					FRepMovementVR ClientAuthMovementRep;
+					ClientAuthMovementRep.SetQuantizationProfile(ClientAuthReplicationData.QuantizationProfile);
 					if (ClientAuthMovementRep.GatherActorsMovement(this))
 					{
-						Server_GetClientAuthReplication(ClientAuthMovementRep);
+						// Batched with the rest of the owning players thrown objects when enabled
+						if (!UVRClientAuthThrowBatchSubsystem::QueueClientAuthMovement(ClientAuthReplicationData.BatchingController.Get(), this, ClientAuthMovementRep))
+						{
+							Server_GetClientAuthReplication(ClientAuthMovementRep);
+						}
 
 						if (PrimComp->RigidBodyIsAwake())
 						{
@@ -618,6 +629,13 @@ bool AGrippableActor::PollReplicationEvent()
 		CeaseReplicationBlocking();
 	}
 
+	// A batched final movement would only go out after the end and re-add the target it removes, send it first like the unbatched path
+	FRepMovementVR QueuedMovementRep;
+	if (UVRClientAuthThrowBatchSubsystem::TakeQueuedClientAuthMovement(this, QueuedMovementRep))
+	{
+		Server_GetClientAuthReplication(QueuedMovementRep);
+	}
+
 	// Tell server to kill us
 	Server_EndClientAuthReplication();
 	return false; // Tell the bucket subsystem to remove us from consideration
@@ -15,6 +15,7 @@
 #include "Physics/Experimental/PhysScene_Chaos.h"
 //#include "Components/SkeletalMeshComponent.h"
 #include "Misc/ScopeRWLock.h"
+#include "UObject/CoreNet.h"
 
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
@@ -704,14 +705,12 @@ void FPhysicsReplicationVR::OnTick(float DeltaSeconds, TMap<TWeakObjectPtr<UPrim
 
 FRepMovementVR::FRepMovementVR() : FRepMovement()
 {
-	LocationQuantizationLevel = EVectorQuantization::RoundTwoDecimals;
-	VelocityQuantizationLevel = EVectorQuantization::RoundTwoDecimals;
-	RotationQuantizationLevel = ERotatorQuantization::ShortComponents;
+	SetQuantizationProfile(EVRMovementQuantizationProfile::VRQUANT_Default);
 }
 
 FRepMovementVR::FRepMovementVR(FRepMovement& other) : FRepMovement()
 {
-	FRepMovementVR();
+	SetQuantizationProfile(EVRMovementQuantizationProfile::VRQUANT_Default);
 
 	LinearVelocity = other.LinearVelocity;
 	AngularVelocity = other.AngularVelocity;
@@ -731,11 +730,91 @@ void FRepMovementVR::CopyTo(FRepMovement& other) const
 	other.bRepPhysics = bRepPhysics;
 }
 
+void FRepMovementVR::GetQuantizationSettings(EVRMovementQuantizationProfile Profile, EVectorQuantization& OutLocationLevel, ERotatorQuantization& OutRotationLevel, EVectorQuantization& OutVelocityLevel, float& OutMaxLinearVelocity, float& OutMaxAngularVelocity)
+{
+	switch (Profile)
+	{
+	case EVRMovementQuantizationProfile::VRQUANT_SmallProp:
+	{
+		OutLocationLevel = EVectorQuantization::RoundOneDecimal;
+		OutRotationLevel = ERotatorQuantization::ShortComponents;
+		OutVelocityLevel = EVectorQuantization::RoundOneDecimal;
+		OutMaxLinearVelocity = 4000.0f;
+		OutMaxAngularVelocity = 3600.0f;
+	}break;
+	case EVRMovementQuantizationProfile::VRQUANT_Coarse:
+	{
+		OutLocationLevel = EVectorQuantization::RoundWholeNumber;
+		OutRotationLevel = ERotatorQuantization::ByteComponents;
+		OutVelocityLevel = EVectorQuantization::RoundWholeNumber;
+		OutMaxLinearVelocity = 2000.0f;
+		OutMaxAngularVelocity = 1800.0f;
+	}break;
+	case EVRMovementQuantizationProfile::VRQUANT_Default:
+	default:
+	{
+		OutLocationLevel = EVectorQuantization::RoundTwoDecimals;
+		OutRotationLevel = ERotatorQuantization::ShortComponents;
+		OutVelocityLevel = EVectorQuantization::RoundTwoDecimals;
+		OutMaxLinearVelocity = 0.0f;
+		OutMaxAngularVelocity = 0.0f;
+	}break;
+	}
+}
+
+void FRepMovementVR::SetQuantizationProfile(EVRMovementQuantizationProfile NewProfile)
+{
+	QuantizationProfile = NewProfile < EVRMovementQuantizationProfile::VRQUANT_MAX ? NewProfile : EVRMovementQuantizationProfile::VRQUANT_Default;
+
+	float MaxLinearVelocity = 0.0f;
+	float MaxAngularVelocity = 0.0f;
+	GetQuantizationSettings(QuantizationProfile, LocationQuantizationLevel, RotationQuantizationLevel, VelocityQuantizationLevel, MaxLinearVelocity, MaxAngularVelocity);
+}
+
 bool FRepMovementVR::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 {
+	// Two bits is enough for the profiles, the receiver needs it to read the quantized values back
+	uint8 Profile = (uint8)QuantizationProfile;
+	Ar.SerializeBits(&Profile, 2);
+
+	if (Ar.IsLoading())
+	{
+		SetQuantizationProfile((EVRMovementQuantizationProfile)Profile);
+	}
+
 	return FRepMovement::NetSerialize(Ar, Map, bOutSuccess);
 }
 
+void FRepMovementVR::ClampVelocitiesToProfile()
+{
+	// Keep the velocities inside of the profiles range, this bounds the packed vector sizes
+	float MaxLinearVelocity = 0.0f;
+	float MaxAngularVelocity = 0.0f;
+	EVectorQuantization LocationLevel;
+	ERotatorQuantization RotationLevel;
+	EVectorQuantization VelocityLevel;
+	GetQuantizationSettings(QuantizationProfile, LocationLevel, RotationLevel, VelocityLevel, MaxLinearVelocity, MaxAngularVelocity);
+
+	if (MaxLinearVelocity > 0.0f)
+	{
+		LinearVelocity = LinearVelocity.GetClampedToMaxSize(MaxLinearVelocity);
+	}
+
+	if (MaxAngularVelocity > 0.0f)
+	{
+		AngularVelocity = AngularVelocity.GetClampedToMaxSize(MaxAngularVelocity);
+	}
+}
+
+int64 FRepMovementVR::GetSerializedBits() const
+{
+	FRepMovementVR MovementCopy = *this;
+	FNetBitWriter Writer(256);
+	bool bSuccess = true;
+	MovementCopy.NetSerialize(Writer, nullptr, bSuccess);
+	return Writer.GetNumBits();
+}
+
 bool FRepMovementVR::GatherActorsMovement(AActor* OwningActor)
 {
 	//if (/*bReplicateMovement || (RootComponent && RootComponent->GetAttachParent())*/)
@@ -771,6 +850,8 @@ bool FRepMovementVR::GatherActorsMovement(AActor* OwningActor)
 		}
 	}
 
+	ClampVelocitiesToProfile();
+
 	/*if (const UWorld* World = GetOwningWorld())
 	{
 		if (APlayerController* PlayerController = World->GetFirstPlayerController())
@@ -783,4 +864,85 @@ bool FRepMovementVR::GatherActorsMovement(AActor* OwningActor)
 	}*/
 
 	return true;
-}
\ No newline at end of file
+}
+namespace VRMovementQuantizationBenchmark
+{
+	static void RunMovementQuantizationBenchmark(const TArray<FString>& Args)
+	{
+		const float UpdateRate = Args.Num() > 0 ? FMath::Max(FCString::Atof(*Args[0]), 1.0f) : 30.0f;
+		const int32 NumSamples = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 1000;
+
+		// Synthetic thrown objects, hand sized props in a room sized play space tumbling at throw speeds
+		TArray<FRepMovementVR> Samples;
+		Samples.Reserve(NumSamples);
+		FRandomStream Stream(1337);
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			FRepMovementVR& Sample = Samples.AddDefaulted_GetRef();
+			Sample.Location = FVector(Stream.FRandRange(-1000.0f, 1000.0f), Stream.FRandRange(-1000.0f, 1000.0f), Stream.FRandRange(0.0f, 300.0f));
+			Sample.Rotation = FRotator(Stream.FRandRange(-90.0f, 90.0f), Stream.FRandRange(-180.0f, 180.0f), Stream.FRandRange(-180.0f, 180.0f));
+			Sample.LinearVelocity = Stream.GetUnitVector() * Stream.FRandRange(0.0f, 1500.0f);
+			Sample.AngularVelocity = Stream.GetUnitVector() * Stream.FRandRange(0.0f, 1440.0f);
+			Sample.bSimulatedPhysicSleep = false;
+			Sample.bRepPhysics = true;
+		}
+
+		UE_LOG(LogPhysics, Log, TEXT("Movement quantization benchmark: %d samples at %.1f updates per second per object"), NumSamples, UpdateRate);
+
+		for (uint8 ProfileIndex = 0; ProfileIndex < (uint8)EVRMovementQuantizationProfile::VRQUANT_MAX; ++ProfileIndex)
+		{
+			const EVRMovementQuantizationProfile Profile = (EVRMovementQuantizationProfile)ProfileIndex;
+
+			float MaxLinearVelocity = 0.0f;
+			float MaxAngularVelocity = 0.0f;
+			EVectorQuantization LocationLevel;
+			ERotatorQuantization RotationLevel;
+			EVectorQuantization VelocityLevel;
+			FRepMovementVR::GetQuantizationSettings(Profile, LocationLevel, RotationLevel, VelocityLevel, MaxLinearVelocity, MaxAngularVelocity);
+
+			int64 TotalBits = 0;
+			int64 MinBits = MAX_int64;
+			int64 MaxBits = 0;
+			double MaxLocationError = 0.0;
+			double MaxRotationError = 0.0;
+			double MaxVelocityError = 0.0;
+
+			for (const FRepMovementVR& Source : Samples)
+			{
+				FRepMovementVR Sent = Source;
+				Sent.SetQuantizationProfile(Profile);
+				Sent.ClampVelocitiesToProfile();
+
+				const int64 NumBits = Sent.GetSerializedBits();
+				TotalBits += NumBits;
+				MinBits = FMath::Min(MinBits, NumBits);
+				MaxBits = FMath::Max(MaxBits, NumBits);
+
+				// Round trip for the error
+				FNetBitWriter Writer(256);
+				bool bSuccess = true;
+				Sent.NetSerialize(Writer, nullptr, bSuccess);
+
+				FNetBitReader Reader(nullptr, Writer.GetData(), Writer.GetNumBits());
+				FRepMovementVR Received;
+				Received.NetSerialize(Reader, nullptr, bSuccess);
+
+				MaxLocationError = FMath::Max(MaxLocationError, FVector::Dist(Received.Location, Source.Location));
+				MaxRotationError = FMath::Max(MaxRotationError, FMath::RadiansToDegrees(Received.Rotation.Quaternion().AngularDistance(Source.Rotation.Quaternion())));
+				MaxVelocityError = FMath::Max(MaxVelocityError, FVector::Dist(Received.LinearVelocity, Sent.LinearVelocity));
+			}
+
+			const double AverageBits = (double)TotalBits / NumSamples;
+			UE_LOG(LogPhysics, Log, TEXT("  %s: %.1f bits per update (%lld - %lld), %.1f bytes/s per object, max error %.3f cm / %.3f deg / %.3f cm/s, velocity range %.0f cm/s %.0f deg/s"),
+				*StaticEnum<EVRMovementQuantizationProfile>()->GetNameStringByValue((int64)Profile),
+				AverageBits, MinBits, MaxBits, (AverageBits / 8.0) * UpdateRate,
+				MaxLocationError, MaxRotationError, MaxVelocityError, MaxLinearVelocity, MaxAngularVelocity);
+		}
+	}
+
+	static FAutoConsoleCommand CmdBenchmarkMovementQuantization(
+		TEXT("vre.BenchmarkMovementQuantization"),
+		TEXT("Serializes synthetic thrown object movement with each FRepMovementVR quantization profile and logs the bits per update, bytes per second per object and the round trip error.\n")
+		TEXT("Args: [UpdateRate=30] [NumSamples=1000]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunMovementQuantizationBenchmark));
+}
@@ -3,6 +3,8 @@
 #include "Grippables/GrippableSkeletalMeshActor.h"
 #include UE_INLINE_GENERATED_CPP_BY_NAME(GrippableSkeletalMeshActor)
 
+#include "Misc/VRClientAuthThrowBatchSubsystem.h"
+#include "VRPlayerController.h"
 #include "TimerManager.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
@@ -413,9 +415,13 @@ bool AGrippableSkeletalMeshActor::AddToClientReplicationBucket()
 {
 	if (ShouldWeSkipAttachmentReplication(false))
 	{
-		// The subsystem automatically removes entries with the same function signature so its safe to just always add here
-		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->AddObjectToBucket(ClientAuthReplicationData.UpdateRate, this, FName(TEXT("PollReplicationEvent")));
+		// Bound natively to skip ProcessEvent, remove any previous entry since handles don't replace each other
+		UBucketUpdateSubsystem* BucketSubsystem = GetWorld()->GetSubsystem<UBucketUpdateSubsystem>();
+		BucketSubsystem->RemoveFromBucketByHandle(ClientAuthBucketHandle);
+		ClientAuthBucketHandle = BucketSubsystem->AddNativeObjectToBucket(ClientAuthReplicationData.UpdateRate, this, &AGrippableSkeletalMeshActor::PollReplicationEvent, GET_FUNCTION_NAME_CHECKED(AGrippableSkeletalMeshActor, PollReplicationEvent));
 		ClientAuthReplicationData.bIsCurrentlyClientAuth = true;
+		ClientAuthReplicationData.QuantizationProfile = IVRGripInterface::Execute_AdvancedGripSettings(this).MovementQuantizationProfile;
+		ClientAuthReplicationData.BatchingController = UVRClientAuthThrowBatchSubsystem::GetBatchingController(this);
 
 		if (UWorld* World = GetWorld())
 			ClientAuthReplicationData.TimeAtInitialThrow = World->GetTimeSeconds();
@@ -430,7 +436,7 @@ bool AGrippableSkeletalMeshActor::RemoveFromClientReplicationBucket()
 {
 	if (ClientAuthReplicationData.bIsCurrentlyClientAuth)
 	{
-		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->RemoveObjectFromBucketByFunctionName(this, FName(TEXT("PollReplicationEvent")));
+		GetWorld()->GetSubsystem<UBucketUpdateSubsystem>()->RemoveFromBucketByHandle(ClientAuthBucketHandle);
 		CeaseReplicationBlocking();
 		return true;
 	}
@@ -527,9 +533,14 @@ bool AGrippableSkeletalMeshActor::PollReplicationEvent()
 				if (PrimComp->IsSimulatingPhysics() && ShouldWeSkipAttachmentReplication(false))
 				{
 					FRepMovementVR ClientAuthMovementRep;
+					ClientAuthMovementRep.SetQuantizationProfile(ClientAuthReplicationData.QuantizationProfile);
 					if (ClientAuthMovementRep.GatherActorsMovement(this))
 					{
-						Server_GetClientAuthReplication(ClientAuthMovementRep);
+						// Batched with the rest of the owning players thrown objects when enabled
+						if (!UVRClientAuthThrowBatchSubsystem::QueueClientAuthMovement(ClientAuthReplicationData.BatchingController.Get(), this, ClientAuthMovementRep))
+						{
+							Server_GetClientAuthReplication(ClientAuthMovementRep);
+						}
 
 						if (PrimComp->RigidBodyIsAwake())
 						{
@@ -587,6 +598,13 @@ bool AGrippableSkeletalMeshActor::PollReplicationEvent()
 		CeaseReplicationBlocking();
 	}
 
+	// A batched final movement would only go out after the end and re-add the target it removes, send it first like the unbatched path
+	FRepMovementVR QueuedMovementRep;
+	if (UVRClientAuthThrowBatchSubsystem::TakeQueuedClientAuthMovement(this, QueuedMovementRep))
+	{
+		Server_GetClientAuthReplication(QueuedMovementRep);
+	}
+
 	// Tell server to kill us
 	Server_EndClientAuthReplication();
 	return false; // Tell the bucket subsystem to remove us from consideration
@@ -8,6 +8,9 @@
 #include "Animation/AnimInstanceProxy.h"
 #include "Animation/PoseSnapshot.h"
 #include "Animation/AnimData/AnimDataModel.h"
+#include "Animation/Skeleton.h"
+#include "Engine/SkinnedAsset.h"
+#include "HAL/IConsoleManager.h"
 //#include "VRExpansionFunctionLibrary.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Components/PoseableMeshComponent.h"
@@ -25,6 +28,234 @@ const FGuid FVRHandSocketCustomVersion::GUID(0x5A018B7F, 0x48A7AFDE, 0xAFBEB580,
 FCustomVersionRegistration GRegisterHandSocketCustomVersion(FVRHandSocketCustomVersion::GUID, FVRHandSocketCustomVersion::LatestVersion, TEXT("HandSocketVer"));
 
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("HandSocket PoseCache Hits"), STAT_HandSocketPoseCacheHits, STATGROUP_Anim);
+DECLARE_DWORD_COUNTER_STAT(TEXT("HandSocket PoseCache Misses"), STAT_HandSocketPoseCacheMisses, STATGROUP_Anim);
+
+namespace HandSocketComponentCVars
+{
+	static int32 CachePoseSnapShots = 1;
+	FAutoConsoleVariableRef CVarCachePoseSnapShots(
+		TEXT("vre.HandSocket.CachePoseSnapShots"),
+		CachePoseSnapShots,
+		TEXT("When on, pose snapshots built from hand animations are cached per animation, target mesh and handedness.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+}
+
+namespace HandSocketPoseCache
+{
+	// Swaps the side postfix of a bone name (_r <-> _l)
+	static FName GetFlippedBoneName(const FName& BoneName)
+	{
+		FString bName = BoneName.ToString();
+
+		if (bName.Contains("_r"))
+		{
+			bName = bName.Replace(TEXT("_r"), TEXT("_l"));
+		}
+		else
+		{
+			bName = bName.Replace(TEXT("_l"), TEXT("_r"));
+		}
+
+		return FName(bName);
+	}
+
+	// Mirroring a bone across all three axis leaves its basis untouched and only negates the translation
+	static FORCEINLINE void MirrorBoneTransform(FTransform& BoneTransform)
+	{
+		BoneTransform.SetTranslation(-BoneTransform.GetTranslation());
+	}
+
+	struct FPoseKey
+	{
+		TWeakObjectPtr<UAnimSequence> Animation;
+		TWeakObjectPtr<USkinnedAsset> TargetAsset;
+		bool bSkipRootBone;
+		bool bFlipHand;
+
+		FPoseKey(UAnimSequence* InAnimation, USkinnedAsset* InTargetAsset, bool bInSkipRootBone, bool bInFlipHand) :
+			Animation(InAnimation),
+			TargetAsset(InTargetAsset),
+			bSkipRootBone(bInSkipRootBone),
+			bFlipHand(bInFlipHand)
+		{}
+
+		FORCEINLINE bool operator==(const FPoseKey& Other) const
+		{
+			return Animation == Other.Animation && TargetAsset == Other.TargetAsset && bSkipRootBone == Other.bSkipRootBone && bFlipHand == Other.bFlipHand;
+		}
+
+		friend FORCEINLINE uint32 GetTypeHash(const FPoseKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Animation), GetTypeHash(Key.TargetAsset)), (uint32)Key.bSkipRootBone | ((uint32)Key.bFlipHand << 1));
+		}
+	};
+
+	struct FPoseEntry
+	{
+		FName SkeletonName;
+		FName SnapshotName;
+
+		// Bone names as written to the snapshot, already flipped for the other hand
+		TArray<FName> BoneNames;
+
+		// Bone names in the animations skeleton, used for the custom pose delta lookup
+		TArray<FName> SourceBoneNames;
+
+		// Sampled (or ref pose) transforms before deltas and mirroring
+		TArray<FTransform> BaseTransforms;
+
+		// Final transforms, handed out directly when there are no deltas to apply
+		TArray<FTransform> LocalTransforms;
+
+		// Which bones get mirrored when flipping the hand
+		TBitArray<> MirroredBones;
+	};
+
+	static TMap<FPoseKey, FPoseEntry>& GetCache()
+	{
+		static TMap<FPoseKey, FPoseEntry> PoseCache;
+		return PoseCache;
+	}
+
+#if WITH_EDITOR
+	// Animations and meshes can be edited in the editor, drop everything when one of them is touched
+	static void OnObjectModified(UObject* ModifiedObject)
+	{
+		if (ModifiedObject && GetCache().Num() &&
+			(ModifiedObject->IsA<UAnimSequence>() || ModifiedObject->IsA<UAnimDataModel>() || ModifiedObject->IsA<USkinnedAsset>() || ModifiedObject->IsA<USkeleton>()))
+		{
+			GetCache().Empty();
+		}
+	}
+#endif
+
+	static bool BuildPose(FPoseEntry& OutPose, UAnimSequence* InAnimationSequence, USkeletalMeshComponent* TargetMesh, bool bSkipRootBone, bool bFlipHand)
+	{
+		USkeleton* AnimationSkele = InAnimationSequence->GetSkeleton();
+		if (!AnimationSkele)
+		{
+			return false;
+		}
+
+		const FReferenceSkeleton& AnimRefSkeleton = AnimationSkele->GetReferenceSkeleton();
+		USkinnedAsset* TargetAsset = TargetMesh ? TargetMesh->GetSkinnedAsset() : nullptr;
+		const FReferenceSkeleton& RefSkeleton = (TargetAsset) ? TargetAsset->GetRefSkeleton() : AnimRefSkeleton;
+		const int32 NumBones = AnimRefSkeleton.GetNum();
+
+		OutPose.SkeletonName = AnimationSkele->GetFName();
+		OutPose.SnapshotName = InAnimationSequence->GetFName();
+		OutPose.BoneNames.Reset(NumBones);
+		OutPose.SourceBoneNames.Reset(NumBones);
+		OutPose.BaseTransforms.Reset(NumBones);
+		OutPose.LocalTransforms.Reset(NumBones);
+		OutPose.MirroredBones.Init(false, NumBones);
+
+		// Invert the track map once instead of scanning it per bone
+		const TArray<FTrackToSkeletonMap>& TrackMap = InAnimationSequence->GetCompressedTrackToSkeletonMapTable();
+		TArray<int32> BoneToTrack;
+		BoneToTrack.Init(INDEX_NONE, NumBones);
+		for (int32 TrackIndex = TrackMap.Num() - 1; TrackIndex >= 0; --TrackIndex)
+		{
+			const int32 BoneTreeIndex = TrackMap[TrackIndex].BoneTreeIndex;
+			if (BoneTreeIndex >= 0 && BoneTreeIndex < NumBones)
+			{
+				BoneToTrack[BoneTreeIndex] = TrackIndex;
+			}
+		}
+
+		FTransform LocalTransform;
+		for (int32 BoneNameIndex = 0; BoneNameIndex < NumBones; ++BoneNameIndex)
+		{
+			const FName& SourceBoneName = AnimRefSkeleton.GetBoneName(BoneNameIndex);
+			OutPose.SourceBoneNames.Add(SourceBoneName);
+			const FName& BoneName = OutPose.BoneNames.Add_GetRef(bFlipHand ? GetFlippedBoneName(SourceBoneName) : SourceBoneName);
+
+			int32 TrackIndex = BoneToTrack[BoneNameIndex];
+			if (BoneNameIndex < TrackMap.Num() && TrackMap[BoneNameIndex].BoneTreeIndex == BoneNameIndex)
+			{
+				TrackIndex = BoneNameIndex;
+			}
+
+			if (TrackIndex != INDEX_NONE && (!bSkipRootBone || TrackIndex != 0))
+			{
+				double TrackLocation = 0.0f;
+				InAnimationSequence->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(TrackMap[TrackIndex].BoneTreeIndex), TrackLocation, false);
+			}
+			else
+			{
+				// otherwise, get ref pose if exists
+				const int32 BoneIDX = RefSkeleton.FindBoneIndex(BoneName);
+				if (BoneIDX != INDEX_NONE)
+				{
+					LocalTransform = RefSkeleton.GetRefBonePose()[BoneIDX];
+				}
+				else
+				{
+					LocalTransform = FTransform::Identity;
+				}
+			}
+
+			OutPose.BaseTransforms.Add(LocalTransform);
+
+			if (bFlipHand && (!bSkipRootBone || TrackIndex != 0))
+			{
+				OutPose.MirroredBones[BoneNameIndex] = true;
+				MirrorBoneTransform(LocalTransform);
+			}
+
+			OutPose.LocalTransforms.Add(LocalTransform);
+		}
+
+		return true;
+	}
+
+	// Returns the cached pose, building it on a miss. Off of the game thread or with caching disabled the pose is built into ScratchPose instead.
+	static const FPoseEntry* FindOrBuild(UAnimSequence* InAnimationSequence, USkeletalMeshComponent* TargetMesh, bool bSkipRootBone, bool bFlipHand, FPoseEntry& ScratchPose)
+	{
+		if (!HandSocketComponentCVars::CachePoseSnapShots || !IsInGameThread())
+		{
+			return BuildPose(ScratchPose, InAnimationSequence, TargetMesh, bSkipRootBone, bFlipHand) ? &ScratchPose : nullptr;
+		}
+
+		TMap<FPoseKey, FPoseEntry>& PoseCache = GetCache();
+		const FPoseKey PoseKey(InAnimationSequence, TargetMesh ? TargetMesh->GetSkinnedAsset() : nullptr, bSkipRootBone, bFlipHand);
+
+		if (const FPoseEntry* CachedPose = PoseCache.Find(PoseKey))
+		{
+			INC_DWORD_STAT(STAT_HandSocketPoseCacheHits);
+			return CachedPose;
+		}
+
+		INC_DWORD_STAT(STAT_HandSocketPoseCacheMisses);
+
+		if (!BuildPose(ScratchPose, InAnimationSequence, TargetMesh, bSkipRootBone, bFlipHand))
+		{
+			return nullptr;
+		}
+
+#if WITH_EDITOR
+		static FDelegateHandle ObjectModifiedHandle;
+		if (!ObjectModifiedHandle.IsValid())
+		{
+			ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddStatic(&OnObjectModified);
+		}
+#endif
+
+		// Misses are rare, use them to drop entries for unloaded assets
+		for (TMap<FPoseKey, FPoseEntry>::TIterator It = PoseCache.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().Animation.IsValid() || (!It.Key().TargetAsset.IsExplicitlyNull() && !It.Key().TargetAsset.IsValid()))
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		return &PoseCache.Add(PoseKey, MoveTemp(ScratchPose));
+	}
+}
+
 void UHandSocketComponent::Serialize(FArchive& Ar)
 {
 	Super::Serialize(Ar);
@@ -92,105 +323,18 @@ bool UHandSocketComponent::GetAnimationSequenceAsPoseSnapShot(UAnimSequence* InA
 {
 	if (InAnimationSequence)
 	{
-		OutPoseSnapShot.SkeletalMeshName = /*TargetMesh ? TargetMesh->SkeletalMesh->GetFName(): */InAnimationSequence->GetSkeleton()->GetFName();
-		OutPoseSnapShot.SnapshotName = InAnimationSequence->GetFName();
-		OutPoseSnapShot.BoneNames.Empty();
-		OutPoseSnapShot.LocalTransforms.Empty();
-
-		TArray<FName> AnimSeqNames;
-
-		if (USkeleton* AnimationSkele = InAnimationSequence->GetSkeleton())
-		{
-			// pre-size the array to avoid unnecessary reallocation
-			OutPoseSnapShot.BoneNames.AddUninitialized(AnimationSkele->GetReferenceSkeleton().GetNum());
-			for (int32 i = 0; i < AnimationSkele->GetReferenceSkeleton().GetNum(); i++)
-			{
-				OutPoseSnapShot.BoneNames[i] = AnimationSkele->GetReferenceSkeleton().GetBoneName(i);
-				if (bFlipHand)
-				{
-					FString bName = OutPoseSnapShot.BoneNames[i].ToString();
-
-					if (bName.Contains("_r"))
-					{
-						bName = bName.Replace(TEXT("_r"), TEXT("_l"));
-					}
-					else
-					{
-						bName = bName.Replace(TEXT("_l"), TEXT("_r"));
-					}
+		HandSocketPoseCache::FPoseEntry ScratchPose;
+		const HandSocketPoseCache::FPoseEntry* CachedPose = HandSocketPoseCache::FindOrBuild(InAnimationSequence, TargetMesh, bSkipRootBone, bFlipHand, ScratchPose);
 
-					OutPoseSnapShot.BoneNames[i] = FName(bName);
-				}
-			}
-		}
-		else
+		if (!CachedPose)
 		{
 			return false;
 		}
 
-		const FReferenceSkeleton& RefSkeleton = (TargetMesh) ? TargetMesh->GetSkinnedAsset()->GetRefSkeleton() : InAnimationSequence->GetSkeleton()->GetReferenceSkeleton();
-		FTransform LocalTransform;
-
-		const TArray<FTrackToSkeletonMap>& TrackMap = InAnimationSequence->GetCompressedTrackToSkeletonMapTable();
-		int32 TrackIndex = INDEX_NONE;
-
-		OutPoseSnapShot.LocalTransforms.Reserve(OutPoseSnapShot.BoneNames.Num());
-
-		for (int32 BoneNameIndex = 0; BoneNameIndex < OutPoseSnapShot.BoneNames.Num(); ++BoneNameIndex)
-		{
-
-			const FName& BoneName = OutPoseSnapShot.BoneNames[BoneNameIndex];
-
-			TrackIndex = INDEX_NONE;
-			if (BoneNameIndex != INDEX_NONE && BoneNameIndex < TrackMap.Num() && TrackMap[BoneNameIndex].BoneTreeIndex == BoneNameIndex)
-			{
-				TrackIndex = BoneNameIndex;
-			}
-			else
-			{
-				// This shouldn't happen but I need a fallback
-				// Don't currently want to reconstruct the map inversely
-				for (int i = 0; i < TrackMap.Num(); ++i)
-				{
-					if (TrackMap[i].BoneTreeIndex == BoneNameIndex)
-					{
-						TrackIndex = i;
-						break;
-					}
-				}
-			}
-
-			if (TrackIndex != INDEX_NONE && (!bSkipRootBone || TrackIndex != 0))
-			{
-				double TrackLocation = 0.0f;			
-				InAnimationSequence->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(TrackMap[TrackIndex].BoneTreeIndex), TrackLocation, false);
-			}
-			else
-			{
-				// otherwise, get ref pose if exists
-				const int32 BoneIDX = RefSkeleton.FindBoneIndex(BoneName);
-				if (BoneIDX != INDEX_NONE)
-				{
-					LocalTransform = RefSkeleton.GetRefBonePose()[BoneIDX];
-				}
-				else
-				{
-					LocalTransform = FTransform::Identity;
-				}
-			}
-
-			if (bFlipHand && (!bSkipRootBone || TrackIndex != 0))
-			{
-				FMatrix M = LocalTransform.ToMatrixWithScale();
-				M.Mirror(EAxis::X, EAxis::X);
-				M.Mirror(EAxis::Y, EAxis::Y);
-				M.Mirror(EAxis::Z, EAxis::Z);
-				LocalTransform.SetFromMatrix(M);
-			}
-
-			OutPoseSnapShot.LocalTransforms.Add(LocalTransform);
-		}
-
+		OutPoseSnapShot.SkeletalMeshName = /*TargetMesh ? TargetMesh->SkeletalMesh->GetFName(): */CachedPose->SkeletonName;
+		OutPoseSnapShot.SnapshotName = CachedPose->SnapshotName;
+		OutPoseSnapShot.BoneNames = CachedPose->BoneNames;
+		OutPoseSnapShot.LocalTransforms = CachedPose->LocalTransforms;
 		OutPoseSnapShot.bIsValid = true;
 		return true;
 	}
@@ -198,117 +342,57 @@ bool UHandSocketComponent::GetAnimationSequenceAsPoseSnapShot(UAnimSequence* InA
 	return false;
 }
 
+void UHandSocketComponent::ClearCachedPoseSnapShots()
+{
+	HandSocketPoseCache::GetCache().Empty();
+}
+
 bool UHandSocketComponent::GetBlendedPoseSnapShot(FPoseSnapshot& PoseSnapShot, USkeletalMeshComponent* TargetMesh, bool bSkipRootBone, bool bFlipHand)
 {
 	if (HandTargetAnimation)// && bUseCustomPoseDeltas && CustomPoseDeltas.Num() > 0)
 	{
-		PoseSnapShot.SkeletalMeshName = HandTargetAnimation->GetSkeleton()->GetFName();
-		PoseSnapShot.SnapshotName = HandTargetAnimation->GetFName();
-		PoseSnapShot.BoneNames.Empty();
-		PoseSnapShot.LocalTransforms.Empty();
-		TArray<FName> OrigBoneNames;
-
-		if(USkeleton * AnimationSkele = HandTargetAnimation->GetSkeleton())
-		{
-			// pre-size the array to avoid unnecessary reallocation
-			PoseSnapShot.BoneNames.AddUninitialized(AnimationSkele->GetReferenceSkeleton().GetNum());
-			OrigBoneNames.AddUninitialized(AnimationSkele->GetReferenceSkeleton().GetNum());
-			for (int32 i = 0; i < AnimationSkele->GetReferenceSkeleton().GetNum(); i++)
-			{
-				PoseSnapShot.BoneNames[i] = AnimationSkele->GetReferenceSkeleton().GetBoneName(i);
-				OrigBoneNames[i] = PoseSnapShot.BoneNames[i];
-				if (bFlipHand)
-				{
-					FString bName = PoseSnapShot.BoneNames[i].ToString();
-
-					if (bName.Contains("_r"))
-					{
-						bName = bName.Replace(TEXT("_r"), TEXT("_l"));
-					}
-					else
-					{
-						bName = bName.Replace(TEXT("_l"), TEXT("_r"));
-					}
+		HandSocketPoseCache::FPoseEntry ScratchPose;
+		const HandSocketPoseCache::FPoseEntry* CachedPose = HandSocketPoseCache::FindOrBuild(HandTargetAnimation, TargetMesh, bSkipRootBone, bFlipHand, ScratchPose);
 
-					PoseSnapShot.BoneNames[i] = FName(bName);
-				}
-			}
-		}
-		else
+		if (!CachedPose)
 		{
 			return false;
 		}
 
-		const FReferenceSkeleton& RefSkeleton = (TargetMesh) ? TargetMesh->GetSkinnedAsset()->GetRefSkeleton() : HandTargetAnimation->GetSkeleton()->GetReferenceSkeleton();
-		FTransform LocalTransform;
-
-		const TArray<FTrackToSkeletonMap>& TrackMap = HandTargetAnimation->GetCompressedTrackToSkeletonMapTable();
-		int32 TrackIndex = INDEX_NONE;
+		PoseSnapShot.SkeletalMeshName = CachedPose->SkeletonName;
+		PoseSnapShot.SnapshotName = CachedPose->SnapshotName;
+		PoseSnapShot.BoneNames = CachedPose->BoneNames;
 
-		for (int32 BoneNameIndex = 0; BoneNameIndex < PoseSnapShot.BoneNames.Num(); ++BoneNameIndex)
+		if (!bUseCustomPoseDeltas)
 		{
-			TrackIndex = INDEX_NONE;
-			if (BoneNameIndex < TrackMap.Num() && TrackMap[BoneNameIndex].BoneTreeIndex == BoneNameIndex)
-			{
-				TrackIndex = BoneNameIndex;
-			}
-			else
-			{
-				// This shouldn't happen but I need a fallback
-				// Don't currently want to reconstruct the map inversely
-				for (int i = 0; i < TrackMap.Num(); ++i)
-				{
-					if (TrackMap[i].BoneTreeIndex == BoneNameIndex)
-					{
-						TrackIndex = i;
-						break;
-					}
-				}
-			}
-
-			const FName& BoneName = PoseSnapShot.BoneNames[BoneNameIndex];
+			PoseSnapShot.LocalTransforms = CachedPose->LocalTransforms;
+		}
+		else
+		{
+			// Deltas are applied before mirroring so we start from the un-mirrored base pose
+			const int32 NumBones = CachedPose->BaseTransforms.Num();
+			PoseSnapShot.LocalTransforms.Reset(NumBones);
 
-			if (TrackIndex != INDEX_NONE && (!bSkipRootBone || TrackIndex != 0))
-			{
-				double TrackLocation = 0.0f;
-				HandTargetAnimation->GetBoneTransform(LocalTransform, FSkeletonPoseBoneIndex(TrackMap[TrackIndex].BoneTreeIndex), TrackLocation, false);
-			}
-			else
+			for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
 			{
-				// otherwise, get ref pose if exists
-				const int32 BoneIDX = RefSkeleton.FindBoneIndex(BoneName);
-				if (BoneIDX != INDEX_NONE)
-				{
-					LocalTransform = RefSkeleton.GetRefBonePose()[BoneIDX];
-				}
-				else
-				{
-					LocalTransform = FTransform::Identity;
-				}
-			}
+				FTransform LocalTransform = CachedPose->BaseTransforms[BoneIndex];
 
-			if (bUseCustomPoseDeltas)
-			{
 				FQuat DeltaQuat = FQuat::Identity;
-				if (FBPVRHandPoseBonePair* HandPair = CustomPoseDeltas.FindByKey(OrigBoneNames[BoneNameIndex]))
+				if (FBPVRHandPoseBonePair* HandPair = CustomPoseDeltas.FindByKey(CachedPose->SourceBoneNames[BoneIndex]))
 				{
 					DeltaQuat = HandPair->DeltaPose;
 				}
 
 				LocalTransform.ConcatenateRotation(DeltaQuat);
 				LocalTransform.NormalizeRotation();
-			}
 
-			if (bFlipHand && (!bSkipRootBone || TrackIndex != 0))
-			{
-				FMatrix M = LocalTransform.ToMatrixWithScale();
-				M.Mirror(EAxis::X, EAxis::X);
-				M.Mirror(EAxis::Y, EAxis::Y);
-				M.Mirror(EAxis::Z, EAxis::Z);
-				LocalTransform.SetFromMatrix(M);
-			}
+				if (CachedPose->MirroredBones[BoneIndex])
+				{
+					HandSocketPoseCache::MirrorBoneTransform(LocalTransform);
+				}
 
-			PoseSnapShot.LocalTransforms.Add(LocalTransform);
+				PoseSnapShot.LocalTransforms.Add(LocalTransform);
+			}
 		}
 
 		PoseSnapShot.bIsValid = true;
@@ -329,41 +413,13 @@ bool UHandSocketComponent::GetBlendedPoseSnapShot(FPoseSnapshot& PoseSnapShot, U
 
 		for (FBPVRHandPoseBonePair& HandPair : CustomPoseDeltas)
 		{
-			if (bFlipHand)
-			{
-				FString bName = HandPair.BoneName.ToString();
-
-				if (bName.Contains("_r"))
-				{
-					bName = bName.Replace(TEXT("_r"), TEXT("_l"));
-				}
-				else
-				{
-					bName = bName.Replace(TEXT("_l"), TEXT("_r"));
-				}
-
-				TargetBoneName = FName(bName);
-			}
-			else
-			{
-				TargetBoneName = HandPair.BoneName;
-			}
+			TargetBoneName = bFlipHand ? HandSocketPoseCache::GetFlippedBoneName(HandPair.BoneName) : HandPair.BoneName;
 
 			int32 BoneIdx = TargetMesh->GetBoneIndex(TargetBoneName);
 			if (BoneIdx != INDEX_NONE)
 			{
+				// Mirroring across all three axis leaves a pure rotation untouched, so the delta applies as is
 				DeltaQuat = HandPair.DeltaPose;
-
-				if (bFlipHand)
-				{
-					FTransform DeltaTrans(DeltaQuat);
-					FMatrix M = DeltaTrans.ToMatrixWithScale();
-					M.Mirror(EAxis::X, EAxis::X);
-					M.Mirror(EAxis::Y, EAxis::Y);
-					M.Mirror(EAxis::Z, EAxis::Z);
-					DeltaTrans.SetFromMatrix(M);
-					DeltaQuat = DeltaTrans.GetRotation();					
-				}
 			
 				PoseSnapShot.LocalTransforms[BoneIdx].ConcatenateRotation(DeltaQuat);
 				PoseSnapShot.LocalTransforms[BoneIdx].NormalizeRotation();
@@ -3,6 +3,28 @@
 #include "Misc/BucketUpdateSubsystem.h"
 #include UE_INLINE_GENERATED_CPP_BY_NAME(BucketUpdateSubsystem)
 
+DECLARE_CYCLE_STAT(TEXT("UpdateBuckets"), STAT_UpdateBuckets, STATGROUP_BucketUpdates);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Callbacks Fired"), STAT_BucketCallbacksFired, STATGROUP_BucketUpdates);
+
+namespace BucketUpdateCvars
+{
+	static int32 SpreadBucketLoad = 1;
+	FAutoConsoleVariableRef CVarSpreadBucketLoad(
+		TEXT("vr.BucketUpdates.SpreadLoad"),
+		SpreadBucketLoad,
+		TEXT("When on, the callbacks in an update bucket are spread evenly over the frames of its update period instead of all firing on the same frame.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+
+	static float FrameBudgetMs = 0.0f;
+	FAutoConsoleVariableRef CVarBucketFrameBudget(
+		TEXT("vr.BucketUpdates.FrameBudgetMs"),
+		FrameBudgetMs,
+		TEXT("Time in milliseconds that bucket callbacks can take per frame before the rest are deferred to the next frame.\n")
+		TEXT("0: Unlimited"),
+		ECVF_Default);
+}
+
 	bool UBucketUpdateSubsystem::AddObjectToBucket(int32 UpdateHTZ, UObject* InObject, FName FunctionName)
 	{
 		if (!InObject || UpdateHTZ < 1)
@@ -65,6 +87,26 @@
 		return BucketContainer.bNeedsUpdate;
 	}
 
+	void UBucketUpdateSubsystem::GetBucketStats(TArray<FBPBucketUpdateStats>& OutStats)
+	{
+		BucketContainer.GetBucketStats(OutStats);
+	}
+
+	bool UBucketUpdateSubsystem::RemoveFromBucketByHandle(FBucketUpdateHandle& Handle)
+	{
+		if (!Handle.IsValid())
+			return false;
+
+		bool bRemoved = BucketContainer.RemoveBucketCallback(Handle);
+		Handle.Reset();
+		return bRemoved;
+	}
+
+	bool UBucketUpdateSubsystem::IsHandleInBucket(const FBucketUpdateHandle& Handle) const
+	{
+		return BucketContainer.IsHandleInBucket(Handle);
+	}
+
 	void UBucketUpdateSubsystem::Tick(float DeltaTime)
 	{
 		BucketContainer.UpdateBuckets(DeltaTime);
@@ -136,15 +178,19 @@
 	FUpdateBucketDrop::FUpdateBucketDrop()
 	{
 		FunctionName = NAME_None;
+		HandleID = 0;
 	}
 
 	FUpdateBucketDrop::FUpdateBucketDrop(FDynamicBucketUpdateTickSignature & DynCallback)
 	{
 		DynamicCallback = DynCallback;
+		HandleID = 0;
 	}
 
 	FUpdateBucketDrop::FUpdateBucketDrop(UObject * Obj, FName FuncName)
 	{
+		HandleID = 0;
+
 		if (Obj && Obj->FindFunction(FuncName))
 		{
 			FunctionName = FuncName;
@@ -155,77 +201,299 @@
 			FunctionName = NAME_None;
 		}
 	}
+
+	FUpdateBucketDrop::FUpdateBucketDrop(FBucketUpdateTickSignature && InNativeCallback, FName FuncName)
+	{
+		NativeCallback = MoveTemp(InNativeCallback);
+		FunctionName = FuncName;
+		HandleID = 0;
+	}
 	
-	bool FUpdateBucket::Update(float DeltaTime)
+	bool FUpdateBucket::Update(float DeltaTime, bool bSpreadLoad, double BudgetEndTime, TArray<TPair<uint64, TObjectKey<UObject>>>& OutRemovedHandles)
 	{
-		//#TODO: Need to consider batching / spreading out load if there are a lot of updating objects in the bucket
+		CallbacksFiredLastUpdate = 0;
+		LastUpdateTime = 0.0;
+
 		if (Callbacks.Num() < 1)
 			return false;
 
 		// Check for if this bucket is ready to fire events
 		nUpdateCount += DeltaTime;
-		if (nUpdateCount >= nUpdateRate)
+		const bool bPeriodComplete = nUpdateCount >= nUpdateRate;
+
+		// How many of the callbacks should have fired by this point in the period
+		int32 TargetIndex = 0;
+		if (bPeriodComplete)
+		{
+			TargetIndex = Callbacks.Num();
+		}
+		else if (bSpreadLoad)
+		{
+			TargetIndex = FMath::CeilToInt(Callbacks.Num() * (nUpdateCount / nUpdateRate));
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		bool bOverBudget = false;
+
+		while (NextCallbackIndex < FMath::Min(TargetIndex, Callbacks.Num()))
 		{
-			nUpdateCount = 0.0f;
-			for (int i = Callbacks.Num() - 1; i >= 0; --i)
+			if (BudgetEndTime > 0.0 && FPlatformTime::Seconds() >= BudgetEndTime)
+			{
+				bOverBudget = true;
+				break;
+			}
+
+			CallbacksFiredLastUpdate++;
+
+			const uint64 FiringHandle = Callbacks[NextCallbackIndex].HandleID;
+			const bool bKeep = Callbacks[NextCallbackIndex].ExecuteBoundCallback();
+
+			// The callback can add or remove entries (including itself), so look up where it ended up
+			const int32* FiringIndexPtr = HandleIndices.Find(FiringHandle);
+			if (!FiringIndexPtr)
+			{
+				// Removed itself, the slot now holds one that hasn't fired yet
+				continue;
+			}
+
+			const int32 FiringIndex = *FiringIndexPtr;
+
+			if (bKeep)
 			{
-				if (Callbacks[i].ExecuteBoundCallback())
+				// If this returns true then we keep it in the queue
+				// Move it to the edge of the fired range in case a removal shuffled it further in
+				if (FiringIndex >= NextCallbackIndex)
 				{
-					// If this returns true then we keep it in the queue
-					continue;
+					if (FiringIndex != NextCallbackIndex)
+					{
+						Callbacks.Swap(FiringIndex, NextCallbackIndex);
+						HandleIndices.Add(Callbacks[FiringIndex].HandleID, FiringIndex);
+						HandleIndices.Add(FiringHandle, NextCallbackIndex);
+					}
+
+					NextCallbackIndex++;
 				}
-
+			}
+			else
+			{
 				// Remove the callback, it is complete or invalid
-				Callbacks.RemoveAt(i);
+				TObjectKey<UObject> OwnerKey;
+				const uint64 RemovedHandle = RemoveCallbackAt(FiringIndex, &OwnerKey);
+				OutRemovedHandles.Emplace(RemovedHandle, OwnerKey);
 			}
 		}
 
+		if (bPeriodComplete && NextCallbackIndex >= Callbacks.Num())
+		{
+			NextCallbackIndex = 0;
+
+			// Keep the remainder so that the rate doesn't drift, but don't try to catch up on whole missed periods
+			nUpdateCount = FMath::Fmod(nUpdateCount - nUpdateRate, nUpdateRate);
+		}
+
+		LastUpdateTime = FPlatformTime::Seconds() - StartTime;
+		if (bOverBudget)
+		{
+			OverBudgetCount++;
+		}
+
+		INC_DWORD_STAT_BY(STAT_BucketCallbacksFired, CallbacksFiredLastUpdate);
+
 		return Callbacks.Num() > 0;
 	}
+
+	uint64 FUpdateBucket::RemoveCallbackAt(int32 Index, TObjectKey<UObject>* OutOwnerKey)
+	{
+		if (!Callbacks.IsValidIndex(Index))
+			return 0;
+
+		// Already fired this period, trade places with the last fired one so the hole is at the edge of the unfired range
+		if (Index < NextCallbackIndex)
+		{
+			NextCallbackIndex--;
+			if (Index != NextCallbackIndex)
+			{
+				Callbacks.Swap(Index, NextCallbackIndex);
+				HandleIndices.Add(Callbacks[Index].HandleID, Index);
+			}
+			Index = NextCallbackIndex;
+		}
+
+		const uint64 RemovedHandle = Callbacks[Index].HandleID;
+		if (OutOwnerKey)
+		{
+			*OutOwnerKey = Callbacks[Index].OwnerKey;
+		}
+
+		HandleIndices.Remove(RemovedHandle);
+		Callbacks.RemoveAtSwap(Index, 1, false);
+
+		if (Callbacks.IsValidIndex(Index))
+		{
+			HandleIndices.Add(Callbacks[Index].HandleID, Index);
+		}
+
+		return RemovedHandle;
+	}
+
+	void FUpdateBucket::AddCallback(FUpdateBucketDrop && NewDrop)
+	{
+		HandleIndices.Add(NewDrop.HandleID, Callbacks.Num());
+		Callbacks.Add(MoveTemp(NewDrop));
+	}
 	
 	void FUpdateBucketContainer::UpdateBuckets(float DeltaTime)
 	{
-		TArray<uint32> BucketsToRemove;
-		for(auto& Bucket : ReplicationBuckets)
-		{		
-			if (!Bucket.Value.Update(DeltaTime))
+		SCOPE_CYCLE_COUNTER(STAT_UpdateBuckets);
+
+		const double BudgetEndTime = BucketUpdateCvars::FrameBudgetMs > 0.0f ? FPlatformTime::Seconds() + (BucketUpdateCvars::FrameBudgetMs / 1000.0) : 0.0;
+		const bool bSpreadLoad = BucketUpdateCvars::SpreadBucketLoad > 0;
+
+		RemovedHandles.Reset();
+
+		// The budget is shared, rotate the starting bucket so the ones late in the map still get their turn at it
+		BucketUpdateOrder.Reset();
+		ReplicationBuckets.GenerateKeyArray(BucketUpdateOrder);
+
+		const int32 NumBuckets = BucketUpdateOrder.Num();
+		const int32 StartingBucket = NumBuckets > 0 ? (int32)(NextStartingBucket++ % (uint32)NumBuckets) : 0;
+
+		for (int32 i = 0; i < NumBuckets; ++i)
+		{
+			const uint32 BucketKey = BucketUpdateOrder[(StartingBucket + i) % NumBuckets];
+			FUpdateBucket* Bucket = ReplicationBuckets.Find(BucketKey);
+
+			if (Bucket && !Bucket->Update(DeltaTime, bSpreadLoad, BudgetEndTime, RemovedHandles))
 			{
-				// Add Bucket to list to remove at end of update
-				BucketsToRemove.Add(Bucket.Key);
+				// Remove unused buckets so that they don't get ticked
+				ReplicationBuckets.Remove(BucketKey);
 			}
 		}
 
-		// Remove unused buckets so that they don't get ticked
-		for (const uint32 Key : BucketsToRemove)
+		for (const TPair<uint64, TObjectKey<UObject>>& Removed : RemovedHandles)
 		{
-			ReplicationBuckets.Remove(Key);
+			ForgetHandle(Removed.Key, Removed.Value);
 		}
 
 		if (ReplicationBuckets.Num() < 1)
 			bNeedsUpdate = false;
 	}
 
-	bool FUpdateBucketContainer::AddBucketObject(uint32 UpdateHTZ, UObject* InObject, FName FunctionName)
+	void FUpdateBucketContainer::GetBucketStats(TArray<FBPBucketUpdateStats>& OutStats) const
 	{
-		if (!InObject || InObject->FindFunction(FunctionName) == nullptr || UpdateHTZ < 1)
-			return false;
+		OutStats.Reset(ReplicationBuckets.Num());
 
-		// First verify that this object isn't already contained in a bucket, if it is then erase it so that we can replace it below
-		RemoveBucketObject(InObject, FunctionName);
+		for (const auto& Bucket : ReplicationBuckets)
+		{
+			FBPBucketUpdateStats& Stats = OutStats.AddDefaulted_GetRef();
+			Stats.UpdateHTZ = (int32)Bucket.Key;
+			Stats.NumCallbacks = Bucket.Value.Callbacks.Num();
+			Stats.CallbacksFiredLastTick = Bucket.Value.CallbacksFiredLastUpdate;
+			Stats.LastTickTimeMs = (float)(Bucket.Value.LastUpdateTime * 1000.0);
+			Stats.OverBudgetCount = Bucket.Value.OverBudgetCount;
+		}
+	}
+
+	FBucketUpdateHandle FUpdateBucketContainer::AddDrop(uint32 UpdateHTZ, FUpdateBucketDrop && NewDrop, UObject* Owner)
+	{
+		FBucketUpdateHandle NewHandle;
+		NewHandle.ID = ++NextHandleID;
+
+		NewDrop.HandleID = NewHandle.ID;
+		NewDrop.OwnerKey = TObjectKey<UObject>(Owner);
 
-		if (ReplicationBuckets.Contains(UpdateHTZ))
+		FUpdateBucket* Bucket = ReplicationBuckets.Find(UpdateHTZ);
+		if (!Bucket)
 		{
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(InObject, FunctionName));
+			Bucket = &ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ));
 		}
-		else
+
+		Bucket->AddCallback(MoveTemp(NewDrop));
+		HandleBuckets.Add(NewHandle.ID, UpdateHTZ);
+
+		if (Owner)
 		{
-			FUpdateBucket & newBucket = ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ));
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(InObject, FunctionName));
+			ObjectHandles.Add(TObjectKey<UObject>(Owner), NewHandle.ID);
 		}
 
-		if (ReplicationBuckets.Num() > 0)
-			bNeedsUpdate = true;
+		bNeedsUpdate = true;
+		return NewHandle;
+	}
 
+	FUpdateBucket* FUpdateBucketContainer::FindHandle(uint64 HandleID, int32& OutIndex)
+	{
+		OutIndex = INDEX_NONE;
+
+		if (const uint32* BucketHTZ = HandleBuckets.Find(HandleID))
+		{
+			if (FUpdateBucket* Bucket = ReplicationBuckets.Find(*BucketHTZ))
+			{
+				if (const int32* Index = Bucket->HandleIndices.Find(HandleID))
+				{
+					OutIndex = *Index;
+					return Bucket;
+				}
+			}
+		}
+
+		return nullptr;
+	}
+
+	bool FUpdateBucketContainer::RemoveByHandleID(uint64 HandleID)
+	{
+		int32 Index = INDEX_NONE;
+		if (FUpdateBucket* Bucket = FindHandle(HandleID, Index))
+		{
+			TObjectKey<UObject> OwnerKey;
+			Bucket->RemoveCallbackAt(Index, &OwnerKey);
+			ForgetHandle(HandleID, OwnerKey);
+			return true;
+		}
+
+		return false;
+	}
+
+	void FUpdateBucketContainer::ForgetHandle(uint64 HandleID, const TObjectKey<UObject>& OwnerKey)
+	{
+		HandleBuckets.Remove(HandleID);
+
+		if (OwnerKey != TObjectKey<UObject>())
+		{
+			ObjectHandles.RemoveSingle(OwnerKey, HandleID);
+		}
+	}
+
+	FBucketUpdateHandle FUpdateBucketContainer::AddBucketCallback(uint32 UpdateHTZ, FBucketUpdateTickSignature && Callback, UObject* Owner, FName FunctionName)
+	{
+		if (!Callback.IsBound() || UpdateHTZ < 1)
+			return FBucketUpdateHandle();
+
+		// Only an owned entry can be matched by its function name
+		return AddDrop(UpdateHTZ, FUpdateBucketDrop(MoveTemp(Callback), Owner ? FunctionName : NAME_None), Owner);
+	}
+
+	bool FUpdateBucketContainer::RemoveBucketCallback(FBucketUpdateHandle Handle)
+	{
+		if (!Handle.IsValid())
+			return false;
+
+		return RemoveByHandleID(Handle.ID);
+	}
+
+	bool FUpdateBucketContainer::IsHandleInBucket(FBucketUpdateHandle Handle) const
+	{
+		return Handle.IsValid() && HandleBuckets.Contains(Handle.ID);
+	}
+
+	bool FUpdateBucketContainer::AddBucketObject(uint32 UpdateHTZ, UObject* InObject, FName FunctionName)
+	{
+		if (!InObject || InObject->FindFunction(FunctionName) == nullptr || UpdateHTZ < 1)
+			return false;
+
+		// First verify that this object isn't already contained in a bucket, if it is then erase it so that we can replace it below
+		RemoveBucketObject(InObject, FunctionName);
+
+		AddDrop(UpdateHTZ, FUpdateBucketDrop(InObject, FunctionName), InObject);
 		return true;
 	}
 
@@ -238,52 +506,29 @@
 		// First verify that this object isn't already contained in a bucket, if it is then erase it so that we can replace it below
 		RemoveBucketObject(Delegate);
 
-		if (ReplicationBuckets.Contains(UpdateHTZ))
-		{
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(Delegate));
-		}
-		else
-		{
-			FUpdateBucket & newBucket = ReplicationBuckets.Add(UpdateHTZ, FUpdateBucket(UpdateHTZ));
-			ReplicationBuckets[UpdateHTZ].Callbacks.Add(FUpdateBucketDrop(Delegate));
-		}
-
-		if (ReplicationBuckets.Num() > 0)
-			bNeedsUpdate = true;
-
+		AddDrop(UpdateHTZ, FUpdateBucketDrop(Delegate), Delegate.GetUObject());
 		return true;
 	}
 
 	bool FUpdateBucketContainer::RemoveBucketObject(UObject * ObjectToRemove, FName FunctionName)
 	{
-		if (!ObjectToRemove || ObjectToRemove->FindFunction(FunctionName) == nullptr)
+		if (!ObjectToRemove)
 			return false;
 
-		// Store if we ended up removing it
-		bool bRemovedObject = false;
-
-		TArray<uint32> BucketsToRemove;
-		for (auto& Bucket : ReplicationBuckets)
+		for (auto It = ObjectHandles.CreateConstKeyIterator(TObjectKey<UObject>(ObjectToRemove)); It; ++It)
 		{
-			for (int i = Bucket.Value.Callbacks.Num() - 1; i >= 0; --i)
+			int32 Index = INDEX_NONE;
+			if (FUpdateBucket* Bucket = FindHandle(It.Value(), Index))
 			{
-				if (Bucket.Value.Callbacks[i].IsBoundToObjectFunction(ObjectToRemove, FunctionName))
+				if (Bucket->Callbacks[Index].IsBoundToObjectFunction(ObjectToRemove, FunctionName))
 				{
-					Bucket.Value.Callbacks.RemoveAt(i);
-					bRemovedObject = true;
-
-					// Leave the loop, this is called in add as well so we should never get duplicate entries
-					break;
+					// Adding removes any existing entry so there is never more than one
+					return RemoveByHandleID(It.Value());
 				}
 			}
-
-			if (bRemovedObject)
-			{
-				break;
-			}
 		}
 
-		return bRemovedObject;
+		return false;
 	}
 
 	bool FUpdateBucketContainer::RemoveBucketObject(FDynamicBucketUpdateTickSignature &DynEvent)
@@ -291,31 +536,20 @@
 		if (!DynEvent.IsBound())
 			return false;
 
-		// Store if we ended up removing it
-		bool bRemovedObject = false;
-
-		TArray<uint32> BucketsToRemove;
-		for (auto& Bucket : ReplicationBuckets)
+		for (auto It = ObjectHandles.CreateConstKeyIterator(TObjectKey<UObject>(DynEvent.GetUObject())); It; ++It)
 		{
-			for (int i = Bucket.Value.Callbacks.Num() - 1; i >= 0; --i)
+			int32 Index = INDEX_NONE;
+			if (FUpdateBucket* Bucket = FindHandle(It.Value(), Index))
 			{
-				if (Bucket.Value.Callbacks[i].IsBoundToObjectDelegate(DynEvent))
+				if (Bucket->Callbacks[Index].IsBoundToObjectDelegate(DynEvent))
 				{
-					Bucket.Value.Callbacks.RemoveAt(i);
-					bRemovedObject = true;
-
-					// Leave the loop, this is called in add as well so we should never get duplicate entries
-					break;
+					// Adding removes any existing entry so there is never more than one
+					return RemoveByHandleID(It.Value());
 				}
 			}
-
-			if (bRemovedObject)
-			{
-				break;
-			}
 		}
 
-		return bRemovedObject;
+		return false;
 	}
 
 	bool FUpdateBucketContainer::RemoveObjectFromAllBuckets(UObject * ObjectToRemove)
@@ -323,20 +557,13 @@
 		if (!ObjectToRemove)
 			return false;
 
-		// Store if we ended up removing it
-		bool bRemovedObject = false;
+		TArray<uint64, TInlineAllocator<8>> HandlesToRemove;
+		ObjectHandles.MultiFind(TObjectKey<UObject>(ObjectToRemove), HandlesToRemove);
 
-		TArray<uint32> BucketsToRemove;
-		for (auto& Bucket : ReplicationBuckets)
+		bool bRemovedObject = false;
+		for (const uint64 HandleID : HandlesToRemove)
 		{
-			for (int i = Bucket.Value.Callbacks.Num() - 1; i >= 0; --i)
-			{
-				if (Bucket.Value.Callbacks[i].IsBoundToObject(ObjectToRemove))
-				{
-					Bucket.Value.Callbacks.RemoveAt(i);
-					bRemovedObject = true;
-				}
-			}
+			bRemovedObject |= RemoveByHandleID(HandleID);
 		}
 
 		return bRemovedObject;
@@ -346,29 +573,21 @@
 	{
 		if (!ObjectToRemove)
 			return false;
-		for (auto& Bucket : ReplicationBuckets)
-		{
-			for (int i = Bucket.Value.Callbacks.Num() - 1; i >= 0; --i)
-			{
-				if (Bucket.Value.Callbacks[i].IsBoundToObject(ObjectToRemove))
-				{
-					return true;
-				}
-			}
-		}
 
-		return false;
+		return ObjectHandles.Contains(TObjectKey<UObject>(ObjectToRemove));
 	}
 
 	bool FUpdateBucketContainer::IsObjectFunctionInBucket(UObject * ObjectToRemove, FName FunctionName)
 	{
 		if (!ObjectToRemove)
 			return false;
-		for (auto& Bucket : ReplicationBuckets)
+
+		for (auto It = ObjectHandles.CreateConstKeyIterator(TObjectKey<UObject>(ObjectToRemove)); It; ++It)
 		{
-			for (int i = Bucket.Value.Callbacks.Num() - 1; i >= 0; --i)
+			int32 Index = INDEX_NONE;
+			if (FUpdateBucket* Bucket = FindHandle(It.Value(), Index))
 			{
-				if (Bucket.Value.Callbacks[i].IsBoundToObjectFunction(ObjectToRemove, FunctionName))
+				if (Bucket->Callbacks[Index].IsBoundToObjectFunction(ObjectToRemove, FunctionName))
 				{
 					return true;
 				}
@@ -383,11 +602,12 @@
 		if (!DynEvent.IsBound())
 			return false;
 
-		for (auto& Bucket : ReplicationBuckets)
+		for (auto It = ObjectHandles.CreateConstKeyIterator(TObjectKey<UObject>(DynEvent.GetUObject())); It; ++It)
 		{
-			for (int i = Bucket.Value.Callbacks.Num() - 1; i >= 0; --i)
+			int32 Index = INDEX_NONE;
+			if (FUpdateBucket* Bucket = FindHandle(It.Value(), Index))
 			{
-				if (Bucket.Value.Callbacks[i].IsBoundToObjectDelegate(DynEvent))
+				if (Bucket->Callbacks[Index].IsBoundToObjectDelegate(DynEvent))
 				{
 					return true;
 				}
@@ -395,4 +615,4 @@
 		}
 
 		return false;
-	}
\ No newline at end of file
+	}
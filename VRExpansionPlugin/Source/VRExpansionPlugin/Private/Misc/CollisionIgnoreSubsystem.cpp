@@ -18,13 +18,41 @@
 #include "Chaos/ContactModification.h"
 
 DEFINE_LOG_CATEGORY(VRE_CollisionIgnoreLog);
+DECLARE_CYCLE_STAT(TEXT("CollisionIgnore ~ ContactModification"), STAT_CollisionIgnoreContactModification, STATGROUP_CollisionIgnore);
+DECLARE_CYCLE_STAT(TEXT("CollisionIgnore ~ ConstructInput"), STAT_CollisionIgnoreConstructInput, STATGROUP_CollisionIgnore);
 
 
+void FCollisionIgnoreSubsystemAsyncCallback::ConsumePairDeltas_Internal()
+{
+	FChaosParticlePairDelta Delta;
+	while (PendingPairDeltas.Dequeue(Delta))
+	{
+		switch (Delta.DeltaType)
+		{
+		case EChaosParticlePairDeltaType::AddPair:
+		{
+			ParticlePairs_Internal.Add(Delta.Pair);
+		}break;
+		case EChaosParticlePairDeltaType::RemovePair:
+		{
+			ParticlePairs_Internal.Remove(Delta.Pair);
+		}break;
+		case EChaosParticlePairDeltaType::ClearPairs:
+		{
+			ParticlePairs_Internal.Reset();
+		}break;
+		}
+	}
+}
+
 void FCollisionIgnoreSubsystemAsyncCallback::OnContactModification_Internal(Chaos::FCollisionContactModifier& Modifier)
 {
-	const FSimCallbackInputVR* Input = GetConsumerInput_Internal();
+	SCOPE_CYCLE_COUNTER(STAT_CollisionIgnoreContactModification);
+
+	// Pick up anything queued since pre-simulate (substeps)
+	ConsumePairDeltas_Internal();
 
-	if (Input && Input->bIsInitialized)
+	if (ParticlePairs_Internal.Num())
 	{
 		for (Chaos::FContactPairModifierIterator ContactIterator = Modifier.Begin(); ContactIterator; ++ContactIterator)
 		{
@@ -55,7 +83,7 @@ void FCollisionIgnoreSubsystemAsyncCallback::OnContactModification_Internal(Chao
 					{
 						FChaosParticlePair SearchPair(ParticleHandle0, ParticleHandle1);
 
-						if (Input->ParticlePairs.Contains(SearchPair))
+						if (ParticlePairs_Internal.Contains(SearchPair))
 						{
 							ContactIterator->Disable();
 						}
@@ -68,6 +96,8 @@ void FCollisionIgnoreSubsystemAsyncCallback::OnContactModification_Internal(Chao
 
 void UCollisionIgnoreSubsystem::ConstructInput()
 {
+	SCOPE_CYCLE_COUNTER(STAT_CollisionIgnoreConstructInput);
+
 	if (ContactModifierCallback)
 	{
 		FSimCallbackInputVR* Input = ContactModifierCallback->GetProducerInputData_External();
@@ -76,22 +106,27 @@ void UCollisionIgnoreSubsystem::ConstructInput()
 			Input->bIsInitialized = true;
 		}
 
-		// Clear out the pair array
-		Input->Reset();
+		// Clear out the physics thread set and fill it back in with our current pairs
+		ContactModifierCallback->QueuePairDelta_External(FChaosParticlePair(), EChaosParticlePairDeltaType::ClearPairs);
 
 		for (TPair<FCollisionPrimPair, FCollisionIgnorePairArray>& CollisionPairArray : CollisionTrackedPairs)
 		{
 			for (FCollisionIgnorePair& IgnorePair : CollisionPairArray.Value.PairArray)
 			{
-				if (IgnorePair.Actor1 && IgnorePair.Actor2)
-				{
-					Input->ParticlePairs.Add(FChaosParticlePair(IgnorePair.Actor1->GetHandle_LowLevel()->CastToRigidParticle(), IgnorePair.Actor2->GetHandle_LowLevel()->CastToRigidParticle()));
-				}
+				QueuePairDelta(IgnorePair, EChaosParticlePairDeltaType::AddPair);
 			}
 		}
 	}
 }
 
+void UCollisionIgnoreSubsystem::QueuePairDelta(const FCollisionIgnorePair& IgnorePair, EChaosParticlePairDeltaType DeltaType)
+{
+	if (ContactModifierCallback && IgnorePair.ParticlePair.ParticleHandle0 && IgnorePair.ParticlePair.ParticleHandle1)
+	{
+		ContactModifierCallback->QueuePairDelta_External(IgnorePair.ParticlePair, DeltaType);
+	}
+}
+
 
 void UCollisionIgnoreSubsystem::UpdateTimer(bool bChangesWereMade)
 {
@@ -113,16 +148,13 @@ void UCollisionIgnoreSubsystem::UpdateTimer(bool bChangesWereMade)
 					{
 						// Register a callback
 						ContactModifierCallback = PhysScene->GetSolver()->CreateAndRegisterSimCallbackObject_External<FCollisionIgnoreSubsystemAsyncCallback>(/*true*/);
+
+						// Seed the new callback with everything we have so far, changes after this point are sent as deltas
+						ConstructInput();
 					}
 				}
 			}
 		}
-
-		// Need to only add input when changes are made
-		if (VRSettings.bUseCollisionModificationForCollisionIgnore && ContactModifierCallback && bChangesWereMade)
-		{
-			ConstructInput();
-		}
 	}
 	else if (UpdateHandle.IsValid())
 	{
@@ -288,6 +320,11 @@ void UCollisionIgnoreSubsystem::CheckActiveFilters()
 	{
 		if (CollisionTrackedPairs.Contains(KeyPair.Key))
 		{
+			for (const FCollisionIgnorePair& IgnorePair : CollisionTrackedPairs[KeyPair.Key].PairArray)
+			{
+				QueuePairDelta(IgnorePair, EChaosParticlePairDeltaType::RemovePair);
+			}
+
 			CollisionTrackedPairs[KeyPair.Key].PairArray.Empty();
 			CollisionTrackedPairs.Remove(KeyPair.Key);
 		}
@@ -393,17 +430,53 @@ bool UCollisionIgnoreSubsystem::HasCollisionIgnorePairs()
 }
 
 void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateChildren1, bool bIterateChildren2, UPrimitiveComponent* Prim1, FName OptionalBoneName1, UPrimitiveComponent* Prim2, FName OptionalBoneName2, bool bIgnoreCollision, bool bCheckFilters)
+{
+	// Check our active filters and handle inconsistencies before we run the next logic
+	// (This prevents cases where null ptrs get added too)
+	if (bCheckFilters)
+	{
+		CheckActiveFilters();
+	}
+
+	if (SetComponentCollisionIgnoreState_Impl(bIterateChildren1, bIterateChildren2, Prim1, OptionalBoneName1, Prim2, OptionalBoneName2, bIgnoreCollision))
+	{
+		// Update our timer state
+		UpdateTimer(true);
+	}
+}
+
+void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreStateBatched(const TArray<FCollisionIgnoreBatchEntry>& PrimitivePairs, bool bIgnoreCollision, bool bCheckFilters)
+{
+	if (bCheckFilters)
+	{
+		CheckActiveFilters();
+	}
+
+	bool bProcessedAny = false;
+	for (const FCollisionIgnoreBatchEntry& Entry : PrimitivePairs)
+	{
+		bProcessedAny |= SetComponentCollisionIgnoreState_Impl(Entry.bIterateChildren1, Entry.bIterateChildren2, Entry.Prim1, Entry.OptionalBoneName1, Entry.Prim2, Entry.OptionalBoneName2, bIgnoreCollision);
+	}
+
+	// Only need to update the timer once for the entire batch
+	if (bProcessedAny)
+	{
+		UpdateTimer(true);
+	}
+}
+
+bool UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState_Impl(bool bIterateChildren1, bool bIterateChildren2, UPrimitiveComponent* Prim1, FName OptionalBoneName1, UPrimitiveComponent* Prim2, FName OptionalBoneName2, bool bIgnoreCollision)
 {
 	if (!Prim1 || !Prim2)
 	{
 		UE_LOG(VRE_CollisionIgnoreLog, Error, TEXT("Set Objects Ignore Collision called with invalid object(s)!!"));
-		return;
+		return false;
 	}
 
 	if (Prim1->GetCollisionEnabled() == ECollisionEnabled::NoCollision || Prim2->GetCollisionEnabled() == ECollisionEnabled::NoCollision)
 	{
 		UE_LOG(VRE_CollisionIgnoreLog, Error, TEXT("Set Objects Ignore Collision called with one or more objects with no collision!! %s, %s"), *Prim1->GetName(), *Prim2->GetName());
-		return;
+		return false;
 	}
 
 	if (Prim1->Mobility == EComponentMobility::Static || Prim2->Mobility == EComponentMobility::Static)
@@ -411,7 +484,7 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 		UE_LOG(VRE_CollisionIgnoreLog, Error, TEXT("Set Objects Ignore Collision called with at least one static mobility object (cannot ignore collision with it)!!"));
 		if (bIgnoreCollision)
 		{
-			return;
+			return false;
 		}
 	}
 
@@ -490,13 +563,6 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 	newPrimPair.Prim1 = Prim1;
 	newPrimPair.Prim2 = Prim2;
 
-	// Check our active filters and handle inconsistencies before we run the next logic
-	// (This prevents cases where null ptrs get added too)
-	if (bCheckFilters)
-	{
-		CheckActiveFilters();
-	}
-
 	// If we don't have a map element for this pair, then add it now
 	if (bIgnoreCollision && !CollisionTrackedPairs.Contains(newPrimPair))
 	{
@@ -505,7 +571,7 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 	else if (!bIgnoreCollision && !CollisionTrackedPairs.Contains(newPrimPair))
 	{
 		// Early out, we don't even have this pair to remove it
-		return;
+		return false;
 	}
 
 	for (int i = 0; i < ApplicableBodies.Num(); ++i)
@@ -528,6 +594,11 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 					auto* pHandle1 = ApplicableBodies[i].BInstance->ActorHandle->GetHandle_LowLevel();
 					auto* pHandle2 = ApplicableBodies2[j].BInstance->ActorHandle->GetHandle_LowLevel();
 
+					if (pHandle1 && pHandle2)
+					{
+						newIgnorePair.ParticlePair = FChaosParticlePair(pHandle1->CastToRigidParticle(), pHandle2->CastToRigidParticle());
+					}
+
 					Chaos::FIgnoreCollisionManager& IgnoreCollisionManager = PhysScene->GetSolver()->GetEvolution()->GetBroadPhase().GetIgnoreCollisionManager();
 
 					FPhysicsCommand::ExecuteWrite(PhysScene, [&]()
@@ -554,6 +625,7 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 										}
 
 										CollisionTrackedPairs[newPrimPair].PairArray.AddUnique(newIgnorePair);
+										QueuePairDelta(newIgnorePair, EChaosParticlePairDeltaType::AddPair);
 									}										
 								}
 							}
@@ -564,6 +636,8 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 									IgnoreCollisionManager.RemoveIgnoreCollisions(pHandle1, pHandle2);
 
 									CollisionTrackedPairs[newPrimPair].PairArray.Remove(newIgnorePair);
+									QueuePairDelta(newIgnorePair, EChaosParticlePairDeltaType::RemovePair);
+
 									if (CollisionTrackedPairs[newPrimPair].PairArray.Num() < 1)
 									{
 										CollisionTrackedPairs.Remove(newPrimPair);
@@ -583,6 +657,5 @@ void UCollisionIgnoreSubsystem::SetComponentCollisionIgnoreState(bool bIterateCh
 		}
 	}
 
-	// Update our timer state
-	UpdateTimer(true);
+	return true;
 }
\ No newline at end of file
@@ -0,0 +1,228 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/VRClientAuthThrowBatchSubsystem.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VRClientAuthThrowBatchSubsystem)
+
+#include "VRPlayerController.h"
+#include "Grippables/GrippableActor.h"
+#include "Grippables/GrippableStaticMeshActor.h"
+#include "Grippables/GrippableSkeletalMeshActor.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Flush ClientAuth Batches"), STAT_VRFlushClientAuthBatches, STATGROUP_VRClientAuthThrowBatching);
+DECLARE_CYCLE_STAT(TEXT("Apply ClientAuth Batch"), STAT_VRApplyClientAuthBatch, STATGROUP_VRClientAuthThrowBatching);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched ClientAuth Moves"), STAT_VRBatchedClientAuthMoves, STATGROUP_VRClientAuthThrowBatching);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ClientAuth Batch RPCs"), STAT_VRClientAuthBatchRPCs, STATGROUP_VRClientAuthThrowBatching);
+
+namespace VRClientAuthThrowBatchCVars
+{
+	static int32 BatchClientAuthThrows = 0;
+	FAutoConsoleVariableRef CVarBatchClientAuthThrows(
+		TEXT("vre.BatchClientAuthThrows"),
+		BatchClientAuthThrows,
+		TEXT("When on, client auth throwing movement from all of a players thrown objects is sent in one RPC per frame on their VR player controller.\n")
+		TEXT("Objects not owned by an AVRBasePlayerController still send their own RPC.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+
+	static int32 MaxMovesPerRPC = 32;
+	FAutoConsoleVariableRef CVarMaxMovesPerRPC(
+		TEXT("vre.BatchClientAuthThrows.MaxPerRPC"),
+		MaxMovesPerRPC,
+		TEXT("Maximum number of object movements packed into a single batched RPC, larger batches are split across multiple RPCs."),
+		ECVF_Default);
+}
+
+bool UVRClientAuthThrowBatchSubsystem::IsBatchingClientAuthThrows()
+{
+	return VRClientAuthThrowBatchCVars::BatchClientAuthThrows > 0;
+}
+
+void UVRClientAuthThrowBatchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Post actor tick runs after the bucket updates have polled and before the net driver flushes
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UVRClientAuthThrowBatchSubsystem::FlushBatches);
+}
+
+void UVRClientAuthThrowBatchSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PostActorTickHandle.Reset();
+	PlayerBatches.Empty();
+	SendScratch.Empty();
+	bHasQueuedMovement = false;
+
+	Super::Deinitialize();
+}
+
+AVRBasePlayerController* UVRClientAuthThrowBatchSubsystem::GetBatchingController(AActor* MovedActor)
+{
+	AActor* TopOwner = MovedActor ? MovedActor->GetOwner() : nullptr;
+	if (!TopOwner)
+	{
+		return nullptr;
+	}
+
+	while (AActor* NextOwner = TopOwner->GetOwner())
+	{
+		TopOwner = NextOwner;
+	}
+
+	AVRBasePlayerController* OwningController = Cast<AVRBasePlayerController>(TopOwner);
+	if (!OwningController || !OwningController->IsLocalController())
+	{
+		return nullptr;
+	}
+
+	return OwningController;
+}
+
+bool UVRClientAuthThrowBatchSubsystem::QueueClientAuthMovement(AVRBasePlayerController* OwningController, AActor* MovedActor, const FRepMovementVR& Movement)
+{
+	if (!IsBatchingClientAuthThrows() || !OwningController || !MovedActor)
+	{
+		return false;
+	}
+
+	UWorld* World = OwningController->GetWorld();
+	UVRClientAuthThrowBatchSubsystem* Subsystem = World ? World->GetSubsystem<UVRClientAuthThrowBatchSubsystem>() : nullptr;
+	if (!Subsystem)
+	{
+		return false;
+	}
+
+	FPlayerBatch* PlayerBatch = Subsystem->PlayerBatches.FindByPredicate([OwningController](const FPlayerBatch& Batch)
+	{
+		return Batch.OwningController.Get() == OwningController;
+	});
+
+	if (!PlayerBatch)
+	{
+		PlayerBatch = &Subsystem->PlayerBatches.AddDefaulted_GetRef();
+		PlayerBatch->OwningController = OwningController;
+	}
+
+	PlayerBatch->Entries.Emplace(MovedActor, Movement);
+	Subsystem->bHasQueuedMovement = true;
+	return true;
+}
+
+bool UVRClientAuthThrowBatchSubsystem::TakeQueuedClientAuthMovement(AActor* MovedActor, FRepMovementVR& OutMovement)
+{
+	UWorld* World = MovedActor ? MovedActor->GetWorld() : nullptr;
+	UVRClientAuthThrowBatchSubsystem* Subsystem = World ? World->GetSubsystem<UVRClientAuthThrowBatchSubsystem>() : nullptr;
+	if (!Subsystem || !Subsystem->bHasQueuedMovement)
+	{
+		return false;
+	}
+
+	for (FPlayerBatch& PlayerBatch : Subsystem->PlayerBatches)
+	{
+		const int32 EntryIndex = PlayerBatch.Entries.IndexOfByPredicate([MovedActor](const FVRClientAuthMovementBatchEntry& Entry)
+		{
+			return Entry.MovedActor == MovedActor;
+		});
+
+		if (EntryIndex != INDEX_NONE)
+		{
+			OutMovement = PlayerBatch.Entries[EntryIndex].Movement;
+			PlayerBatch.Entries.RemoveAtSwap(EntryIndex, 1, false);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UVRClientAuthThrowBatchSubsystem::FlushBatches(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds)
+{
+	if (!bHasQueuedMovement || TickedWorld != GetWorld())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_VRFlushClientAuthBatches);
+
+	const int32 MaxPerRPC = FMath::Max(VRClientAuthThrowBatchCVars::MaxMovesPerRPC, 1);
+
+	for (int32 BatchIndex = PlayerBatches.Num() - 1; BatchIndex >= 0; --BatchIndex)
+	{
+		FPlayerBatch& PlayerBatch = PlayerBatches[BatchIndex];
+		AVRBasePlayerController* OwningController = PlayerBatch.OwningController.Get();
+
+		if (!OwningController)
+		{
+			// Player went away, its objects are no longer client authed by it
+			PlayerBatches.RemoveAtSwap(BatchIndex, 1, false);
+			continue;
+		}
+
+		const int32 NumEntries = PlayerBatch.Entries.Num();
+		if (NumEntries <= 0)
+		{
+			continue;
+		}
+
+		INC_DWORD_STAT_BY(STAT_VRBatchedClientAuthMoves, NumEntries);
+
+		if (NumEntries <= MaxPerRPC)
+		{
+			INC_DWORD_STAT(STAT_VRClientAuthBatchRPCs);
+			OwningController->Server_GetClientAuthReplicationBatch(PlayerBatch.Entries);
+		}
+		else
+		{
+			for (int32 StartIndex = 0; StartIndex < NumEntries; StartIndex += MaxPerRPC)
+			{
+				SendScratch.Reset();
+				SendScratch.Append(PlayerBatch.Entries.GetData() + StartIndex, FMath::Min(MaxPerRPC, NumEntries - StartIndex));
+
+				INC_DWORD_STAT(STAT_VRClientAuthBatchRPCs);
+				OwningController->Server_GetClientAuthReplicationBatch(SendScratch);
+			}
+		}
+
+		PlayerBatch.Entries.Reset();
+	}
+
+	bHasQueuedMovement = false;
+}
+
+void UVRClientAuthThrowBatchSubsystem::ApplyClientAuthMovementBatch(AVRBasePlayerController* SendingController, const TArray<FVRClientAuthMovementBatchEntry>& MovementBatch)
+{
+	if (!SendingController)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_VRApplyClientAuthBatch);
+
+	UNetConnection* SendingConnection = SendingController->GetNetConnection();
+
+	for (const FVRClientAuthMovementBatchEntry& BatchEntry : MovementBatch)
+	{
+		AActor* MovedActor = BatchEntry.MovedActor;
+
+		// Same rule the engine applies to the per actor RPC, only objects owned by the sending connection
+		if (!IsValid(MovedActor) || MovedActor->GetNetConnection() != SendingConnection)
+		{
+			continue;
+		}
+
+		if (AGrippableStaticMeshActor* StaticMeshActor = Cast<AGrippableStaticMeshActor>(MovedActor))
+		{
+			StaticMeshActor->Server_GetClientAuthReplication_Implementation(BatchEntry.Movement);
+		}
+		else if (AGrippableSkeletalMeshActor* SkeletalMeshActor = Cast<AGrippableSkeletalMeshActor>(MovedActor))
+		{
+			SkeletalMeshActor->Server_GetClientAuthReplication_Implementation(BatchEntry.Movement);
+		}
+		else if (AGrippableActor* GrippableActor = Cast<AGrippableActor>(MovedActor))
+		{
+			GrippableActor->Server_GetClientAuthReplication_Implementation(BatchEntry.Movement);
+		}
+	}
+}
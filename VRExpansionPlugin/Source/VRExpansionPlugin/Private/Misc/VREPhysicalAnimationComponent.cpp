@@ -15,6 +15,8 @@ UVREPhysicalAnimationComponent::UVREPhysicalAnimationComponent(const FObjectInit
 {
 	bAutoSetPhysicsSleepSensitivity = true;
 	SleepThresholdMultiplier = 0.0f;
+	bBatchWeldedBoneDriverUpdates = false;
+	bWeldedBoneDriverDirty = false;
 }
 
 /*void UVREPhysicalAnimationComponent::CustomPhysics(float DeltaTime, FBodyInstance* BodyInstance)
@@ -51,7 +53,7 @@ void UVREPhysicalAnimationComponent::SetupWeldedBoneDriver(TArray<FName> BaseBon
 	SetupWeldedBoneDriver_Implementation(false);
 }
 
-FTransform UVREPhysicalAnimationComponent::GetWorldSpaceRefBoneTransform(FReferenceSkeleton& RefSkel, int32 BoneIndex, int32 ParentBoneIndex)
+FTransform UVREPhysicalAnimationComponent::GetWorldSpaceRefBoneTransform(const FReferenceSkeleton& RefSkel, int32 BoneIndex, int32 ParentBoneIndex)
 {
 	FTransform BoneTransform;
 
@@ -59,7 +61,7 @@ FTransform UVREPhysicalAnimationComponent::GetWorldSpaceRefBoneTransform(FRefere
 	{
 		BoneTransform = RefSkel.GetRefBonePose()[BoneIndex];
 
-		FMeshBoneInfo BoneInfo = RefSkel.GetRefBoneInfo()[BoneIndex];
+		const FMeshBoneInfo& BoneInfo = RefSkel.GetRefBoneInfo()[BoneIndex];
 		if (BoneInfo.ParentIndex != 0 && BoneInfo.ParentIndex != ParentBoneIndex)
 		{
 			BoneTransform *= GetWorldSpaceRefBoneTransform(RefSkel, BoneInfo.ParentIndex, ParentBoneIndex);
@@ -77,8 +79,7 @@ FTransform UVREPhysicalAnimationComponent::GetRefPoseBoneRelativeTransform(USkel
 	if (SkeleMesh && !BoneName.IsNone() && !ParentBoneName.IsNone())
 	{
 		//SkelMesh->ClearRefPoseOverride();
-		FReferenceSkeleton RefSkel;
-		RefSkel = SkeleMesh->GetSkinnedAsset()->GetRefSkeleton();
+		const FReferenceSkeleton& RefSkel = SkeleMesh->GetSkinnedAsset()->GetRefSkeleton();
 
 		BoneTransform = GetWorldSpaceRefBoneTransform(RefSkel, RefSkel.FindBoneIndex(BoneName), RefSkel.FindBoneIndex(ParentBoneName));
 	}
@@ -95,8 +96,11 @@ void UVREPhysicalAnimationComponent::SetupWeldedBoneDriver_Implementation(bool b
 	}
 
 	BoneDriverMap.Empty();
+	WeldedBoneDriverBodies.Empty();
+	bWeldedBoneDriverDirty = false;
 
 	USkeletalMeshComponent* SkeleMesh = GetSkeletalMesh();
+	BindWeldedBoneDriverPhysicsCreated(SkeleMesh);
 
 	if (!SkeleMesh || !SkeleMesh->Bodies.Num())
 		return;
@@ -107,6 +111,7 @@ void UVREPhysicalAnimationComponent::SetupWeldedBoneDriver_Implementation(bool b
 	UPhysicsAsset* PhysAsset = SkeleMesh ? SkeleMesh->GetPhysicsAsset() : nullptr;
 	if (PhysAsset && SkeleMesh->GetSkinnedAsset())
 	{
+		const FReferenceSkeleton& RefSkel = SkeleMesh->GetSkinnedAsset()->GetRefSkeleton();
 
 		for (FName BaseWeldedBoneDriverName : BaseWeldedBoneDriverNames)
 		{
@@ -119,14 +124,23 @@ void UVREPhysicalAnimationComponent::SetupWeldedBoneDriver_Implementation(bool b
 
 				if (FPhysicsInterface::IsValid(ActorHandle) /*&& FPhysicsInterface::IsRigidBody(ActorHandle)*/)
 				{
+					const int32 ParentBoneIdx = RefSkel.FindBoneIndex(BaseWeldedBoneDriverName);
+
+					FWeldedBoneDriverBody DriverBody;
+					DriverBody.BodyIndex = ParentBodyIdx;
+					DriverBody.FirstDriver = BoneDriverMap.Num();
+					DriverBody.ActorHandle = ActorHandle;
+
 					FPhysicsCommand::ExecuteWrite(ActorHandle, [&](FPhysicsActorHandle& Actor)
 					{
 						//TArray<FPhysicsShapeHandle> Shapes;
 						PhysicsInterfaceTypes::FInlineShapeArray Shapes;
 						FPhysicsInterface::GetAllShapes_AssumedLocked(Actor, Shapes);
 
-						for (FPhysicsShapeHandle& Shape : Shapes)
+						for (int32 ShapeIdx = 0; ShapeIdx < Shapes.Num(); ++ShapeIdx)
 						{
+							FPhysicsShapeHandle& Shape = Shapes[ShapeIdx];
+
 							if (ParentBody->WeldParent)
 							{
 								const FBodyInstance* OriginalBI = ParentBody->WeldParent->GetOriginalBodyInstance(Shape);
@@ -138,7 +152,8 @@ void UVREPhysicalAnimationComponent::SetupWeldedBoneDriver_Implementation(bool b
 								}
 							}
 
-							FKShapeElem* ShapeElem = FChaosUserData::Get<FKShapeElem>(FPhysicsInterface::GetUserData(Shape));
+							void* ShapeUserData = FPhysicsInterface::GetUserData(Shape);
+							FKShapeElem* ShapeElem = FChaosUserData::Get<FKShapeElem>(ShapeUserData);
 							if (ShapeElem)
 							{
 								FName TargetBoneName = ShapeElem->GetName();
@@ -148,17 +163,21 @@ void UVREPhysicalAnimationComponent::SetupWeldedBoneDriver_Implementation(bool b
 								{
 									FWeldedBoneDriverData DriverData;
 									DriverData.BoneName = TargetBoneName;
+									DriverData.BoneIndex = BoneIdx;
+									DriverData.ShapeIndex = ShapeIdx;
+									DriverData.ShapeUserData = ShapeUserData;
 									//DriverData.ShapeHandle = Shape;
 
-									if (bReInit && OriginalData.Num() - 1 >= BoneDriverMap.Num())
+									// Matched by name, the shape order can change when the shapes are rebuilt or rewelded
+									const FWeldedBoneDriverData* OriginalDriverData = bReInit ? OriginalData.FindByKey(TargetBoneName) : nullptr;
+
+									if (OriginalDriverData)
 									{
-										DriverData.RelativeTransform = OriginalData[BoneDriverMap.Num()].RelativeTransform;
+										DriverData.RelativeTransform = OriginalDriverData->RelativeTransform;
 									}
 									else
 									{
-										FTransform BoneTransform = FTransform::Identity;
-										if (SkeleMesh->GetBoneIndex(TargetBoneName) != INDEX_NONE)
-											BoneTransform = GetRefPoseBoneRelativeTransform(SkeleMesh, TargetBoneName, BaseWeldedBoneDriverName).Inverse();
+										FTransform BoneTransform = GetWorldSpaceRefBoneTransform(RefSkel, BoneIdx, ParentBoneIdx).Inverse();
 
 										//FTransform BoneTransform = SkeleMesh->GetSocketTransform(TargetBoneName, ERelativeTransformSpace::RTS_World);
 
@@ -184,12 +203,57 @@ void UVREPhysicalAnimationComponent::SetupWeldedBoneDriver_Implementation(bool b
 							FPhysicsInterface::SetSleepEnergyThreshold_AssumesLocked(Actor, SleepEnergyThresh);
 						}
 					});
+
+					DriverBody.NumDrivers = BoneDriverMap.Num() - DriverBody.FirstDriver;
+					if (DriverBody.NumDrivers > 0)
+					{
+						WeldedBoneDriverBodies.Add(DriverBody);
+					}
 				}
 			}
 		}
 	}
 }
 
+void UVREPhysicalAnimationComponent::BindWeldedBoneDriverPhysicsCreated(USkeletalMeshComponent* SkeleMesh)
+{
+	if (PhysicsCreatedMesh.Get() == SkeleMesh)
+		return;
+
+	if (USkeletalMeshComponent* OldMesh = PhysicsCreatedMesh.Get())
+	{
+		OldMesh->OnSkelMeshPhysicsCreated.Remove(PhysicsCreatedHandle);
+	}
+
+	PhysicsCreatedHandle.Reset();
+	PhysicsCreatedMesh = SkeleMesh;
+
+	if (SkeleMesh)
+	{
+		PhysicsCreatedHandle = SkeleMesh->OnSkelMeshPhysicsCreated.AddUObject(this, &UVREPhysicalAnimationComponent::OnWeldedBoneDriverPhysicsCreated);
+	}
+}
+
+void UVREPhysicalAnimationComponent::OnWeldedBoneDriverPhysicsCreated()
+{
+	// New bodies and shapes, the baked table is from the old ones
+	if (BoneDriverMap.Num())
+	{
+		bWeldedBoneDriverDirty = true;
+	}
+}
+
+void UVREPhysicalAnimationComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// The map is serialized but the baked table isn't, rebuild it once the physics state is available
+	if (BoneDriverMap.Num() && !WeldedBoneDriverBodies.Num())
+	{
+		bWeldedBoneDriverDirty = true;
+	}
+}
+
 void UVREPhysicalAnimationComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
 	// Make sure base physical animation component runs its logic
@@ -197,91 +261,145 @@ void UVREPhysicalAnimationComponent::TickComponent(float DeltaTime, enum ELevelT
 	UpdateWeldedBoneDriver(DeltaTime);
 }
 
-void UVREPhysicalAnimationComponent::UpdateWeldedBoneDriver(float DeltaTime)
+FPhysicsActorHandle* UVREPhysicalAnimationComponent::GetWeldedBoneDriverActor(USkeletalMeshComponent* SkeleMesh, const FWeldedBoneDriverBody& DriverBody)
 {
+	FBodyInstance* ParentBody = SkeleMesh->Bodies.IsValidIndex(DriverBody.BodyIndex) ? SkeleMesh->Bodies[DriverBody.BodyIndex] : nullptr;
 
-	if (!BoneDriverMap.Num())
-		return;
+	// No physics state right now (being recreated, simulation toggled), skip it until it comes back
+	if (!ParentBody)
+		return nullptr;
 
-	USkeletalMeshComponent* SkeleMesh = GetSkeletalMesh();
+	FPhysicsActorHandle& ActorHandle = ParentBody->WeldParent ? ParentBody->WeldParent->GetPhysicsActorHandle() : ParentBody->GetPhysicsActorHandle();
 
-	if (!SkeleMesh || !SkeleMesh->Bodies.Num())// || (!SkeleMesh->IsSimulatingPhysics(BaseWeldedBoneDriverNames) && !SkeleMesh->IsWelded()))
-		return;
+	if (!FPhysicsInterface::IsValid(ActorHandle))
+		return nullptr;
 
-	UPhysicsAsset* PhysAsset = SkeleMesh ? SkeleMesh->GetPhysicsAsset() : nullptr;
-	if(PhysAsset && SkeleMesh->GetSkinnedAsset())
+	if (ActorHandle != DriverBody.ActorHandle)
 	{
-		for (FName BaseWeldedBoneDriverName : BaseWeldedBoneDriverNames)
-		{
-			int32 ParentBodyIdx = PhysAsset->FindBodyIndex(BaseWeldedBoneDriverName);
+		// Welded to something else or the body was recreated since the table was baked
+		bWeldedBoneDriverDirty = true;
+		return nullptr;
+	}
 
-			if (FBodyInstance* ParentBody = (ParentBodyIdx == INDEX_NONE ? nullptr : SkeleMesh->Bodies[ParentBodyIdx]))
-			{
-				// Allow it to run even when not simulating physics, if we have a welded root then it needs to animate anyway
-				//if (!ParentBody->IsInstanceSimulatingPhysics() && !ParentBody->WeldParent)
-				//	return;
+	return &ActorHandle;
+}
 
-				FPhysicsActorHandle& ActorHandle = ParentBody->WeldParent ? ParentBody->WeldParent->GetPhysicsActorHandle() : ParentBody->GetPhysicsActorHandle();
+bool UVREPhysicalAnimationComponent::CanRebakeWeldedBoneDriver(USkeletalMeshComponent* SkeleMesh) const
+{
+	UPhysicsAsset* PhysAsset = SkeleMesh->GetPhysicsAsset();
 
-				if (FPhysicsInterface::IsValid(ActorHandle) /*&& FPhysicsInterface::IsRigidBody(ActorHandle)*/)
-				{
+	if (!PhysAsset)
+		return false;
 
-					bool bModifiedBody = false;
-					FPhysicsCommand::ExecuteWrite(ActorHandle, [&](FPhysicsActorHandle& Actor)
-					{
-						PhysicsInterfaceTypes::FInlineShapeArray Shapes;
-						FPhysicsInterface::GetAllShapes_AssumedLocked(Actor, Shapes);
+	bool bHasBody = false;
+	for (FName BaseWeldedBoneDriverName : BaseWeldedBoneDriverNames)
+	{
+		const int32 ParentBodyIdx = PhysAsset->FindBodyIndex(BaseWeldedBoneDriverName);
+		FBodyInstance* ParentBody = SkeleMesh->Bodies.IsValidIndex(ParentBodyIdx) ? SkeleMesh->Bodies[ParentBodyIdx] : nullptr;
 
-						FTransform GlobalPose = FPhysicsInterface::GetGlobalPose_AssumesLocked(ActorHandle).Inverse();
-						
-						for (FPhysicsShapeHandle& Shape : Shapes)
-						{
+		// Setup skips names without a body, so they can't hold up a rebake either
+		if (!ParentBody)
+			continue;
 
-							if (ParentBody->WeldParent)
-							{
-								const FBodyInstance* OriginalBI = ParentBody->WeldParent->GetOriginalBodyInstance(Shape);
+		FPhysicsActorHandle& ActorHandle = ParentBody->WeldParent ? ParentBody->WeldParent->GetPhysicsActorHandle() : ParentBody->GetPhysicsActorHandle();
 
-								if (OriginalBI != ParentBody)
-								{
-									// Not originally our shape
-									continue;
-								}
-							}
+		if (!FPhysicsInterface::IsValid(ActorHandle))
+			return false;
 
-							// Log the shapes name to match to the bone
-							FName TargetBoneName = NAME_None;
-							if (FKShapeElem* ShapeElem = FChaosUserData::Get<FKShapeElem>(FPhysicsInterface::GetUserData(Shape)))
-							{
-								TargetBoneName = ShapeElem->GetName();
-							}
-							else
-							{
-								// Cant find the matching shape
-								continue;
-							}
+		bHasBody = true;
+	}
 
-							if (FWeldedBoneDriverData* WeldedData = BoneDriverMap.FindByKey(TargetBoneName/*Shape*/))
-							{
-								bModifiedBody = true;
+	return bHasBody;
+}
 
-								FTransform Trans = SkeleMesh->GetSocketTransform(WeldedData->BoneName, ERelativeTransformSpace::RTS_World);
+void UVREPhysicalAnimationComponent::UpdateWeldedBoneDriverBody(USkeletalMeshComponent* SkeleMesh, const FWeldedBoneDriverBody& DriverBody, FPhysicsActorHandle& Actor)
+{
+	PhysicsInterfaceTypes::FInlineShapeArray Shapes;
+	FPhysicsInterface::GetAllShapes_AssumedLocked(Actor, Shapes);
 
-								// This fixes a bug with simulating inverse scaled meshes
-								//Trans.SetScale3D(FVector(1.f) * Trans.GetScale3D().GetSignVector());
-								FTransform GlobalTransform = WeldedData->RelativeTransform * Trans;
-								FTransform RelativeTM = GlobalTransform * GlobalPose;
+	FTransform GlobalPose = FPhysicsInterface::GetGlobalPose_AssumesLocked(Actor).Inverse();
 
-								if (!WeldedData->LastLocal.Equals(RelativeTM))
-								{
-									FPhysicsInterface::SetLocalTransform(Shape, RelativeTM);
-									WeldedData->LastLocal = RelativeTM;
-								}
-							}
-						}
-					});
-				}
+	for (int32 DriverIdx = DriverBody.FirstDriver; DriverIdx < DriverBody.FirstDriver + DriverBody.NumDrivers; ++DriverIdx)
+	{
+		FWeldedBoneDriverData& WeldedData = BoneDriverMap[DriverIdx];
+
+		if (!Shapes.IsValidIndex(WeldedData.ShapeIndex) || FPhysicsInterface::GetUserData(Shapes[WeldedData.ShapeIndex]) != WeldedData.ShapeUserData)
+		{
+			// The shapes were rebuilt since the table was baked
+			bWeldedBoneDriverDirty = true;
+			continue;
+		}
+
+		FTransform Trans = SkeleMesh->GetBoneTransform(WeldedData.BoneIndex);
 
+		// This fixes a bug with simulating inverse scaled meshes
+		//Trans.SetScale3D(FVector(1.f) * Trans.GetScale3D().GetSignVector());
+		FTransform GlobalTransform = WeldedData.RelativeTransform * Trans;
+		FTransform RelativeTM = GlobalTransform * GlobalPose;
+
+		if (!WeldedData.LastLocal.Equals(RelativeTM))
+		{
+			FPhysicsInterface::SetLocalTransform(Shapes[WeldedData.ShapeIndex], RelativeTM);
+			WeldedData.LastLocal = RelativeTM;
+		}
+	}
+}
+
+void UVREPhysicalAnimationComponent::UpdateWeldedBoneDriver(float DeltaTime)
+{
+
+	if (!BoneDriverMap.Num())
+		return;
+
+	USkeletalMeshComponent* SkeleMesh = GetSkeletalMesh();
+
+	if (!SkeleMesh || !SkeleMesh->Bodies.Num() || !SkeleMesh->GetSkinnedAsset())// || (!SkeleMesh->IsSimulatingPhysics(BaseWeldedBoneDriverNames) && !SkeleMesh->IsWelded()))
+		return;
+
+	// Re-bake only after something changed (reweld, shapes rebuilt, physics state recreated, copied without its table)
+	// Waits for the physics state to be valid again, a bake without it would find no drivers and lose the old table
+	if (bWeldedBoneDriverDirty && CanRebakeWeldedBoneDriver(SkeleMesh))
+	{
+		TArray<FWeldedBoneDriverData> OldBoneDriverMap = BoneDriverMap;
+
+		SetupWeldedBoneDriver_Implementation(true);
+
+		if (!BoneDriverMap.Num())
+		{
+			// Nothing to drive in the new state, keep the old entries for their relative transforms but drop the stale bodies
+			// The next physics state or weld change marks it dirty again
+			BoneDriverMap = MoveTemp(OldBoneDriverMap);
+			WeldedBoneDriverBodies.Reset();
+			bWeldedBoneDriverDirty = false;
+			return;
+		}
+	}
+
+	// Allow it to run even when not simulating physics, if we have a welded root then it needs to animate anyway
+	if (bBatchWeldedBoneDriverUpdates)
+	{
+		FPhysicsCommand::ExecuteWrite(SkeleMesh, [&]()
+		{
+			for (const FWeldedBoneDriverBody& DriverBody : WeldedBoneDriverBodies)
+			{
+				if (FPhysicsActorHandle* ActorHandle = GetWeldedBoneDriverActor(SkeleMesh, DriverBody))
+				{
+					UpdateWeldedBoneDriverBody(SkeleMesh, DriverBody, *ActorHandle);
+				}
+			}
+		});
+	}
+	else
+	{
+		for (const FWeldedBoneDriverBody& DriverBody : WeldedBoneDriverBodies)
+		{
+			if (FPhysicsActorHandle* ActorHandle = GetWeldedBoneDriverActor(SkeleMesh, DriverBody))
+			{
+				FPhysicsCommand::ExecuteWrite(*ActorHandle, [&](FPhysicsActorHandle& Actor)
+				{
+					UpdateWeldedBoneDriverBody(SkeleMesh, DriverBody, Actor);
+				});
 			}
 		}
 	}
-}
\ No newline at end of file
+}
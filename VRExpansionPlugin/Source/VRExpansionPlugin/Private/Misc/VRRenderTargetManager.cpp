@@ -17,6 +17,20 @@
 #include "Materials/Material.h"
 #include "Net/UnrealNetwork.h"
 
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager ~ Readback"), STAT_RenderTargetReadback, STATGROUP_VRRenderTargetManager);
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager ~ Convert To RGB565"), STAT_RenderTargetConvert, STATGROUP_VRRenderTargetManager);
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager ~ Extract Tiles"), STAT_RenderTargetExtractTiles, STATGROUP_VRRenderTargetManager);
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager ~ RLE Encode"), STAT_RenderTargetRLE, STATGROUP_VRRenderTargetManager);
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager ~ Compress"), STAT_RenderTargetCompress, STATGROUP_VRRenderTargetManager);
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager ~ Start Encode"), STAT_RenderTargetStartEncode, STATGROUP_VRRenderTargetManager);
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager ~ Dispatch Stores"), STAT_RenderTargetDispatch, STATGROUP_VRRenderTargetManager);
+DECLARE_DWORD_COUNTER_STAT(TEXT("RenderTargetManager ~ Encoded Bytes"), STAT_RenderTargetEncodedBytes, STATGROUP_VRRenderTargetManager);
+DECLARE_CYCLE_STAT(TEXT("RenderTargetManager ~ Send Scheduler"), STAT_RenderTargetSendScheduler, STATGROUP_VRRenderTargetManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RenderTargetManager ~ Active Transfers"), STAT_RenderTargetActiveTransfers, STATGROUP_VRRenderTargetManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RenderTargetManager ~ Queued Bytes"), STAT_RenderTargetQueuedBytes, STATGROUP_VRRenderTargetManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RenderTargetManager ~ Blobs In Flight"), STAT_RenderTargetBlobsInFlight, STATGROUP_VRRenderTargetManager);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("RenderTargetManager ~ Scheduled Bytes"), STAT_RenderTargetScheduledBytes, STATGROUP_VRRenderTargetManager);
+
 namespace RLE_Funcs
 {
 	enum RLE_Flags
@@ -71,9 +85,21 @@ UVRRenderTargetManager::UVRRenderTargetManager(const FObjectInitializer& ObjectI
 	TextureBlobSize = 512;
 	MaxBytesPerSecondRate = 5000;
 
+	bUseGlobalSendScheduler = false;
+	MaxTotalBytesPerSecondRate = 20000;
+	MaxUnackedBlobs = 8;
+	SendSchedulerRate = 0.05f;
+	LastSendScheduleTime = 0.0;
+	SendBudgetCarry = 0.f;
+
 	bInitiallyReplicateTexture = false;
 	bIsLoadingTextureBuffer = false;
 
+	bUseDeltaTextureReplication = true;
+	DeltaTileSize = 64;
+	TextureVersion = 0;
+	TileCount = FIntPoint::ZeroValue;
+
 	OwnerIDCounter = 0;
 }
 
@@ -304,9 +330,27 @@ void UVRRenderTargetManager::DrawOperations()
 
 	if (CanvasToUse)
 	{
+		if (RenderOperationStore.Num())
+		{
+			++TextureVersion;
+		}
+
+		FBox2D OperationBounds;
 		for (const FRenderManagerOperation& opt : RenderOperationStore)
 		{
 			DrawOperation(CanvasToUse, opt);
+
+			if (TileVersions.Num())
+			{
+				if (GetOperationBounds(opt, OperationBounds))
+				{
+					MarkDirtyRegion(OperationBounds);
+				}
+				else
+				{
+					MarkDirtyRegion(FBox2D(FVector2D::ZeroVector, FVector2D(TileCount * DeltaTileSize)));
+				}
+			}
 		}
 
 		RenderOperationStore.Empty();
@@ -319,6 +363,234 @@ void UVRRenderTargetManager::DrawOperations()
 	}
 }
 
+bool UVRRenderTargetManager::GetOperationBounds(const FRenderManagerOperation& Operation, FBox2D& OutBounds) const
+{
+	switch (Operation.OperationType)
+	{
+	case ERenderManagerOperationType::Op_LineDraw:
+	{
+		// Pad by the line thickness and a pixel for anti aliasing
+		const float Padding = (Operation.Thickness * 0.5f) + 1.f;
+		OutBounds = FBox2D(FVector2D::Min(Operation.P1, Operation.P2) - Padding, FVector2D::Max(Operation.P1, Operation.P2) + Padding);
+		return true;
+	}break;
+	case ERenderManagerOperationType::Op_TexDraw:
+	{
+		if (UTexture2D* Texture = Operation.Texture.Get())
+		{
+			OutBounds = FBox2D(Operation.P1, Operation.P1 + FVector2D(Texture->GetSizeX(), Texture->GetSizeY()));
+			return true;
+		}
+	}break;
+	case ERenderManagerOperationType::Op_TriDraw:
+	{
+		if (Operation.Tris.Num())
+		{
+			OutBounds.Init();
+			for (const FRenderManagerTri& Tri : Operation.Tris)
+			{
+				OutBounds += Tri.P1;
+				OutBounds += Tri.P2;
+				OutBounds += Tri.P3;
+			}
+
+			OutBounds = OutBounds.ExpandBy(1.f);
+			return true;
+		}
+	}break;
+	}
+
+	return false;
+}
+
+void UVRRenderTargetManager::MarkDirtyRegion(const FBox2D& Region)
+{
+	if (!TileVersions.Num() || DeltaTileSize <= 0)
+		return;
+
+	const int32 MinX = FMath::Clamp(FMath::FloorToInt(Region.Min.X) / DeltaTileSize, 0, TileCount.X - 1);
+	const int32 MinY = FMath::Clamp(FMath::FloorToInt(Region.Min.Y) / DeltaTileSize, 0, TileCount.Y - 1);
+	const int32 MaxX = FMath::Clamp(FMath::CeilToInt(Region.Max.X) / DeltaTileSize, 0, TileCount.X - 1);
+	const int32 MaxY = FMath::Clamp(FMath::CeilToInt(Region.Max.Y) / DeltaTileSize, 0, TileCount.Y - 1);
+
+	for (int32 y = MinY; y <= MaxY; ++y)
+	{
+		uint32* Row = TileVersions.GetData() + (y * TileCount.X);
+		for (int32 x = MinX; x <= MaxX; ++x)
+		{
+			Row[x] = TextureVersion;
+		}
+	}
+}
+
+void UVRRenderTargetManager::MarkRenderTargetRegionDirty(FVector2D RegionMin, FVector2D RegionMax)
+{
+	++TextureVersion;
+	MarkDirtyRegion(FBox2D(FVector2D::Min(RegionMin, RegionMax), FVector2D::Max(RegionMin, RegionMax)));
+}
+
+bool UVRRenderTargetManager::GatherDirtyTiles(uint32 BaseVersion, const FIntPoint& TextureSize, TArray<int32>& OutTiles) const
+{
+	OutTiles.Reset();
+
+	if (!TileVersions.Num() || DeltaTileSize <= 0 || FIntPoint(FMath::DivideAndRoundUp(TextureSize.X, DeltaTileSize), FMath::DivideAndRoundUp(TextureSize.Y, DeltaTileSize)) != TileCount)
+		return false;
+
+	for (int32 i = 0; i < TileVersions.Num(); ++i)
+	{
+		if (TileVersions[i] > BaseVersion)
+		{
+			OutTiles.Add(i);
+		}
+	}
+
+	// Past this the tile header and lost run lengths across tile edges make a full send cheaper
+	const float MaxDeltaFraction = 0.75f;
+	return OutTiles.Num() <= TileVersions.Num() * MaxDeltaFraction;
+}
+
+void UVRRenderTargetManager::OnClientTextureAcked(ARenderTargetReplicationProxy* Proxy, uint32 AckedVersion)
+{
+	for (FClientRepData& RepData : NetRelevancyLog)
+	{
+		if (RepData.ReplicationProxy == Proxy)
+		{
+			RepData.AckedTextureVersion = AckedVersion;
+			RepData.bAwaitingTextureAck = false;
+			break;
+		}
+	}
+}
+
+void UVRRenderTargetManager::OnClientManagerReset(ARenderTargetReplicationProxy* Proxy)
+{
+	for (FClientRepData& RepData : NetRelevancyLog)
+	{
+		if (RepData.ReplicationProxy == Proxy)
+		{
+			RepData.AckedTextureVersion = 0;
+			RepData.bAwaitingTextureAck = false;
+
+			if (RepData.bIsRelevant)
+			{
+				RepData.bIsDirty = true;
+				QueueImageStore();
+			}
+			break;
+		}
+	}
+}
+
+float UVRRenderTargetManager::GetClientSendPriority_Implementation(APlayerController* PC, int32 RemainingBytes)
+{
+	return 1.f;
+}
+
+void UVRRenderTargetManager::StartSendScheduler()
+{
+	if (!SendScheduler_Handle.IsValid())
+	{
+		LastSendScheduleTime = FPlatformTime::Seconds();
+		SendBudgetCarry = 0.f;
+		GetWorld()->GetTimerManager().SetTimer(SendScheduler_Handle, this, &UVRRenderTargetManager::RunSendScheduler, FMath::Max(SendSchedulerRate, 0.01f), true);
+	}
+}
+
+void UVRRenderTargetManager::RunSendScheduler()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RenderTargetSendScheduler);
+
+	struct FActiveTransfer
+	{
+		ARenderTargetReplicationProxy* Proxy;
+		float Weight;
+	};
+
+	TArray<FActiveTransfer, TInlineAllocator<16>> ActiveTransfers;
+	float TotalWeight = 0.f;
+	int32 QueuedBytes = 0;
+
+	for (FClientRepData& RepData : NetRelevancyLog)
+	{
+		ARenderTargetReplicationProxy* Proxy = RepData.ReplicationProxy;
+		if (!IsValid(Proxy) || !Proxy->bStreamingBlobs)
+			continue;
+
+		if (!Proxy->SendStore.IsValid() || !IsValid(Proxy->GetOwner()))
+		{
+			Proxy->FinishTextureSend();
+			continue;
+		}
+
+		const int32 RemainingBytes = FMath::Max(Proxy->SendStore->PackedData.Num() - (Proxy->BlobNum * Proxy->TextureBlobSize), 0);
+		const float Weight = FMath::Max(GetClientSendPriority(RepData.PC, RemainingBytes), KINDA_SMALL_NUMBER);
+
+		ActiveTransfers.Add({ Proxy, Weight });
+		TotalWeight += Weight;
+		QueuedBytes += RemainingBytes;
+	}
+
+	SET_DWORD_STAT(STAT_RenderTargetActiveTransfers, ActiveTransfers.Num());
+	SET_DWORD_STAT(STAT_RenderTargetQueuedBytes, QueuedBytes);
+
+	if (!ActiveTransfers.Num())
+	{
+		SET_DWORD_STAT(STAT_RenderTargetBlobsInFlight, 0);
+		GetWorld()->GetTimerManager().ClearTimer(SendScheduler_Handle);
+		return;
+	}
+
+	const double CurTime = FPlatformTime::Seconds();
+	const float DeltaTime = FMath::Clamp((float)(CurTime - LastSendScheduleTime), 0.f, 0.25f);
+	LastSendScheduleTime = CurTime;
+
+	const float StepBudget = MaxTotalBytesPerSecondRate * DeltaTime;
+	const float Budget = StepBudget + SendBudgetCarry;
+	float UnusedBudget = 0.f;
+	int32 BytesSent = 0;
+	int32 BlobsInFlight = 0;
+
+	for (const FActiveTransfer& Transfer : ActiveTransfers)
+	{
+		ARenderTargetReplicationProxy* Proxy = Transfer.Proxy;
+		const float Share = Transfer.Weight / TotalWeight;
+
+		// Size the window to the bandwidth delay product of this clients share so high latency clients keep their pipe full
+		// without being able to hold more than their share in flight. Assume 100ms until we have a sample.
+		const float RTT = Proxy->SmoothedRTT > 0.f ? Proxy->SmoothedRTT : 0.1f;
+		const int32 Window = FMath::Clamp(FMath::CeilToInt((MaxTotalBytesPerSecondRate * Share * RTT) / Proxy->TextureBlobSize), 1, FMath::Max(MaxUnackedBlobs, 1));
+
+		Proxy->SendCredit += Budget * Share;
+
+		while (Proxy->SendCredit >= Proxy->TextureBlobSize && Proxy->GetBlobsInFlight() < Window && Proxy->BlobNum < Proxy->GetTotalBlobs())
+		{
+			const int32 Sent = Proxy->SendBlob();
+			Proxy->SendCredit -= Sent;
+			BytesSent += Sent;
+		}
+
+		BlobsInFlight += Proxy->GetBlobsInFlight();
+
+		if (Proxy->BlobNum >= Proxy->GetTotalBlobs())
+		{
+			// Everything is on the wire, hand back what we didn't use
+			UnusedBudget += FMath::Max(Proxy->SendCredit, 0.f);
+			Proxy->FinishTextureSend();
+		}
+		else if (Proxy->SendCredit > Window * Proxy->TextureBlobSize)
+		{
+			// Window limited, don't let it bank more than a windows worth
+			UnusedBudget += Proxy->SendCredit - (Window * Proxy->TextureBlobSize);
+			Proxy->SendCredit = Window * Proxy->TextureBlobSize;
+		}
+	}
+
+	// Clients that couldn't use their share pass it on to the next step, but never more than a steps worth so we don't burst
+	SendBudgetCarry = FMath::Min(UnusedBudget, StepBudget);
+
+	SET_DWORD_STAT(STAT_RenderTargetBlobsInFlight, BlobsInFlight);
+	SET_DWORD_STAT(STAT_RenderTargetScheduledBytes, BytesSent);
+}
 
 ARenderTargetReplicationProxy::ARenderTargetReplicationProxy(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -329,6 +601,13 @@ ARenderTargetReplicationProxy::ARenderTargetReplicationProxy(const FObjectInitia
 	PrimaryActorTick.bCanEverTick = false;
 	SetReplicateMovement(false);
 	bWaitingForManager = false;
+	bHadManager = false;
+	PendingTextureVersion = 0;
+	PendingBlobCount = 0;
+	bStreamingBlobs = false;
+	LastAckedBlob = 0;
+	SendCredit = 0.f;
+	SmoothedRTT = 0.f;
 }
 
 void ARenderTargetReplicationProxy::OnRep_Manager()
@@ -336,6 +615,14 @@ void ARenderTargetReplicationProxy::OnRep_Manager()
 	// If our manager is valid, save off a reference to ourselves to the local copy.
 	if (IsValid(OwningManager))
 	{
+		// A different manager instance than the one we had means it was destroyed and re-created on loss of relevancy
+		// so it is back to the clear color and the server can't send it a delta against what we had
+		if (bHadManager && OwningManager->LocalProxy != this)
+		{
+			NotifyManagerReset();
+		}
+
+		bHadManager = true;
 		OwningManager->LocalProxy = this;
 
 		// If we loaded a texture before the manager loaded
@@ -378,6 +665,19 @@ void ARenderTargetReplicationProxy::SendLocalDrawOperations_Implementation(const
 	}
 }
 
+bool ARenderTargetReplicationProxy::NotifyManagerReset_Validate()
+{
+	return true;
+}
+
+void ARenderTargetReplicationProxy::NotifyManagerReset_Implementation()
+{
+	if (IsValid(OwningManager))
+	{
+		OwningManager->OnClientManagerReset(this);
+	}
+}
+
 void ARenderTargetReplicationProxy::ReceiveTexture_Implementation(const FBPVRReplicatedTextureStore& TextureData)
 {
 	if (IsValid(OwningManager))
@@ -388,11 +688,12 @@ void ARenderTargetReplicationProxy::ReceiveTexture_Implementation(const FBPVRRep
 	}
 }
 
-void ARenderTargetReplicationProxy::InitTextureSend_Implementation(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped/*, bool bIsJPG*/)
+void ARenderTargetReplicationProxy::InitTextureSend_Implementation(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped, int32 DeltaTileSize/*, bool bIsJPG*/)
 {
 	TextureStore.Reset();
 	TextureStore.PixelFormat = PixelFormat;
 	TextureStore.bIsZipped = bIsZipped;
+	TextureStore.DeltaTileSize = (uint32)FMath::Max(DeltaTileSize, 0);
 	//TextureStore.bJPG = bIsJPG;
 	TextureStore.Width = Width;
 	TextureStore.Height = Height;
@@ -417,9 +718,21 @@ bool ARenderTargetReplicationProxy::Ack_InitTextureSend_Validate(int32 TotalData
 
 void ARenderTargetReplicationProxy::Ack_InitTextureSend_Implementation(int32 TotalDataCount)
 {
-	if (TotalDataCount == TextureStore.PackedData.Num())
+	if (SendStore.IsValid() && TotalDataCount == SendStore->PackedData.Num())
 	{
 		BlobNum = 0;
+		LastAckedBlob = 0;
+		BlobSendTimes.Reset();
+		BlobSendTimes.AddZeroed(GetTotalBlobs());
+
+		if (IsValid(OwningManager) && OwningManager->bUseGlobalSendScheduler)
+		{
+			// The manager paces us along with every other client
+			bStreamingBlobs = true;
+			SendCredit = 0.f;
+			OwningManager->StartSendScheduler();
+			return;
+		}
 
 		// Calculate time offset to achieve our max bytes per second with the given blob size
 		float SendRate = 1.f / (MaxBytesPerSecondRate / (float)TextureBlobSize);
@@ -431,55 +744,80 @@ void ARenderTargetReplicationProxy::Ack_InitTextureSend_Implementation(int32 Tot
 	}
 }
 
+void ARenderTargetReplicationProxy::BeginTextureSend(const FBPVRSharedTextureStore& Store, uint32 TextureVersion)
+{
+	if (!Store.IsValid())
+		return;
+
+	// Stop any send in progress, the client resets its buffer on the new init
+	if (SendTimer_Handle.IsValid())
+		GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
+
+	SendStore = Store;
+	bStreamingBlobs = false;
+	BlobNum = 0;
+	LastAckedBlob = 0;
+	PendingTextureVersion = TextureVersion;
+	SendInitMessage();
+}
+
 void ARenderTargetReplicationProxy::SendInitMessage()
 {
-	int32 TotalBlobs = TextureStore.PackedData.Num() / TextureBlobSize + (TextureStore.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+	if (!SendStore.IsValid())
+		return;
+
+	const FBPVRReplicatedTextureStore& Store = *SendStore;
+	int32 TotalBlobs = Store.PackedData.Num() / TextureBlobSize + (Store.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+	PendingBlobCount = TotalBlobs;
 
-	InitTextureSend(TextureStore.Width, TextureStore.Height, TextureStore.PackedData.Num(), TotalBlobs, TextureStore.PixelFormat, TextureStore.bIsZipped/*, TextureStore.bJPG*/);
+	InitTextureSend(Store.Width, Store.Height, Store.PackedData.Num(), TotalBlobs, Store.PixelFormat, Store.bIsZipped, (int32)Store.DeltaTileSize/*, Store.bJPG*/);
 
 }
 
 void ARenderTargetReplicationProxy::SendNextDataBlob()
 {
-	if (!IsValid(this) || !this->GetOwner() || !IsValid(this->GetOwner()))
-	{	
-		TextureStore.Reset();
-		TextureStore.PackedData.Empty();
-		TextureStore.UnpackedData.Empty();
-		BlobNum = 0;
-		if (SendTimer_Handle.IsValid())
-			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
-
+	if (!IsValid(this) || !this->GetOwner() || !IsValid(this->GetOwner()) || !SendStore.IsValid() || BlobNum >= GetTotalBlobs())
+	{
+		FinishTextureSend();
 		return;
 	}
 
-	BlobNum++;
-	int32 TotalBlobs = TextureStore.PackedData.Num() / TextureBlobSize + (TextureStore.PackedData.Num() % TextureBlobSize > 0 ? 1 : 0);
+	SendBlob();
+}
 
-	if (BlobNum <= TotalBlobs)
-	{
-		TArray<uint8> BlobStore;
-		int32 BlobLen = (BlobNum == TotalBlobs ? TextureStore.PackedData.Num() % TextureBlobSize : TextureBlobSize);
+int32 ARenderTargetReplicationProxy::SendBlob()
+{
+	if (!SendStore.IsValid() || BlobNum >= GetTotalBlobs())
+		return 0;
 
+	BlobNum++;
+	const TArray<uint8>& PackedData = SendStore->PackedData;
+	int32 MemCount = (BlobNum - 1) * TextureBlobSize;
+	int32 BlobLen = FMath::Min(TextureBlobSize, PackedData.Num() - MemCount);
 
-		BlobStore.AddUninitialized(BlobLen);
-		uint8* MemLoc = TextureStore.PackedData.GetData();
-		int32 MemCount = (BlobNum - 1) * TextureBlobSize;
-		MemLoc += MemCount;
+	// Slice straight out of the shared store
+	TArray<uint8> BlobStore(PackedData.GetData() + MemCount, BlobLen);
 
-		FMemory::Memcpy(BlobStore.GetData(), MemLoc, BlobLen);
+	ReceiveTextureBlob(BlobStore, MemCount, BlobNum);
 
-		ReceiveTextureBlob(BlobStore, MemCount, BlobNum);
-	}
-	else
+	if (BlobSendTimes.IsValidIndex(BlobNum - 1))
 	{
-		TextureStore.Reset();
-		TextureStore.PackedData.Empty();
-		TextureStore.UnpackedData.Empty();
-		if (SendTimer_Handle.IsValid())
-			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
-		BlobNum = 0;
+		BlobSendTimes[BlobNum - 1] = FPlatformTime::Seconds();
 	}
+
+	return BlobLen;
+}
+
+void ARenderTargetReplicationProxy::FinishTextureSend()
+{
+	// Drop our reference, the store is freed once every proxy is done with it
+	SendStore.Reset();
+	bStreamingBlobs = false;
+	SendCredit = 0.f;
+	BlobNum = 0;
+
+	if (SendTimer_Handle.IsValid())
+		GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
 }
 
 //=============================================================================
@@ -503,10 +841,11 @@ void ARenderTargetReplicationProxy::ReceiveTextureBlob_Implementation(const TArr
 		//GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Orange, FString::Printf(TEXT("Recieved Texture blob, byte count: %i"), TextureBlob.Num()));
 	}
 
+	// Ack every blob, the server keeps a window of them in flight and paces off of these
+	Ack_ReceiveTextureBlob(BlobNumber);
+
 	if (BlobNumber == BlobNum)
 	{
-		Ack_ReceiveTextureBlob(BlobNum);
-
 		// We finished, unpack and display
 		if (IsValid(OwningManager))
 		{
@@ -536,6 +875,24 @@ void ARenderTargetReplicationProxy::Ack_ReceiveTextureBlob_Implementation(int32
 	// Send next data blob
 	//SendNextDataBlob();
 
+	if (BlobCount > LastAckedBlob)
+	{
+		LastAckedBlob = BlobCount;
+
+		// Acks are in order so this is a fair round trip sample
+		if (BlobSendTimes.IsValidIndex(BlobCount - 1) && BlobSendTimes[BlobCount - 1] > 0.0)
+		{
+			const float Sample = (float)(FPlatformTime::Seconds() - BlobSendTimes[BlobCount - 1]);
+			SmoothedRTT = SmoothedRTT > 0.f ? FMath::Lerp(SmoothedRTT, Sample, 0.125f) : Sample;
+		}
+	}
+
+	// Final blob, the client now has the version that we sent
+	if (BlobCount == PendingBlobCount && IsValid(OwningManager))
+	{
+		OwningManager->OnClientTextureAcked(this, PendingTextureVersion);
+	}
+
 }
 
 void UVRRenderTargetManager::UpdateRelevancyMap()
@@ -623,6 +980,11 @@ void UVRRenderTargetManager::UpdateRelevancyMap()
 							RepData->bIsDirty = true;
 							bHadDirtyActors = true;
 						}
+						else if (!RepData->bIsDirty && !RepData->bAwaitingTextureAck)
+						{
+							// Still relevant and synced, it has received every draw operation up until now
+							RepData->AckedTextureVersion = TextureVersion;
+						}
 					}
 				}
 			}
@@ -643,6 +1005,10 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 
 	RenderTargetStore.UnPackData();
 
+	if (RenderTargetStore.DeltaTileSize > 0)
+	{
+		return DeCompressRenderTargetTiles();
+	}
 
 	int32 Width = RenderTargetStore.Width;
 	int32 Height = RenderTargetStore.Height;
@@ -747,6 +1113,134 @@ bool UVRRenderTargetManager::DeCompressRenderTarget2D()
 	return true;
 }
 
+bool UVRRenderTargetManager::DeCompressRenderTargetTiles()
+{
+	const TArray<uint16>& Data = RenderTargetStore.UnpackedData;
+	const int32 Width = RenderTargetStore.Width;
+	const int32 Height = RenderTargetStore.Height;
+	const int32 TileSize = RenderTargetStore.DeltaTileSize;
+
+	if (Data.Num() < 2 || Width <= 0 || Height <= 0)
+		return false;
+
+	const int32 NumTiles = (int32)((uint32)Data[0] | ((uint32)Data[1] << 16));
+	const int32 TilesX = FMath::DivideAndRoundUp(Width, TileSize);
+	const int32 TilesY = FMath::DivideAndRoundUp(Height, TileSize);
+
+	if (NumTiles <= 0 || NumTiles > TilesX * TilesY || Data.Num() < 2 + (NumTiles * 2))
+		return false;
+
+	// Pack all of the tiles into a single atlas texture so that it is one upload and one draw batch
+	const int32 AtlasColumns = FMath::CeilToInt(FMath::Sqrt((float)NumTiles));
+	const int32 AtlasRows = FMath::DivideAndRoundUp(NumTiles, AtlasColumns);
+	const int32 AtlasWidth = AtlasColumns * TileSize;
+	const int32 AtlasHeight = AtlasRows * TileSize;
+
+	TArray<FColor> AtlasData;
+	AtlasData.SetNumZeroed(AtlasWidth * AtlasHeight);
+
+	TArray<FIntRect> TileRects;
+	TileRects.AddUninitialized(NumTiles);
+
+	int32 ReadLoc = 2 + (NumTiles * 2);
+	FColor ColorVal;
+	ColorVal.A = 0xFF;
+	for (int32 i = 0; i < NumTiles; ++i)
+	{
+		const int32 TileIndex = (int32)((uint32)Data[2 + (i * 2)] | ((uint32)Data[3 + (i * 2)] << 16));
+		if (TileIndex < 0 || TileIndex >= TilesX * TilesY)
+			return false;
+
+		const int32 X = (TileIndex % TilesX) * TileSize;
+		const int32 Y = (TileIndex / TilesX) * TileSize;
+		const int32 TileWidth = FMath::Min(TileSize, Width - X);
+		const int32 TileHeight = FMath::Min(TileSize, Height - Y);
+
+		if (ReadLoc + (TileWidth * TileHeight) > Data.Num())
+			return false;
+
+		TileRects[i] = FIntRect(X, Y, X + TileWidth, Y + TileHeight);
+
+		const int32 AtlasX = (i % AtlasColumns) * TileSize;
+		const int32 AtlasY = (i / AtlasColumns) * TileSize;
+
+		for (int32 y = 0; y < TileHeight; ++y)
+		{
+			FColor* AtlasRow = AtlasData.GetData() + ((AtlasY + y) * AtlasWidth) + AtlasX;
+			for (int32 x = 0; x < TileWidth; ++x)
+			{
+				// Same channel layout as the full texture path
+				const uint16 CompColor = Data[ReadLoc++];
+				ColorVal.R = CompColor << 3;
+				ColorVal.G = CompColor >> 5 << 2;
+				ColorVal.B = CompColor >> 11 << 3;
+				AtlasRow[x] = ColorVal;
+			}
+		}
+	}
+
+	UTexture2D* RenderBase = UTexture2D::CreateTransient(AtlasWidth, AtlasHeight, PF_R8G8B8A8);
+
+	uint8* MipData = (uint8*)RenderBase->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(MipData, (void*)AtlasData.GetData(), AtlasData.Num() * sizeof(FColor));
+	RenderBase->GetPlatformData()->Mips[0].BulkData.Unlock();
+
+	RenderBase->GetPlatformData()->SetNumSlices(1);
+	RenderBase->NeverStream = true;
+	RenderBase->SRGB = true;
+	RenderBase->Filter = TF_Nearest; // Don't bleed neighboring tiles in the atlas
+
+	RenderBase->UpdateResource();
+
+	UWorld* World = GetWorld();
+
+	// Reference to the Render Target resource
+	FTextureRenderTargetResource* RenderTargetResource = RenderTarget->GameThread_GetRenderTargetResource();
+
+	// Retrieve a UCanvas form the world to avoid creating a new one each time
+	UCanvas* CanvasToUse = World->GetCanvasForDrawMaterialToRenderTarget();
+
+	// Creates a new FCanvas for rendering
+	FCanvas RenderCanvas(
+		RenderTargetResource,
+		nullptr,
+		World,
+		World->FeatureLevel);
+
+	// Setup the canvas with the FCanvas reference
+	CanvasToUse->Init(RenderTarget->SizeX, RenderTarget->SizeY, nullptr, &RenderCanvas);
+	CanvasToUse->Update();
+
+	if (CanvasToUse)
+	{
+		FTexture* RenderTextureResource = RenderBase->GetResource();
+		const FVector2D Scale(RenderTarget->SizeX / (float)Width, RenderTarget->SizeY / (float)Height);
+		const FVector2D InvAtlasSize(1.f / AtlasWidth, 1.f / AtlasHeight);
+
+		for (int32 i = 0; i < NumTiles; ++i)
+		{
+			const FIntRect& Rect = TileRects[i];
+			const FVector2D AtlasPos((i % AtlasColumns) * TileSize, (i / AtlasColumns) * TileSize);
+			const FVector2D TileSize2D(Rect.Width(), Rect.Height());
+
+			FCanvasTileItem TileItem(FVector2D(Rect.Min) * Scale, RenderTextureResource, TileSize2D * Scale, AtlasPos * InvAtlasSize, (AtlasPos + TileSize2D) * InvAtlasSize, FLinearColor::White);
+			TileItem.BlendMode = FCanvas::BlendToSimpleElementBlend(EBlendMode::BLEND_Opaque);
+			CanvasToUse->DrawItem(TileItem);
+		}
+
+		// Perform the drawing
+		RenderCanvas.Flush_GameThread();
+
+		// Cleanup the FCanvas reference, to delete it
+		CanvasToUse->Canvas = NULL;
+	}
+
+	RenderBase->ReleaseResource();
+	RenderBase->MarkAsGarbage();
+
+	return true;
+}
+
 void UVRRenderTargetManager::QueueImageStore()
 {
 
@@ -768,6 +1262,7 @@ void UVRRenderTargetManager::QueueImageStore()
 
 	renderData->Size2D = renderTargetResource->GetSizeXY();
 	renderData->PixelFormat = RenderTarget->GetFormat();
+	renderData->TextureVersion = TextureVersion;
 
 	struct FReadSurfaceContext {
 		FRenderTarget* SrcRenderTarget;
@@ -787,6 +1282,7 @@ void UVRRenderTargetManager::QueueImageStore()
 
 	ENQUEUE_RENDER_COMMAND(SceneDrawCompletion)(
 		[readSurfaceContext](FRHICommandListImmediate& RHICmdList) {
+			SCOPE_CYCLE_COUNTER(STAT_RenderTargetReadback);
 			RHICmdList.ReadSurfaceData(
 				readSurfaceContext.SrcRenderTarget->GetRenderTargetTexture(),
 				readSurfaceContext.Rect,
@@ -809,10 +1305,18 @@ void UVRRenderTargetManager::TickComponent(float DeltaTime, enum ELevelTick Tick
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// Read pixels once RenderFence is completed
-	if (!bInitiallyReplicateTexture || RenderDataQueue.IsEmpty() || GetNetMode() == ENetMode::NM_DedicatedServer)
+	if (!bInitiallyReplicateTexture || (RenderDataQueue.IsEmpty() && !PendingEncodeJob.IsValid()) || GetNetMode() == ENetMode::NM_DedicatedServer)
 	{
 		SetComponentTickEnabled(false);
 	}
+	else if (PendingEncodeJob.IsValid())
+	{
+		// Wait on the encode task to finish before picking up the next read back
+		if (PendingEncodeTask.IsCompleted())
+		{
+			FinishEncodeJob();
+		}
+	}
 	else
 	{
 		// Peek the next RenderRequest from queue
@@ -823,57 +1327,178 @@ void UVRRenderTargetManager::TickComponent(float DeltaTime, enum ELevelTick Tick
 		{
 			if (nextRenderData->RenderFence.IsFenceComplete())
 			{
-				bIsStoringImage = false;
-				RenderTargetStore.Reset();
-				uint32 SizeOfData = nextRenderData->ColorData.Num();
+				StartEncodeJob(nextRenderData);
 
-				RenderTargetStore.UnpackedData.Reset(SizeOfData);
-				RenderTargetStore.UnpackedData.AddUninitialized(SizeOfData);
+				// Delete the first element from RenderQueue
+				RenderDataQueue.Pop();
+				delete nextRenderData;
+			}
+		}
+	}
 
-				uint16 ColorVal = 0;
-				uint32 Counter = 0;
+}
 
-				// Convert to 16bit color
-				for (FColor col : nextRenderData->ColorData)
-				{
-					ColorVal = (col.R >> 3) << 11 | (col.G >> 2) << 5 | (col.B >> 3);
-					RenderTargetStore.UnpackedData[Counter++] = ColorVal;
-				}
+void UVRRenderTargetManager::StartEncodeJob(FRenderDataStore* RenderData)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RenderTargetStartEncode);
 
-				FIntPoint Size2D = nextRenderData->Size2D;
-				RenderTargetStore.Width = Size2D.X;
-				RenderTargetStore.Height = Size2D.Y;
-				RenderTargetStore.PixelFormat = nextRenderData->PixelFormat;
-				RenderTargetStore.PackData();
+	TSharedPtr<FRenderTargetEncodeJob, ESPMode::ThreadSafe> Job = MakeShared<FRenderTargetEncodeJob, ESPMode::ThreadSafe>();
+	Job->ColorData = MoveTemp(RenderData->ColorData);
+	Job->Size2D = RenderData->Size2D;
+	Job->PixelFormat = RenderData->PixelFormat;
+	Job->TextureVersion = RenderData->TextureVersion;
+	Job->TileSize = DeltaTileSize;
 
+	// Work out which stores the dirty clients need now, tile versions can only be read on the game thread
+	TArray<int32> DirtyTiles;
+	for (FClientRepData& RepData : NetRelevancyLog)
+	{
+		if (!RepData.bIsDirty || !IsValid(RepData.PC) || RepData.PC->IsLocalController() || !IsValid(RepData.ReplicationProxy))
+			continue;
 
-//#if WITH_PUSH_MODEL
-				//MARK_PROPERTY_DIRTY_FROM_NAME(UVRRenderTargetManager, RenderTargetStore, this);
-//#endif
+		if (bUseDeltaTextureReplication && GatherDirtyTiles(RepData.AckedTextureVersion, Job->Size2D, DirtyTiles))
+		{
+			if (!DirtyTiles.Num())
+			{
+				// Nothing was drawn since the version that they have
+				RepData.AckedTextureVersion = Job->TextureVersion;
+				RepData.bIsDirty = false;
+				continue;
+			}
+
+			// Clients synced to the same version can share the same delta
+			if (!Job->FindDeltaRequest(RepData.AckedTextureVersion))
+			{
+				FRenderTargetEncodeRequest& Request = Job->DeltaRequests.AddDefaulted_GetRef();
+				Request.BaseVersion = RepData.AckedTextureVersion;
+				Request.Tiles = DirtyTiles;
+			}
+		}
+		else
+		{
+			Job->bNeedsFullStore = true;
+		}
+	}
 
+	if (!Job->bNeedsFullStore && !Job->DeltaRequests.Num())
+	{
+		bIsStoringImage = false;
+		return;
+	}
 
-				// Delete the first element from RenderQueue
-				RenderDataQueue.Pop();
-				delete nextRenderData;
+	PendingEncodeJob = Job;
+	PendingEncodeTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job]()
+		{
+			Job->Encode();
+		}, LowLevelTasks::ETaskPriority::BackgroundNormal);
+}
+
+void UVRRenderTargetManager::FinishEncodeJob()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RenderTargetDispatch);
+
+	TSharedPtr<FRenderTargetEncodeJob, ESPMode::ThreadSafe> Job = MoveTemp(PendingEncodeJob);
+	PendingEncodeJob.Reset();
+	PendingEncodeTask = UE::Tasks::FTask();
+	bIsStoringImage = false;
+
+	if (!Job.IsValid())
+		return;
+
+	bool bNeedsNewStore = false;
+
+	for (int i = NetRelevancyLog.Num() - 1; i >= 0; i--)
+	{
+		if (NetRelevancyLog[i].bIsDirty && IsValid(NetRelevancyLog[i].PC) && !NetRelevancyLog[i].PC->IsLocalController())
+		{
+			if (IsValid(NetRelevancyLog[i].ReplicationProxy))
+			{
+				FBPVRSharedTextureStore StoreToSend;
 
-				for (int i = NetRelevancyLog.Num() - 1; i >= 0; i--)
+				if (bUseDeltaTextureReplication)
 				{
-					if (NetRelevancyLog[i].bIsDirty && IsValid(NetRelevancyLog[i].PC) && !NetRelevancyLog[i].PC->IsLocalController())
+					if (const FRenderTargetEncodeRequest* Request = Job->FindDeltaRequest(NetRelevancyLog[i].AckedTextureVersion))
 					{
-						if (IsValid(NetRelevancyLog[i].ReplicationProxy))
-						{
-							NetRelevancyLog[i].ReplicationProxy->TextureStore = RenderTargetStore;
-							NetRelevancyLog[i].ReplicationProxy->SendInitMessage();
-							NetRelevancyLog[i].bIsDirty = false;
-						}
+						StoreToSend = Request->Store;
 					}
 				}
 
+				if (!StoreToSend.IsValid() && Job->bNeedsFullStore)
+				{
+					StoreToSend = Job->FullStore;
+				}
 
+				// Became dirty while we were encoding and needs something that we didn't build
+				if (!StoreToSend.IsValid())
+				{
+					bNeedsNewStore = true;
+					continue;
+				}
+
+				// Every proxy references the same packed data instead of holding its own copy
+				NetRelevancyLog[i].ReplicationProxy->BeginTextureSend(StoreToSend, Job->TextureVersion);
+				NetRelevancyLog[i].bIsDirty = false;
+				NetRelevancyLog[i].bAwaitingTextureAck = true;
 			}
 		}
 	}
 
+	if (bNeedsNewStore)
+	{
+		QueueImageStore();
+	}
+}
+
+void FRenderTargetEncodeJob::Encode()
+{
+	const int32 NumPixels = ColorData.Num();
+
+	TArray<uint16> PixelData;
+	PixelData.SetNumUninitialized(NumPixels);
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_RenderTargetConvert);
+
+		// Convert to 16bit color, DWColor is always 0xAARRGGBB so we can shift the channels into place directly
+		// without any branches, which lets the compiler vectorize the loop
+		const FColor* Src = ColorData.GetData();
+		uint16* Dst = PixelData.GetData();
+		for (int32 i = 0; i < NumPixels; ++i)
+		{
+			const uint32 Col = Src[i].DWColor();
+			Dst[i] = (uint16)(((Col >> 8) & 0xF800) | ((Col >> 5) & 0x07E0) | ((Col >> 3) & 0x001F));
+		}
+	}
+
+	// Don't need the source anymore
+	ColorData.Empty();
+
+	for (FRenderTargetEncodeRequest& Request : DeltaRequests)
+	{
+		TSharedRef<FBPVRReplicatedTextureStore, ESPMode::ThreadSafe> NewStore = MakeShared<FBPVRReplicatedTextureStore, ESPMode::ThreadSafe>();
+
+		{
+			SCOPE_CYCLE_COUNTER(STAT_RenderTargetExtractTiles);
+			NewStore->SetFromTiles(PixelData, Size2D.X, Size2D.Y, TileSize, Request.Tiles);
+		}
+
+		NewStore->PixelFormat = PixelFormat;
+		NewStore->PackData();
+		INC_DWORD_STAT_BY(STAT_RenderTargetEncodedBytes, NewStore->PackedData.Num());
+		Request.Store = NewStore;
+	}
+
+	if (bNeedsFullStore)
+	{
+		TSharedRef<FBPVRReplicatedTextureStore, ESPMode::ThreadSafe> NewStore = MakeShared<FBPVRReplicatedTextureStore, ESPMode::ThreadSafe>();
+		NewStore->UnpackedData = MoveTemp(PixelData);
+		NewStore->Width = Size2D.X;
+		NewStore->Height = Size2D.Y;
+		NewStore->PixelFormat = PixelFormat;
+		NewStore->PackData();
+		INC_DWORD_STAT_BY(STAT_RenderTargetEncodedBytes, NewStore->PackedData.Num());
+		FullStore = NewStore;
+	}
 }
 
 void UVRRenderTargetManager::BeginPlay()
@@ -890,6 +1515,9 @@ void UVRRenderTargetManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
+	// The task holds its own reference to the job, it just won't be handed out
+	PendingEncodeJob.Reset();
+
 	FRenderDataStore* Store = nullptr;
 	while (!RenderDataQueue.IsEmpty())
 	{
@@ -907,6 +1535,9 @@ void UVRRenderTargetManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	if(DrawHandle.IsValid())
 		GetWorld()->GetTimerManager().ClearTimer(DrawHandle);
 
+	if (SendScheduler_Handle.IsValid())
+		GetWorld()->GetTimerManager().ClearTimer(SendScheduler_Handle);
+
 	if (RenderTarget)
 	{
 		RenderTarget->ReleaseResource();
@@ -945,6 +1576,13 @@ void UVRRenderTargetManager::InitRenderTarget()
 			RenderTarget->ClearColor = ClearColor;
 			RenderTarget->bAutoGenerateMips = false;
 			RenderTarget->UpdateResourceImmediate(true);
+
+			// Everything starts out at version 0 (the clear color)
+			DeltaTileSize = FMath::Clamp(DeltaTileSize, 16, 512);
+			TileCount = FIntPoint(FMath::DivideAndRoundUp(RenderTargetWidth, DeltaTileSize), FMath::DivideAndRoundUp(RenderTargetHeight, DeltaTileSize));
+			TileVersions.Reset();
+			TileVersions.AddZeroed(TileCount.X * TileCount.Y);
+			TextureVersion = 0;
 		}
 		else
 		{
@@ -1113,7 +1751,10 @@ void FBPVRReplicatedTextureStore::PackData()
 	if (UnpackedData.Num() > 0)
 	{
 		TArray<uint8> TmpPacked;
-		RLE_Funcs::RLEEncodeBuffer<uint16>(UnpackedData.GetData(), UnpackedData.Num(), &TmpPacked);
+		{
+			SCOPE_CYCLE_COUNTER(STAT_RenderTargetRLE);
+			RLE_Funcs::RLEEncodeBuffer<uint16>(UnpackedData.GetData(), UnpackedData.Num(), &TmpPacked);
+		}
 		UnpackedData.Reset();
 
 		/*if (TmpPacked.Num() > 30000)
@@ -1133,6 +1774,7 @@ void FBPVRReplicatedTextureStore::PackData()
 		}
 		else */if (TmpPacked.Num() > 512)
 		{
+			SCOPE_CYCLE_COUNTER(STAT_RenderTargetCompress);
 			FArchiveSaveCompressedProxy Compressor(PackedData, NAME_Zlib, COMPRESS_BiasSpeed);
 			Compressor << TmpPacked;
 			Compressor.Flush();
@@ -1149,6 +1791,44 @@ void FBPVRReplicatedTextureStore::PackData()
 }
 
 
+void FBPVRReplicatedTextureStore::SetFromTiles(const TArray<uint16>& FullPixels, int32 InWidth, int32 InHeight, int32 TileSize, const TArray<int32>& TileIndices)
+{
+	Width = InWidth;
+	Height = InHeight;
+	DeltaTileSize = TileSize;
+
+	const int32 TilesX = FMath::DivideAndRoundUp(InWidth, TileSize);
+
+	int32 PixelCount = 0;
+	for (int32 TileIndex : TileIndices)
+	{
+		PixelCount += FMath::Min(TileSize, InWidth - ((TileIndex % TilesX) * TileSize)) * FMath::Min(TileSize, InHeight - ((TileIndex / TilesX) * TileSize));
+	}
+
+	UnpackedData.Reset(2 + (TileIndices.Num() * 2) + PixelCount);
+
+	UnpackedData.Add((uint16)(TileIndices.Num() & 0xFFFF));
+	UnpackedData.Add((uint16)(TileIndices.Num() >> 16));
+	for (int32 TileIndex : TileIndices)
+	{
+		UnpackedData.Add((uint16)(TileIndex & 0xFFFF));
+		UnpackedData.Add((uint16)(TileIndex >> 16));
+	}
+
+	for (int32 TileIndex : TileIndices)
+	{
+		const int32 X = (TileIndex % TilesX) * TileSize;
+		const int32 Y = (TileIndex / TilesX) * TileSize;
+		const int32 TileWidth = FMath::Min(TileSize, InWidth - X);
+		const int32 TileHeight = FMath::Min(TileSize, InHeight - Y);
+
+		for (int32 y = 0; y < TileHeight; ++y)
+		{
+			UnpackedData.Append(FullPixels.GetData() + ((Y + y) * InWidth) + X, TileWidth);
+		}
+	}
+}
+
 void FBPVRReplicatedTextureStore::UnPackData()
 {
 	if (PackedData.Num() > 0)
@@ -1198,6 +1878,7 @@ bool FBPVRReplicatedTextureStore::NetSerialize(FArchive& Ar, class UPackageMap*
 	Ar.SerializeIntPacked(Width);
 	Ar.SerializeIntPacked(Height);
 	Ar.SerializeBits(&PixelFormat, 8);
+	Ar.SerializeIntPacked(DeltaTileSize);
 
 	Ar << PackedData;
 
@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/VRServerMoveBatchSubsystem.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VRServerMoveBatchSubsystem)
+
+#include "VRCharacterMovementComponent.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Batched ServerMoves"), STAT_VRBatchedServerMoves, STATGROUP_VRServerMoveBatching);
+DECLARE_CYCLE_STAT(TEXT("Batched ServerMoves ~ PreValidate"), STAT_VRBatchedServerMovesPreValidate, STATGROUP_VRServerMoveBatching);
+DECLARE_CYCLE_STAT(TEXT("Batched ServerMoves ~ Perform"), STAT_VRBatchedServerMovesPerform, STATGROUP_VRServerMoveBatching);
+DECLARE_CYCLE_STAT(TEXT("Batched ServerMoves ~ Check Error"), STAT_VRBatchedServerMovesCheckError, STATGROUP_VRServerMoveBatching);
+DECLARE_CYCLE_STAT(TEXT("Batched ServerMoves ~ Apply Error"), STAT_VRBatchedServerMovesApplyError, STATGROUP_VRServerMoveBatching);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Characters"), STAT_VRBatchedServerMoveCharacters, STATGROUP_VRServerMoveBatching);
+
+namespace VRServerMoveBatchCVars
+{
+	static int32 BatchServerMoves = 0;
+	FAutoConsoleVariableRef CVarBatchServerMoves(
+		TEXT("vre.BatchServerMoves"),
+		BatchServerMoves,
+		TEXT("When on, the server gathers the received moves of all VR characters and handles them together once per frame.\n")
+		TEXT("Moves are handled after the net driver finishes dispatching, so they run after any other RPCs received from the same connection that frame.\n")
+		TEXT("Compare stat VRServerMoveBatching against the serial path counters in the same group.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+
+	static int32 ParallelChecks = 0;
+	FAutoConsoleVariableRef CVarParallelChecks(
+		TEXT("vre.BatchServerMoves.ParallelChecks"),
+		ParallelChecks,
+		TEXT("When on, the timestamp validation and client error checks of batched moves run on worker threads.\n")
+		TEXT("Only enable this if any overrides of IsClientTimeStampValid, ServerCheckClientErrorVR and ServerExceedsAllowablePositionError are safe to run off of the game thread.\n")
+		TEXT("0: Game thread, 1: Parallel"),
+		ECVF_Default);
+
+	static int32 ParallelBatchThreshold = 4;
+	FAutoConsoleVariableRef CVarParallelBatchThreshold(
+		TEXT("vre.BatchServerMoves.ParallelThreshold"),
+		ParallelBatchThreshold,
+		TEXT("Minimum number of characters in a batch before the parallel checks are spread across worker threads."),
+		ECVF_Default);
+}
+
+bool UVRServerMoveBatchSubsystem::IsBatchingServerMoves()
+{
+	return VRServerMoveBatchCVars::BatchServerMoves > 0;
+}
+
+void UVRServerMoveBatchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UWorld* World = GetWorld())
+	{
+		PostTickDispatchHandle = World->OnPostTickDispatch().AddUObject(this, &UVRServerMoveBatchSubsystem::ProcessBatchedMoves);
+	}
+}
+
+void UVRServerMoveBatchSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->OnPostTickDispatch().Remove(PostTickDispatchHandle);
+	}
+
+	PostTickDispatchHandle.Reset();
+	QueuedComponents.Empty();
+
+	Super::Deinitialize();
+}
+
+void UVRServerMoveBatchSubsystem::QueueComponent(UVRCharacterMovementComponent* MovementComponent)
+{
+	// Components only queue themselves on their first move of the frame
+	QueuedComponents.Add(MovementComponent);
+}
+
+void UVRServerMoveBatchSubsystem::ProcessBatchedMoves()
+{
+	if (QueuedComponents.Num() <= 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_VRBatchedServerMoves);
+
+	BatchScratch.Reset(QueuedComponents.Num());
+	for (const TWeakObjectPtr<UVRCharacterMovementComponent>& QueuedComponent : QueuedComponents)
+	{
+		if (UVRCharacterMovementComponent* MovementComponent = QueuedComponent.Get())
+		{
+			if (MovementComponent->HasBatchedMoves())
+			{
+				BatchScratch.Add(MovementComponent);
+			}
+		}
+	}
+	QueuedComponents.Reset();
+
+	const int32 NumComponents = BatchScratch.Num();
+	INC_DWORD_STAT_BY(STAT_VRBatchedServerMoveCharacters, NumComponents);
+
+	// Project overrides of the check virtuals may expect the game thread, so parallel checks are opt in
+	const bool bParallelChecks = VRServerMoveBatchCVars::ParallelChecks > 0 && NumComponents >= VRServerMoveBatchCVars::ParallelBatchThreshold;
+	const EParallelForFlags ParallelFlags = bParallelChecks ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VRBatchedServerMovesPreValidate);
+		ParallelFor(NumComponents, [this](int32 Index)
+		{
+			BatchScratch[Index]->PreValidateBatchedMoves();
+		}, ParallelFlags);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VRBatchedServerMovesPerform);
+		for (UVRCharacterMovementComponent* MovementComponent : BatchScratch)
+		{
+			MovementComponent->PerformBatchedMoves();
+		}
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VRBatchedServerMovesCheckError);
+		ParallelFor(NumComponents, [this](int32 Index)
+		{
+			BatchScratch[Index]->CheckBatchedMoveError();
+		}, ParallelFlags);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VRBatchedServerMovesApplyError);
+		for (UVRCharacterMovementComponent* MovementComponent : BatchScratch)
+		{
+			MovementComponent->ApplyBatchedMoveError();
+		}
+	}
+
+	BatchScratch.Reset();
+}
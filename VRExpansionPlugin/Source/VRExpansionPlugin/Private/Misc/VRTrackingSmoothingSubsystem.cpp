@@ -0,0 +1,144 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/VRTrackingSmoothingSubsystem.h"
+#include UE_INLINE_GENERATED_CPP_BY_NAME(VRTrackingSmoothingSubsystem)
+
+#include "GripMotionControllerComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+DECLARE_CYCLE_STAT(TEXT("Banked Tracking Smoothing"), STAT_VRBankedTrackingSmoothing, STATGROUP_VRTrackingSmoothing);
+DECLARE_CYCLE_STAT(TEXT("Banked Tracking Smoothing ~ Poll"), STAT_VRBankedTrackingSmoothingPoll, STATGROUP_VRTrackingSmoothing);
+DECLARE_CYCLE_STAT(TEXT("Banked Tracking Smoothing ~ Filter"), STAT_VRBankedTrackingSmoothingFilter, STATGROUP_VRTrackingSmoothing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Banked Controllers"), STAT_VRBankedTrackingSmoothingControllers, STATGROUP_VRTrackingSmoothing);
+
+namespace VRTrackingSmoothingCVars
+{
+	static int32 BankedTrackingSmoothing = 1;
+	FAutoConsoleVariableRef CVarBankedTrackingSmoothing(
+		TEXT("vr.BankedTrackingSmoothing"),
+		BankedTrackingSmoothing,
+		TEXT("When on, motion controllers using the 1 Euro tracking smoothing are polled ahead of their tick and filtered together in a single pass over a shared filter bank.\n")
+		TEXT("When off every controller polls and filters on its own during its tick.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+}
+
+bool UVRTrackingSmoothingSubsystem::IsBankingTrackingSmoothing()
+{
+	return VRTrackingSmoothingCVars::BankedTrackingSmoothing > 0;
+}
+
+void UVRTrackingSmoothingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!SmoothingTickFunction.IsTickFunctionRegistered() && InWorld.PersistentLevel)
+	{
+		// Same settings as the motion controllers so that the pass is always ahead of them
+		SmoothingTickFunction.TickGroup = TG_PrePhysics;
+		SmoothingTickFunction.bCanEverTick = true;
+		SmoothingTickFunction.bStartWithTickEnabled = true;
+		SmoothingTickFunction.bTickEvenWhenPaused = true;
+		SmoothingTickFunction.Target = this;
+		SmoothingTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+	}
+}
+
+void UVRTrackingSmoothingSubsystem::Deinitialize()
+{
+	if (SmoothingTickFunction.IsTickFunctionRegistered())
+	{
+		SmoothingTickFunction.UnRegisterTickFunction();
+	}
+
+	// The filters point into our bank, take them back out before it goes away
+	for (const TWeakObjectPtr<UGripMotionControllerComponent>& WeakController : Controllers)
+	{
+		if (UGripMotionControllerComponent* Controller = WeakController.Get())
+		{
+			Controller->EuroSmoothingParams.UnbindFromBank();
+			Controller->bRegisteredForBankedSmoothing = false;
+		}
+	}
+
+	Controllers.Empty();
+	FilterBank.Empty();
+
+	Super::Deinitialize();
+}
+
+void UVRTrackingSmoothingSubsystem::RegisterController(UGripMotionControllerComponent* Controller)
+{
+	if (!IsValid(Controller) || Controllers.Contains(Controller))
+		return;
+
+	Controllers.Add(Controller);
+	Controller->EuroSmoothingParams.BindToBank(&FilterBank);
+	Controller->PrimaryComponentTick.AddPrerequisite(this, SmoothingTickFunction);
+}
+
+void UVRTrackingSmoothingSubsystem::UnregisterController(UGripMotionControllerComponent* Controller)
+{
+	if (!Controller || Controllers.Remove(Controller) <= 0)
+		return;
+
+	Controller->EuroSmoothingParams.UnbindFromBank();
+	Controller->PrimaryComponentTick.RemovePrerequisite(this, SmoothingTickFunction);
+}
+
+void UVRTrackingSmoothingSubsystem::TickSmoothing(float DeltaTime)
+{
+	if (!IsBankingTrackingSmoothing() || Controllers.Num() <= 0)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_VRBankedTrackingSmoothing);
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VRBankedTrackingSmoothingPoll);
+		for (int32 Index = Controllers.Num() - 1; Index >= 0; --Index)
+		{
+			UGripMotionControllerComponent* Controller = Controllers[Index].Get();
+			if (!Controller)
+			{
+				Controllers.RemoveAtSwap(Index);
+				continue;
+			}
+
+			// Time dilated owners tick with a different delta than the pass, leave them filtering during their own tick
+			const AActor* Owner = Controller->GetOwner();
+			if (Owner && Owner->CustomTimeDilation != 1.0f)
+				continue;
+
+			Controller->PrePollTrackingForSmoothing();
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_VRBankedTrackingSmoothingControllers, Controllers.Num());
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VRBankedTrackingSmoothingFilter);
+		FilterBank.Filter(DeltaTime);
+	}
+}
+
+void FVRTrackingSmoothingTickFunction::ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(FVRTrackingSmoothingTickFunction_ExecuteTick);
+
+	if (Target && IsValid(Target) && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->TickSmoothing(DeltaTime);
+	}
+}
+
+FString FVRTrackingSmoothingTickFunction::DiagnosticMessage()
+{
+	return TEXT("VRTrackingSmoothingTickFunction");
+}
+
+FName FVRTrackingSmoothingTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("VRTrackingSmoothingTick"));
+}
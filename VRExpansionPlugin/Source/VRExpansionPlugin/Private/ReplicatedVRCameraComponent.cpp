@@ -239,6 +239,18 @@ void UReplicatedVRCameraComponent::UpdateTracking(float DeltaTime)
 
 void UReplicatedVRCameraComponent::RunNetworkedSmoothing(float DeltaTime)
 {
+	if (bSmoothReplicatedMotion && SnapshotInterpolation.bUseSnapshotInterpolation)
+	{
+		FVector SampledPosition;
+		FRotator SampledRotation;
+		if (SnapshotBuffer.Sample(GetWorld()->GetRealTimeSeconds(), SnapshotInterpolation, SampledPosition, SampledRotation))
+		{
+			SetRelativeLocationAndRotation(SampledPosition, SampledRotation);
+		}
+
+		return;
+	}
+
 	FVector RetainPositionOffset(0.0f, 0.0f, ReplicatedCameraTransform.Position.Z);
 
 	if (AttachChar && !AttachChar->bRetainRoomscale)
@@ -387,8 +399,18 @@ void UReplicatedVRCameraComponent::TickComponent(float DeltaTime, enum ELevelTic
 			FRotator RelativeRot = GetRelativeRotation();
 			FVector RelativeLoc = GetRelativeLocation();
 
+			AVRBaseCharacter* OwningChar = Cast<AVRBaseCharacter>(GetOwner());
+			if (OwningChar != nullptr && OwningChar->IsBundlingPoseFor(this))
+			{
+				// The character samples this on its own rate and sends it in its pose packet
+				if (bFPSDebugMode)
+				{
+					ReplicatedCameraTransform.Position = RelativeLoc;
+					ReplicatedCameraTransform.Rotation = RelativeRot;
+				}
+			}
 			// Don't rep if no changes
-			if (!RelativeLoc.Equals(LastUpdatesRelativePosition) || !RelativeRot.Equals(LastUpdatesRelativeRotation))
+			else if (!RelativeLoc.Equals(LastUpdatesRelativePosition) || !RelativeRot.Equals(LastUpdatesRelativeRotation))
 			{
 				NetUpdateCount += DeltaTime;
 
@@ -405,7 +427,6 @@ void UReplicatedVRCameraComponent::TickComponent(float DeltaTime, enum ELevelTic
 
 					if (GetNetMode() == NM_Client)
 					{
-						AVRBaseCharacter* OwningChar = Cast<AVRBaseCharacter>(GetOwner());
 						if (OverrideSendTransform != nullptr && OwningChar != nullptr)
 						{
 							(OwningChar->* (OverrideSendTransform))(ReplicatedCameraTransform);
@@ -534,7 +555,19 @@ void UReplicatedVRCameraComponent::OnRep_ReplicatedCameraTransform()
 
 	}
     
-    if (bSmoothReplicatedMotion)
+    if (bSmoothReplicatedMotion && SnapshotInterpolation.bUseSnapshotInterpolation)
+    {
+		if (!bReppedOnce || (SnapshotBuffer.Snapshots.Num() > 0 && FVector::DistSquared(SnapshotBuffer.Snapshots.Last().Position, CameraPosition) >= FMath::Square(NetworkNoSmoothUpdateDistance)))
+		{
+			SnapshotBuffer.Reset();
+			SetRelativeLocationAndRotation(CameraPosition, ReplicatedCameraTransform.Rotation);
+			bReppedOnce = true;
+		}
+
+		SnapshotBuffer.AddSnapshot(CameraPosition, ReplicatedCameraTransform.Rotation, GetWorld()->GetRealTimeSeconds(), 1.0f / FMath::Max(NetUpdateRate, 1.0f), SnapshotInterpolation);
+		bLerpingPosition = true;
+    }
+    else if (bSmoothReplicatedMotion)
     {
         if (bReppedOnce)
         {
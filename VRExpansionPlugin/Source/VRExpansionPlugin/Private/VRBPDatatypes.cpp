@@ -97,10 +97,179 @@ bool FTransform_NetQuantize::NetSerialize(FArchive& Ar, class UPackageMap* Map,
 
 // ** Euro Low Pass Filter ** //
 
+namespace VREuroFilter
+{
+	static FORCEINLINE void FilterBlock(const double* Raw, double* Out, double* PreviousRaw, double* PreviousDelta, double* Previous, const VectorRegister4Double& FirstMask,
+		const VectorRegister4Double& MinCutoff, const VectorRegister4Double& CutoffSlope, const VectorRegister4Double& DeltaCutoff, const VectorRegister4Double& TwoPiDeltaTime, const VectorRegister4Double& Frequency)
+	{
+		const VectorRegister4Double One = VectorOneDouble();
+		const VectorRegister4Double RawValue = VectorLoad(Raw);
+		const VectorRegister4Double LastRaw = VectorLoad(PreviousRaw);
+		const VectorRegister4Double LastDelta = VectorLoad(PreviousDelta);
+		const VectorRegister4Double LastValue = VectorLoad(Previous);
+
+		// Calculate the delta, if this is the first time then there is no delta
+		const VectorRegister4Double Delta = VectorSelect(FirstMask, VectorZeroDouble(), VectorMultiply(VectorSubtract(RawValue, LastRaw), Frequency));
+
+		// Alpha is 1 / (1 + tau / dt) with tau = 1 / (2 * PI * cutoff), rearranged to x / (x + 1) with x = 2 * PI * cutoff * dt
+		const VectorRegister4Double DeltaX = VectorMultiply(DeltaCutoff, TwoPiDeltaTime);
+		const VectorRegister4Double DeltaAlpha = VectorDivide(DeltaX, VectorAdd(DeltaX, One));
+
+		// Filter the delta to get the estimated
+		const VectorRegister4Double Estimated = VectorSelect(FirstMask, Delta, VectorMultiplyAdd(DeltaAlpha, VectorSubtract(Delta, LastDelta), LastDelta));
+
+		// Use the estimated to calculate the cutoff
+		const VectorRegister4Double Cutoff = VectorMultiplyAdd(CutoffSlope, VectorAbs(Estimated), MinCutoff);
+		const VectorRegister4Double X = VectorMultiply(Cutoff, TwoPiDeltaTime);
+		const VectorRegister4Double Alpha = VectorDivide(X, VectorAdd(X, One));
+
+		// Filter passed value
+		const VectorRegister4Double Result = VectorSelect(FirstMask, RawValue, VectorMultiplyAdd(Alpha, VectorSubtract(RawValue, LastValue), LastValue));
+
+		VectorStore(RawValue, PreviousRaw);
+		VectorStore(Estimated, PreviousDelta);
+		VectorStore(Result, Previous);
+		VectorStore(Result, Out);
+	}
+
+	void FilterLanesUniform(const double* Raw, double* Out, double* PreviousRaw, double* PreviousDelta, double* Previous, bool bFirstTime,
+		float MinCutoff, float CutoffSlope, float DeltaCutoff, int32 NumLanes, float DeltaTime)
+	{
+		check(NumLanes % 4 == 0);
+
+		if (DeltaTime <= 0.0f)
+		{
+			// Invalid delta time, return the in values
+			if (Out != Raw)
+			{
+				FMemory::Memcpy(Out, Raw, NumLanes * sizeof(double));
+			}
+			return;
+		}
+
+		const VectorRegister4Double FirstMask = bFirstTime ? VectorCompareEQ(VectorZeroDouble(), VectorZeroDouble()) : VectorZeroDouble();
+		const VectorRegister4Double MinCutoffV = VectorSetFloat1((double)MinCutoff);
+		const VectorRegister4Double CutoffSlopeV = VectorSetFloat1((double)CutoffSlope);
+		const VectorRegister4Double DeltaCutoffV = VectorSetFloat1((double)DeltaCutoff);
+		const VectorRegister4Double TwoPiDeltaTime = VectorSetFloat1(2.0 * UE_DOUBLE_PI * DeltaTime);
+		const VectorRegister4Double Frequency = VectorSetFloat1(1.0 / DeltaTime);
+
+		for (int32 Lane = 0; Lane < NumLanes; Lane += 4)
+		{
+			FilterBlock(Raw + Lane, Out + Lane, PreviousRaw + Lane, PreviousDelta + Lane, Previous + Lane, FirstMask,
+				MinCutoffV, CutoffSlopeV, DeltaCutoffV, TwoPiDeltaTime, Frequency);
+		}
+	}
+
+	void FilterLanes(const double* Raw, double* Out, double* PreviousRaw, double* PreviousDelta, double* Previous, double* FirstTime, double* Pending,
+		const double* MinCutoff, const double* CutoffSlope, const double* DeltaCutoff, int32 NumLanes, float DeltaTime)
+	{
+		check(NumLanes % 4 == 0);
+
+		const bool bValidDeltaTime = DeltaTime > 0.0f;
+		const VectorRegister4Double FirstMask = VectorCompareEQ(VectorZeroDouble(), VectorZeroDouble());
+		const VectorRegister4Double TwoPiDeltaTime = VectorSetFloat1(2.0 * UE_DOUBLE_PI * DeltaTime);
+		const VectorRegister4Double Frequency = VectorSetFloat1(bValidDeltaTime ? 1.0 / DeltaTime : 0.0);
+
+		for (int32 Lane = 0; Lane < NumLanes; Lane += 4)
+		{
+			// Blocks never span two values, so the flags are the same for all four lanes
+			if (Pending[Lane] == 0.0)
+			{
+				continue;
+			}
+
+			if (bValidDeltaTime)
+			{
+				FilterBlock(Raw + Lane, Out + Lane, PreviousRaw + Lane, PreviousDelta + Lane, Previous + Lane, FirstTime[Lane] != 0.0 ? FirstMask : VectorZeroDouble(),
+					VectorLoad(MinCutoff + Lane), VectorLoad(CutoffSlope + Lane), VectorLoad(DeltaCutoff + Lane), TwoPiDeltaTime, Frequency);
+				VectorStore(VectorZeroDouble(), FirstTime + Lane);
+			}
+			else
+			{
+				// Invalid delta time, return the in values
+				FMemory::Memcpy(Out + Lane, Raw + Lane, 4 * sizeof(double));
+			}
+
+			VectorStore(VectorZeroDouble(), Pending + Lane);
+		}
+	}
+
+	// Flips a quat to the same hemisphere as the last filtered one, fixes axial flipping, from unity open 1 Euro implementation
+	static FORCEINLINE FQuat FixQuatFlip(const double* PreviousQuat, const FQuat& InRawValue)
+	{
+		FVector4 PrevQuatAsVector(PreviousQuat[0], PreviousQuat[1], PreviousQuat[2], PreviousQuat[3]);
+		FVector4 CurrQuatAsVector(InRawValue.X, InRawValue.Y, InRawValue.Z, InRawValue.W);
+		if ((PrevQuatAsVector - CurrQuatAsVector).SizeSquared() > 2)
+			return FQuat(-InRawValue.X, -InRawValue.Y, -InRawValue.Z, -InRawValue.W);
+
+		return InRawValue;
+	}
+
+	// Lane layouts shared by the filter structs and the bank, transforms are location, rotation, scale
+	static FORCEINLINE void PackVector(const FVector& InValue, double* Lanes)
+	{
+		Lanes[0] = InValue.X;
+		Lanes[1] = InValue.Y;
+		Lanes[2] = InValue.Z;
+	}
+
+	static FORCEINLINE void PackQuat(const FQuat& InValue, double* Lanes)
+	{
+		Lanes[0] = InValue.X;
+		Lanes[1] = InValue.Y;
+		Lanes[2] = InValue.Z;
+		Lanes[3] = InValue.W;
+	}
+
+	static FORCEINLINE void PackTransform(const FTransform& InValue, const FQuat& FlippedRotation, double* Lanes)
+	{
+		PackVector(InValue.GetLocation(), Lanes);
+		PackQuat(FlippedRotation, Lanes + 3);
+		PackVector(InValue.GetScale3D(), Lanes + 7);
+	}
+
+	static FORCEINLINE FTransform UnpackTransform(const double* Lanes)
+	{
+		FTransform NewTrans(FQuat(Lanes[3], Lanes[4], Lanes[5], Lanes[6]), FVector(Lanes[0], Lanes[1], Lanes[2]), FVector(Lanes[7], Lanes[8], Lanes[9]));
+		NewTrans.NormalizeRotation();
+		return NewTrans;
+	}
+
+	// Moves the inline history of a filter struct into a newly added bank value
+	template<int32 NumValueLanes>
+	static void BindLanes(TVREuroFilterLanes<NumValueLanes>& Lanes, FVREuroLowPassFilterBank* Bank, int32 Handle)
+	{
+		Bank->WriteState(Handle, Lanes.PreviousRaw, Lanes.PreviousDelta, Lanes.Previous, Lanes.bFirstTime);
+		Lanes.Bank = Bank;
+		Lanes.BankHandle = Handle;
+	}
+
+	// Moves the history of the bound value back inline and frees the value
+	template<int32 NumValueLanes>
+	static void UnbindLanes(TVREuroFilterLanes<NumValueLanes>& Lanes)
+	{
+		if (!Lanes.IsBound())
+		{
+			return;
+		}
+
+		Lanes.Bank->ReadState(Lanes.BankHandle, Lanes.PreviousRaw, Lanes.PreviousDelta, Lanes.Previous, Lanes.bFirstTime);
+		Lanes.Bank->RemoveValue(Lanes.BankHandle);
+		Lanes.Bank = nullptr;
+		Lanes.BankHandle = INDEX_NONE;
+	}
+}
+
 void FBPEuroLowPassFilter::ResetSmoothingFilter()
 {
-	RawFilter.bFirstTime = true;
-	DeltaFilter.bFirstTime = true;
+	if (Lanes.IsBound())
+	{
+		Lanes.Bank->ResetValue(Lanes.BankHandle);
+		return;
+	}
+
+	Lanes.bFirstTime = true;
 }
 
 FVector FBPEuroLowPassFilter::RunFilterSmoothing(const FVector &InRawValue, const float &InDeltaTime)
@@ -111,23 +280,62 @@ FVector FBPEuroLowPassFilter::RunFilterSmoothing(const FVector &InRawValue, cons
 		return InRawValue;
 	}
 
-	// Calculate the delta, if this is the first time then there is no delta
-	const FVector Delta = RawFilter.bFirstTime == true ? FVector::ZeroVector : (InRawValue - RawFilter.PreviousRaw) * 1.0f / InDeltaTime;
+	if (Lanes.IsBound())
+	{
+		SetBankInput(InRawValue);
+		Lanes.Bank->FilterValue(Lanes.BankHandle, InDeltaTime);
+		return GetBankOutput();
+	}
+
+	double Value[decltype(Lanes)::NumLanes] = { 0.0 };
+	VREuroFilter::PackVector(InRawValue, Value);
+	Lanes.Filter(Value, MinCutoff, CutoffSlope, DeltaCutoff, InDeltaTime);
+	return FVector(Value[0], Value[1], Value[2]);
+}
 
-	// Filter the delta to get the estimated
-	const FVector Estimated = DeltaFilter.Filter(Delta, FVector(DeltaFilter.CalculateAlphaTau(DeltaCutoff, InDeltaTime)));
+void FBPEuroLowPassFilter::BindToBank(FVREuroLowPassFilterBank* InBank)
+{
+	if (Lanes.Bank == InBank)
+	{
+		return;
+	}
 
-	// Use the estimated to calculate the cutoff
-	const FVector Cutoff = DeltaFilter.CalculateCutoff(Estimated, MinCutoff, CutoffSlope);
+	UnbindFromBank();
 
-	// Filter passed value 
-	return RawFilter.Filter(InRawValue, RawFilter.CalculateAlpha(Cutoff, InDeltaTime));
+	if (InBank)
+	{
+		VREuroFilter::BindLanes(Lanes, InBank, InBank->AddVector(MinCutoff, CutoffSlope, DeltaCutoff));
+	}
+}
+
+void FBPEuroLowPassFilter::UnbindFromBank()
+{
+	VREuroFilter::UnbindLanes(Lanes);
+}
+
+void FBPEuroLowPassFilter::SetBankInput(const FVector& InRawValue)
+{
+	if (Lanes.IsBound())
+	{
+		Lanes.Bank->SetSettings(Lanes.BankHandle, MinCutoff, CutoffSlope, DeltaCutoff);
+		Lanes.Bank->SetVector(Lanes.BankHandle, InRawValue);
+	}
+}
+
+FVector FBPEuroLowPassFilter::GetBankOutput() const
+{
+	return Lanes.IsBound() ? Lanes.Bank->GetVector(Lanes.BankHandle) : FVector(Lanes.Previous[0], Lanes.Previous[1], Lanes.Previous[2]);
 }
 
 void FBPEuroLowPassFilterQuat::ResetSmoothingFilter()
 {
-	RawFilter.bFirstTime = true;
-	DeltaFilter.bFirstTime = true;
+	if (Lanes.IsBound())
+	{
+		Lanes.Bank->ResetValue(Lanes.BankHandle);
+		return;
+	}
+
+	Lanes.bFirstTime = true;
 }
 
 FQuat FBPEuroLowPassFilterQuat::RunFilterSmoothing(const FQuat& InRawValue, const float& InDeltaTime)
@@ -138,40 +346,64 @@ FQuat FBPEuroLowPassFilterQuat::RunFilterSmoothing(const FQuat& InRawValue, cons
 		return InRawValue;
 	}
 
-	FQuat NewInVal = InRawValue;
-	if (!RawFilter.bFirstTime)
+	if (Lanes.IsBound())
 	{
-		// fix axial flipping, from unity open 1 Euro implementation
-		FVector4 PrevQuatAsVector(RawFilter.Previous.X, RawFilter.Previous.Y, RawFilter.Previous.Z, RawFilter.Previous.W);
-		FVector4 CurrQuatAsVector(InRawValue.X, InRawValue.Y, InRawValue.Z, InRawValue.W);
-		if ((PrevQuatAsVector - CurrQuatAsVector).SizeSquared() > 2)
-			NewInVal = FQuat(-InRawValue.X, -InRawValue.Y, -InRawValue.Z, -InRawValue.W);
+		SetBankInput(InRawValue);
+		Lanes.Bank->FilterValue(Lanes.BankHandle, InDeltaTime);
+		return GetBankOutput();
 	}
 
-	// Calculate the delta, if this is the first time then there is no delta
-	FQuat Delta = FQuat::Identity;
+	const FQuat NewInVal = Lanes.bFirstTime ? InRawValue : VREuroFilter::FixQuatFlip(Lanes.Previous, InRawValue);
+
+	double Value[decltype(Lanes)::NumLanes];
+	VREuroFilter::PackQuat(NewInVal, Value);
+	Lanes.Filter(Value, MinCutoff, CutoffSlope, DeltaCutoff, InDeltaTime);
+	return FQuat(Value[0], Value[1], Value[2], Value[3]).GetNormalized();
+}
 
-	if (!RawFilter.bFirstTime)
+void FBPEuroLowPassFilterQuat::BindToBank(FVREuroLowPassFilterBank* InBank)
+{
+	if (Lanes.Bank == InBank)
 	{
-		Delta = (NewInVal - RawFilter.PreviousRaw) * (1.0f / InDeltaTime);
+		return;
 	}
 
+	UnbindFromBank();
 
-	float AlphaTau = DeltaFilter.CalculateAlphaTau(DeltaCutoff, InDeltaTime);
-	FQuat AlphaTauQ(AlphaTau, AlphaTau, AlphaTau, AlphaTau);
-	const FQuat Estimated = DeltaFilter.Filter(Delta, AlphaTauQ);
+	if (InBank)
+	{
+		VREuroFilter::BindLanes(Lanes, InBank, InBank->AddQuat(MinCutoff, CutoffSlope, DeltaCutoff));
+	}
+}
 
-	// Use the estimated to calculate the cutoff
-	const FQuat Cutoff = DeltaFilter.CalculateCutoff(Estimated, MinCutoff, CutoffSlope);
+void FBPEuroLowPassFilterQuat::UnbindFromBank()
+{
+	VREuroFilter::UnbindLanes(Lanes);
+}
 
-	// Filter passed value 
-	return RawFilter.Filter(NewInVal, RawFilter.CalculateAlpha(Cutoff, InDeltaTime)).GetNormalized();// .GetNormalized();
+void FBPEuroLowPassFilterQuat::SetBankInput(const FQuat& InRawValue)
+{
+	if (Lanes.IsBound())
+	{
+		Lanes.Bank->SetSettings(Lanes.BankHandle, MinCutoff, CutoffSlope, DeltaCutoff);
+		Lanes.Bank->SetQuat(Lanes.BankHandle, InRawValue);
+	}
+}
+
+FQuat FBPEuroLowPassFilterQuat::GetBankOutput() const
+{
+	return Lanes.IsBound() ? Lanes.Bank->GetQuat(Lanes.BankHandle) : FQuat(Lanes.Previous[0], Lanes.Previous[1], Lanes.Previous[2], Lanes.Previous[3]).GetNormalized();
 }
 
 void FBPEuroLowPassFilterTrans::ResetSmoothingFilter()
 {
-	RawFilter.bFirstTime = true;
-	DeltaFilter.bFirstTime = true;
+	if (Lanes.IsBound())
+	{
+		Lanes.Bank->ResetValue(Lanes.BankHandle);
+		return;
+	}
+
+	Lanes.bFirstTime = true;
 }
 
 FTransform FBPEuroLowPassFilterTrans::RunFilterSmoothing(const FTransform& InRawValue, const float& InDeltaTime)
@@ -182,39 +414,376 @@ FTransform FBPEuroLowPassFilterTrans::RunFilterSmoothing(const FTransform& InRaw
 		return InRawValue;
 	}
 
-	FTransform NewInVal = InRawValue;
-	if (!RawFilter.bFirstTime)
+	if (Lanes.IsBound())
 	{
-		FQuat TransQ = NewInVal.GetRotation();
-		FQuat PrevQ = RawFilter.Previous.GetRotation();
-		// fix axial flipping, from unity open 1 Euro implementation
-		FVector4 PrevQuatAsVector(PrevQ.X, PrevQ.Y, PrevQ.Z, PrevQ.W);
-		FVector4 CurrQuatAsVector(TransQ.X, TransQ.Y, TransQ.Z, TransQ.W);
-		if ((PrevQuatAsVector - CurrQuatAsVector).SizeSquared() > 2)
-			NewInVal.SetRotation(FQuat(-TransQ.X, -TransQ.Y, -TransQ.Z, -TransQ.W));
+		SetBankInput(InRawValue);
+		Lanes.Bank->FilterValue(Lanes.BankHandle, InDeltaTime);
+		return GetBankOutput();
 	}
 
-	// Calculate the delta, if this is the first time then there is no delta
-	FTransform Delta = FTransform::Identity;
+	// Lanes are location, rotation, scale
+	const FQuat Rotation = Lanes.bFirstTime ? InRawValue.GetRotation() : VREuroFilter::FixQuatFlip(&Lanes.Previous[3], InRawValue.GetRotation());
+
+	double Value[decltype(Lanes)::NumLanes] = { 0.0 };
+	VREuroFilter::PackTransform(InRawValue, Rotation, Value);
+	Lanes.Filter(Value, MinCutoff, CutoffSlope, DeltaCutoff, InDeltaTime);
+
+	// Filter passed value 
+	return VREuroFilter::UnpackTransform(Value);
+}
 
-	float Frequency = 1.0f / InDeltaTime;
-	if (!RawFilter.bFirstTime)
+void FBPEuroLowPassFilterTrans::BindToBank(FVREuroLowPassFilterBank* InBank)
+{
+	if (Lanes.Bank == InBank)
 	{
-		Delta.SetLocation((NewInVal.GetLocation() - RawFilter.PreviousRaw.GetLocation()) * Frequency);
-		Delta.SetRotation((NewInVal.GetRotation() - RawFilter.PreviousRaw.GetRotation()) * Frequency);
-		Delta.SetScale3D((NewInVal.GetScale3D() - RawFilter.PreviousRaw.GetScale3D()) * Frequency);
+		return;
 	}
 
+	UnbindFromBank();
 
-	float AlphaTau = DeltaFilter.CalculateAlphaTau(DeltaCutoff, InDeltaTime);
-	FTransform AlphaTauQ(FQuat(AlphaTau, AlphaTau, AlphaTau, AlphaTau), FVector(AlphaTau), FVector(AlphaTau));
-	const FTransform Estimated = DeltaFilter.Filter(Delta, AlphaTauQ);
+	if (InBank)
+	{
+		VREuroFilter::BindLanes(Lanes, InBank, InBank->AddTransform(MinCutoff, CutoffSlope, DeltaCutoff));
+	}
+}
 
-	// Use the estimated to calculate the cutoff
-	const FTransform Cutoff = DeltaFilter.CalculateCutoff(Estimated, MinCutoff, CutoffSlope);
+void FBPEuroLowPassFilterTrans::UnbindFromBank()
+{
+	VREuroFilter::UnbindLanes(Lanes);
+}
 
-	FTransform NewTrans = RawFilter.Filter(NewInVal, RawFilter.CalculateAlpha(Cutoff, InDeltaTime));
-	NewTrans.NormalizeRotation();
-	// Filter passed value 
-	return NewTrans;
+void FBPEuroLowPassFilterTrans::SetBankInput(const FTransform& InRawValue)
+{
+	if (Lanes.IsBound())
+	{
+		Lanes.Bank->SetSettings(Lanes.BankHandle, MinCutoff, CutoffSlope, DeltaCutoff);
+		Lanes.Bank->SetTransform(Lanes.BankHandle, InRawValue);
+	}
+}
+
+FTransform FBPEuroLowPassFilterTrans::GetBankOutput() const
+{
+	return Lanes.IsBound() ? Lanes.Bank->GetTransform(Lanes.BankHandle) : VREuroFilter::UnpackTransform(Lanes.Previous);
+}
+
+int32 FVREuroLowPassFilterBank::AddValue(EValueType ValueType, int32 NumValueLanes, float MinCutoff, float CutoffSlope, float DeltaCutoff)
+{
+	// Values are padded to full blocks so that every block belongs to a single value
+	const int32 NumLanes = Align(NumValueLanes, 4);
+
+	int32 Handle = INDEX_NONE;
+	for (int32 FreeIndex = 0; FreeIndex < FreeValues.Num(); ++FreeIndex)
+	{
+		if (Values[FreeValues[FreeIndex]].NumLanes == NumLanes)
+		{
+			Handle = FreeValues[FreeIndex];
+			FreeValues.RemoveAtSwap(FreeIndex);
+			break;
+		}
+	}
+
+	if (Handle == INDEX_NONE)
+	{
+		Handle = Values.AddDefaulted();
+		Values[Handle].FirstLane = NumUsedLanes;
+		Values[Handle].NumLanes = NumLanes;
+
+		NumUsedLanes += NumLanes;
+
+		TArray<double>* LaneArrays[] = { &Raw, &Out, &PreviousRaw, &PreviousDelta, &Previous, &FirstTime, &Pending, &MinCutoffs, &CutoffSlopes, &DeltaCutoffs };
+		for (TArray<double>* LaneArray : LaneArrays)
+		{
+			LaneArray->SetNumZeroed(NumUsedLanes);
+		}
+	}
+
+	FValueInfo& Info = Values[Handle];
+	Info.ValueType = ValueType;
+	Info.bInUse = true;
+
+	// Clear anything a freed value left behind
+	TArray<double>* StateArrays[] = { &Raw, &Out, &PreviousRaw, &PreviousDelta, &Previous, &Pending };
+	for (TArray<double>* StateArray : StateArrays)
+	{
+		FMemory::Memzero(&(*StateArray)[Info.FirstLane], Info.NumLanes * sizeof(double));
+	}
+
+	SetSettings(Handle, MinCutoff, CutoffSlope, DeltaCutoff);
+	ResetValue(Handle);
+	return Handle;
+}
+
+int32 FVREuroLowPassFilterBank::AddVector(float MinCutoff, float CutoffSlope, float DeltaCutoff)
+{
+	return AddValue(EValueType::Vector, 3, MinCutoff, CutoffSlope, DeltaCutoff);
+}
+
+int32 FVREuroLowPassFilterBank::AddQuat(float MinCutoff, float CutoffSlope, float DeltaCutoff)
+{
+	const int32 Handle = AddValue(EValueType::Quat, 4, MinCutoff, CutoffSlope, DeltaCutoff);
+	VREuroFilter::PackQuat(FQuat::Identity, &Out[Values[Handle].FirstLane]);
+	return Handle;
+}
+
+int32 FVREuroLowPassFilterBank::AddTransform(float MinCutoff, float CutoffSlope, float DeltaCutoff)
+{
+	const int32 Handle = AddValue(EValueType::Transform, 10, MinCutoff, CutoffSlope, DeltaCutoff);
+	VREuroFilter::PackTransform(FTransform::Identity, FQuat::Identity, &Out[Values[Handle].FirstLane]);
+	return Handle;
+}
+
+void FVREuroLowPassFilterBank::RemoveValue(int32 Handle)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	FValueInfo& Info = Values[Handle];
+	Info.bInUse = false;
+	FMemory::Memzero(&Pending[Info.FirstLane], Info.NumLanes * sizeof(double));
+	FreeValues.Add(Handle);
+}
+
+void FVREuroLowPassFilterBank::SetSettings(int32 Handle, float MinCutoff, float CutoffSlope, float DeltaCutoff)
+{
+	const FValueInfo& Info = Values[Handle];
+	for (int32 Lane = Info.FirstLane; Lane < Info.FirstLane + Info.NumLanes; ++Lane)
+	{
+		MinCutoffs[Lane] = MinCutoff;
+		CutoffSlopes[Lane] = CutoffSlope;
+		DeltaCutoffs[Lane] = DeltaCutoff;
+	}
+}
+
+void FVREuroLowPassFilterBank::MarkPending(const FValueInfo& Info)
+{
+	for (int32 Lane = Info.FirstLane; Lane < Info.FirstLane + Info.NumLanes; ++Lane)
+	{
+		Pending[Lane] = 1.0;
+	}
+}
+
+void FVREuroLowPassFilterBank::SetVector(int32 Handle, const FVector& InRawValue)
+{
+	const FValueInfo& Info = Values[Handle];
+	checkSlow(Info.bInUse && Info.ValueType == EValueType::Vector);
+
+	VREuroFilter::PackVector(InRawValue, &Raw[Info.FirstLane]);
+	MarkPending(Info);
+}
+
+void FVREuroLowPassFilterBank::SetQuat(int32 Handle, const FQuat& InRawValue)
+{
+	const FValueInfo& Info = Values[Handle];
+	checkSlow(Info.bInUse && Info.ValueType == EValueType::Quat);
+
+	const FQuat NewInVal = FirstTime[Info.FirstLane] != 0.0 ? InRawValue : VREuroFilter::FixQuatFlip(&Previous[Info.FirstLane], InRawValue);
+	VREuroFilter::PackQuat(NewInVal, &Raw[Info.FirstLane]);
+	MarkPending(Info);
+}
+
+void FVREuroLowPassFilterBank::SetTransform(int32 Handle, const FTransform& InRawValue)
+{
+	const FValueInfo& Info = Values[Handle];
+	checkSlow(Info.bInUse && Info.ValueType == EValueType::Transform);
+
+	const FQuat Rotation = FirstTime[Info.FirstLane] != 0.0 ? InRawValue.GetRotation() : VREuroFilter::FixQuatFlip(&Previous[Info.FirstLane + 3], InRawValue.GetRotation());
+	VREuroFilter::PackTransform(InRawValue, Rotation, &Raw[Info.FirstLane]);
+	MarkPending(Info);
+}
+
+FVector FVREuroLowPassFilterBank::GetVector(int32 Handle) const
+{
+	const FValueInfo& Info = Values[Handle];
+	checkSlow(Info.ValueType == EValueType::Vector);
+
+	const double* Lanes = &Out[Info.FirstLane];
+	return FVector(Lanes[0], Lanes[1], Lanes[2]);
+}
+
+FQuat FVREuroLowPassFilterBank::GetQuat(int32 Handle) const
+{
+	const FValueInfo& Info = Values[Handle];
+	checkSlow(Info.ValueType == EValueType::Quat);
+
+	const double* Lanes = &Out[Info.FirstLane];
+	return FQuat(Lanes[0], Lanes[1], Lanes[2], Lanes[3]).GetNormalized();
+}
+
+FTransform FVREuroLowPassFilterBank::GetTransform(int32 Handle) const
+{
+	const FValueInfo& Info = Values[Handle];
+	checkSlow(Info.ValueType == EValueType::Transform);
+
+	return VREuroFilter::UnpackTransform(&Out[Info.FirstLane]);
+}
+
+void FVREuroLowPassFilterBank::ResetValue(int32 Handle)
+{
+	const FValueInfo& Info = Values[Handle];
+	for (int32 Lane = Info.FirstLane; Lane < Info.FirstLane + Info.NumLanes; ++Lane)
+	{
+		FirstTime[Lane] = 1.0;
+	}
+}
+
+void FVREuroLowPassFilterBank::ReadState(int32 Handle, double* OutPreviousRaw, double* OutPreviousDelta, double* OutPrevious, bool& bOutFirstTime) const
+{
+	const FValueInfo& Info = Values[Handle];
+	FMemory::Memcpy(OutPreviousRaw, &PreviousRaw[Info.FirstLane], Info.NumLanes * sizeof(double));
+	FMemory::Memcpy(OutPreviousDelta, &PreviousDelta[Info.FirstLane], Info.NumLanes * sizeof(double));
+	FMemory::Memcpy(OutPrevious, &Previous[Info.FirstLane], Info.NumLanes * sizeof(double));
+	bOutFirstTime = FirstTime[Info.FirstLane] != 0.0;
+}
+
+void FVREuroLowPassFilterBank::WriteState(int32 Handle, const double* InPreviousRaw, const double* InPreviousDelta, const double* InPrevious, bool bInFirstTime)
+{
+	const FValueInfo& Info = Values[Handle];
+	FMemory::Memcpy(&PreviousRaw[Info.FirstLane], InPreviousRaw, Info.NumLanes * sizeof(double));
+	FMemory::Memcpy(&PreviousDelta[Info.FirstLane], InPreviousDelta, Info.NumLanes * sizeof(double));
+	FMemory::Memcpy(&Previous[Info.FirstLane], InPrevious, Info.NumLanes * sizeof(double));
+	FMemory::Memcpy(&Out[Info.FirstLane], InPrevious, Info.NumLanes * sizeof(double));
+
+	for (int32 Lane = Info.FirstLane; Lane < Info.FirstLane + Info.NumLanes; ++Lane)
+	{
+		FirstTime[Lane] = bInFirstTime ? 1.0 : 0.0;
+	}
+}
+
+void FVREuroLowPassFilterBank::Empty()
+{
+	Values.Reset();
+	FreeValues.Reset();
+
+	TArray<double>* LaneArrays[] = { &Raw, &Out, &PreviousRaw, &PreviousDelta, &Previous, &FirstTime, &Pending, &MinCutoffs, &CutoffSlopes, &DeltaCutoffs };
+	for (TArray<double>* LaneArray : LaneArrays)
+	{
+		LaneArray->Reset();
+	}
+
+	NumUsedLanes = 0;
+}
+
+void FVREuroLowPassFilterBank::Filter(float DeltaTime)
+{
+	if (NumUsedLanes <= 0)
+		return;
+
+	VREuroFilter::FilterLanes(Raw.GetData(), Out.GetData(), PreviousRaw.GetData(), PreviousDelta.GetData(), Previous.GetData(), FirstTime.GetData(), Pending.GetData(),
+		MinCutoffs.GetData(), CutoffSlopes.GetData(), DeltaCutoffs.GetData(), NumUsedLanes, DeltaTime);
+}
+
+void FVREuroLowPassFilterBank::FilterValue(int32 Handle, float DeltaTime)
+{
+	const FValueInfo& Info = Values[Handle];
+	const int32 Lane = Info.FirstLane;
+
+	VREuroFilter::FilterLanes(&Raw[Lane], &Out[Lane], &PreviousRaw[Lane], &PreviousDelta[Lane], &Previous[Lane], &FirstTime[Lane], &Pending[Lane],
+		&MinCutoffs[Lane], &CutoffSlopes[Lane], &DeltaCutoffs[Lane], Info.NumLanes, DeltaTime);
+}
+
+void FVRSnapshotBuffer::AddSnapshot(const FVector& Position, const FRotator& Rotation, double ArrivalTime, float ExpectedInterval, const FBPVRSnapshotInterpolationSettings& Settings)
+{
+	if (LastArrivalTime < 0.0)
+	{
+		MeanInterval = ExpectedInterval;
+		IntervalVariance = 0.0f;
+	}
+	else
+	{
+		// Exponentially weighted mean and variance of the time between arrivals
+		const float Alpha = 0.1f;
+		const float Interval = (float)(ArrivalTime - LastArrivalTime);
+		const float Diff = Interval - MeanInterval;
+		MeanInterval += Alpha * Diff;
+		IntervalVariance = (1.0f - Alpha) * (IntervalVariance + Alpha * Diff * Diff);
+	}
+
+	LastArrivalTime = ArrivalTime;
+
+	// Updates that arrive bunched together were still sampled roughly an interval apart, spread them back out
+	double SnapshotTime = ArrivalTime;
+	if (Snapshots.Num() > 0)
+	{
+		SnapshotTime = FMath::Max(SnapshotTime, Snapshots.Last().Time + ExpectedInterval * 0.5f);
+	}
+
+	FSnapshot& NewSnapshot = Snapshots.AddDefaulted_GetRef();
+	NewSnapshot.Time = SnapshotTime;
+	NewSnapshot.Position = Position;
+	NewSnapshot.Rotation = Rotation.Quaternion();
+
+	CurrentDelay = FMath::Clamp(MeanInterval + Settings.JitterDeviations * FMath::Sqrt(IntervalVariance), Settings.MinDelay, FMath::Max(Settings.MinDelay, Settings.MaxDelay));
+
+	// Drop anything older than the playback window, keeping a pair around for extrapolation
+	const double OldestNeeded = SnapshotTime - CurrentDelay - MeanInterval * 2.0f;
+	int32 NumToRemove = 0;
+	while (NumToRemove < Snapshots.Num() - 2 && Snapshots[NumToRemove + 1].Time < OldestNeeded)
+	{
+		NumToRemove++;
+	}
+
+	NumToRemove = FMath::Max(NumToRemove, Snapshots.Num() - 64);
+	if (NumToRemove > 0)
+	{
+		Snapshots.RemoveAt(0, NumToRemove, false);
+	}
+}
+
+bool FVRSnapshotBuffer::Sample(double CurrentTime, const FBPVRSnapshotInterpolationSettings& Settings, FVector& OutPosition, FRotator& OutRotation) const
+{
+	if (Snapshots.Num() == 0)
+		return false;
+
+	const double PlaybackTime = CurrentTime - CurrentDelay;
+
+	if (PlaybackTime <= Snapshots[0].Time)
+	{
+		OutPosition = Snapshots[0].Position;
+		OutRotation = Snapshots[0].Rotation.Rotator();
+		return true;
+	}
+
+	const int32 LastIndex = Snapshots.Num() - 1;
+	for (int32 i = 0; i < LastIndex; i++)
+	{
+		const FSnapshot& From = Snapshots[i];
+		const FSnapshot& To = Snapshots[i + 1];
+
+		if (PlaybackTime < To.Time)
+		{
+			const float Alpha = (float)((PlaybackTime - From.Time) / FMath::Max(To.Time - From.Time, UE_SMALL_NUMBER));
+			OutPosition = FMath::Lerp(From.Position, To.Position, Alpha);
+			OutRotation = FQuat::Slerp(From.Rotation, To.Rotation, Alpha).Rotator();
+			return true;
+		}
+	}
+
+	// Newest update is late, carry on with the last known velocity for a short while
+	const FSnapshot& Last = Snapshots[LastIndex];
+	OutPosition = Last.Position;
+	OutRotation = Last.Rotation.Rotator();
+
+	if (LastIndex > 0 && Settings.MaxExtrapolationTime > 0.0f)
+	{
+		const FSnapshot& Prev = Snapshots[LastIndex - 1];
+		const double SnapshotDelta = Last.Time - Prev.Time;
+
+		if (SnapshotDelta > UE_SMALL_NUMBER)
+		{
+			const float Ratio = (float)(FMath::Min(PlaybackTime - Last.Time, (double)Settings.MaxExtrapolationTime) / SnapshotDelta);
+			OutPosition = Last.Position + (Last.Position - Prev.Position) * Ratio;
+
+			FQuat DeltaRot = Last.Rotation * Prev.Rotation.Inverse();
+			DeltaRot.EnforceShortestArcWith(FQuat::Identity);
+
+			FVector Axis;
+			float Angle;
+			DeltaRot.ToAxisAndAngle(Axis, Angle);
+			OutRotation = (FQuat(Axis, Angle * Ratio) * Last.Rotation).Rotator();
+		}
+	}
+
+	return true;
 }
@@ -138,6 +138,17 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
 	// Otherwise we will get some massive slow downs if the replication is allowed to hit the 2 per second minimum default
 	MinNetUpdateFrequency = 100.0f;
 
+	bUseBundledPosePacket = false;
+	PosePacketNetUpdateRate = 100.0f;
+	PosePacketNetUpdateCount = 0.0f;
+	NextPosePacketSequence = 0;
+	LastAppliedPosePacketSequence = 0;
+	bHasAppliedPosePacket = false;
+
+	PosePacketTickFunction.TickGroup = TG_PrePhysics;
+	PosePacketTickFunction.bCanEverTick = true;
+	PosePacketTickFunction.bStartWithTickEnabled = true;
+
 	// This is for smooth turning, we have more of a use for this than FPS characters do
 	// Due to roll/pitch almost never being off 0 for VR the cost is just one byte so i'm fine defaulting it here
 	// End users can reset to byte components if they ever want too.
@@ -158,12 +169,19 @@ AVRBaseCharacter::AVRBaseCharacter(const FObjectInitializer& ObjectInitializer)
  {
 	 Super::PossessedBy(NewController);
 	 OwningVRPlayerController = Cast<AVRPlayerController>(Controller);
+
+	 // New owner, don't delta its moves against the last ones
+	 if (VRMovementReference)
+		 VRMovementReference->MoveDeltaHistory.Reset();
  }
 
 void AVRBaseCharacter::OnRep_Controller()
 {
 	Super::OnRep_Controller();
 	OwningVRPlayerController = Cast<AVRPlayerController>(Controller);
+
+	if (VRMovementReference)
+		VRMovementReference->MoveDeltaHistory.Reset();
 }
 
 void AVRBaseCharacter::OnRep_PlayerState()
@@ -345,6 +363,129 @@ bool AVRBaseCharacter::Server_SendTransformRightController_Validate(FBPVRCompone
 	return true;
 	// Optionally check to make sure that player is inside of their bounds and deny it if they aren't?
 }
+
+bool AVRBaseCharacter::IsBundlingPoseFor(const USceneComponent* Device) const
+{
+	if (!bUseBundledPosePacket || GetNetMode() != NM_Client)
+		return false;
+
+	return Device != nullptr && (Device == VRReplicatedCamera || Device == LeftMotionController || Device == RightMotionController);
+}
+
+void AVRBaseCharacter::RegisterActorTickFunctions(bool bRegister)
+{
+	Super::RegisterActorTickFunctions(bRegister);
+
+	if (bRegister)
+	{
+		// Only owning clients ever send the packet
+		if (PosePacketTickFunction.bCanEverTick && GetNetMode() == NM_Client && !PosePacketTickFunction.IsTickFunctionRegistered())
+		{
+			PosePacketTickFunction.Target = this;
+			PosePacketTickFunction.SetTickFunctionEnable(PosePacketTickFunction.bStartWithTickEnabled);
+			PosePacketTickFunction.RegisterTickFunction(GetLevel());
+
+			// Sample after every device has finished its tracking update for the frame
+			if (VRReplicatedCamera)
+				PosePacketTickFunction.AddPrerequisite(VRReplicatedCamera, VRReplicatedCamera->PrimaryComponentTick);
+
+			if (IsValid(LeftMotionController))
+				PosePacketTickFunction.AddPrerequisite(LeftMotionController, LeftMotionController->PrimaryComponentTick);
+
+			if (IsValid(RightMotionController))
+				PosePacketTickFunction.AddPrerequisite(RightMotionController, RightMotionController->PrimaryComponentTick);
+		}
+	}
+	else if (PosePacketTickFunction.IsTickFunctionRegistered())
+	{
+		PosePacketTickFunction.UnRegisterTickFunction();
+	}
+}
+
+void AVRBaseCharacter::TickPosePacket(float DeltaTime)
+{
+	if (!bUseBundledPosePacket || PosePacketNetUpdateRate <= 0.0f || !IsLocallyControlled())
+		return;
+
+	PosePacketNetUpdateCount += DeltaTime;
+	if (PosePacketNetUpdateCount < (1.0f / PosePacketNetUpdateRate))
+		return;
+
+	PosePacketNetUpdateCount = 0.0f;
+	OutgoingPosePacket.Reset();
+
+	auto SampleDevice = [this](EVRPosePacketDevice DeviceType, const FBPVRComponentPosRep& NewTransform)
+	{
+		const FBPVRComponentPosRep& LastSent = OutgoingPosePacket.Devices[(uint8)DeviceType];
+
+		// Don't rep if no changes
+		if (!NewTransform.Position.Equals(LastSent.Position) || !NewTransform.Rotation.Equals(LastSent.Rotation))
+		{
+			OutgoingPosePacket.SetDevice(DeviceType, NewTransform);
+		}
+	};
+
+	if (VRReplicatedCamera && VRReplicatedCamera->GetIsReplicated())
+		SampleDevice(EVRPosePacketDevice::Camera, VRReplicatedCamera->ReplicatedCameraTransform);
+
+	if (IsValid(LeftMotionController) && LeftMotionController->GetIsReplicated())
+		SampleDevice(EVRPosePacketDevice::LeftController, LeftMotionController->ReplicatedControllerTransform);
+
+	if (IsValid(RightMotionController) && RightMotionController->GetIsReplicated())
+		SampleDevice(EVRPosePacketDevice::RightController, RightMotionController->ReplicatedControllerTransform);
+
+	if (OutgoingPosePacket.DeviceFlags == 0)
+		return;
+
+	OutgoingPosePacket.Sequence = NextPosePacketSequence++;
+	Server_SendPosePacket(OutgoingPosePacket);
+}
+
+void AVRBaseCharacter::Server_SendPosePacket_Implementation(const FVRPosePacket& PosePacket)
+{
+	// Arrived out of order, the newer samples are already applied
+	if (bHasAppliedPosePacket && !PosePacket.IsNewerThan(LastAppliedPosePacketSequence))
+		return;
+
+	LastAppliedPosePacketSequence = PosePacket.Sequence;
+	bHasAppliedPosePacket = true;
+
+	// Go through the per device server calls so overrides of them still apply
+	if (PosePacket.HasDevice(EVRPosePacketDevice::Camera))
+		Server_SendTransformCamera_Implementation(PosePacket.Devices[(uint8)EVRPosePacketDevice::Camera]);
+
+	if (PosePacket.HasDevice(EVRPosePacketDevice::LeftController))
+		Server_SendTransformLeftController_Implementation(PosePacket.Devices[(uint8)EVRPosePacketDevice::LeftController]);
+
+	if (PosePacket.HasDevice(EVRPosePacketDevice::RightController))
+		Server_SendTransformRightController_Implementation(PosePacket.Devices[(uint8)EVRPosePacketDevice::RightController]);
+}
+
+bool AVRBaseCharacter::Server_SendPosePacket_Validate(const FVRPosePacket& PosePacket)
+{
+	return true;
+}
+
+void FVRPosePacketTickFunction::ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	QUICK_SCOPE_CYCLE_COUNTER(FVRPosePacketTickFunction_ExecuteTick);
+
+	if (Target && IsValid(Target) && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->TickPosePacket(DeltaTime * Target->CustomTimeDilation);
+	}
+}
+
+FString FVRPosePacketTickFunction::DiagnosticMessage()
+{
+	return TEXT("VRPosePacketTickFunction");
+}
+
+FName FVRPosePacketTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("VRPosePacketTick"));
+}
+
 FVector AVRBaseCharacter::GetTeleportLocation(FVector OriginalLocation)
 {	
 	return OriginalLocation;
@@ -408,6 +549,15 @@ void AVRBaseCharacter::OnRep_ReplicatedMovement()
 			NotifyOfTeleport(false);
 		}
 
+		if (bTrackingPaused != ReplicatedMovementVR.bPausedTracking)
+		{
+			// The paused pose doesn't come from the camera, so it can't wake a sleeping root on its own
+			if (UVRRootComponent* VRRoot = Cast<UVRRootComponent>(GetRootComponent()))
+			{
+				VRRoot->WakeRemoteTick();
+			}
+		}
+
 		bTrackingPaused = ReplicatedMovementVR.bPausedTracking;
 		if (bTrackingPaused)
 		{
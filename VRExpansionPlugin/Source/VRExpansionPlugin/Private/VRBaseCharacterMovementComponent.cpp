@@ -23,6 +23,35 @@
 
 DEFINE_LOG_CATEGORY(LogVRBaseCharacterMovement);
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char FloorCache Hits"), STAT_VRFloorCacheHits, STATGROUP_Character);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Char FloorCache Misses"), STAT_VRFloorCacheMisses, STATGROUP_Character);
+
+namespace VRBaseCharacterMovementCVars
+{
+	static int32 FloorCache = 0;
+	FAutoConsoleVariableRef CVarFloorCache(
+		TEXT("vre.FloorCache"),
+		FloorCache,
+		TEXT("When on, floor checks reuse a recent result while the capsule has barely moved and the floor component hasn't moved.\n")
+		TEXT("Geometry that appears under a still capsule isn't seen until the cached result expires, and client / server caches can differ.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+
+	static float FloorCacheTolerance = 0.5f;
+	FAutoConsoleVariableRef CVarFloorCacheTolerance(
+		TEXT("vre.FloorCache.Tolerance"),
+		FloorCacheTolerance,
+		TEXT("Distance in cm that the capsule can move on each axis and still reuse a cached floor result."),
+		ECVF_Default);
+
+	static int32 FloorCacheMaxFrames = 15;
+	FAutoConsoleVariableRef CVarFloorCacheMaxFrames(
+		TEXT("vre.FloorCache.MaxFrames"),
+		FloorCacheMaxFrames,
+		TEXT("Number of frames a cached floor result is reused for before a new sweep is forced, bounds how long new geometry under the character goes unnoticed."),
+		ECVF_Default);
+}
+
 UVRBaseCharacterMovementComponent::UVRBaseCharacterMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -503,6 +532,29 @@ void UVRBaseCharacterMovementComponent::OnMoveCompleted(FAIRequestID RequestID,
 }
 
 void UVRBaseCharacterMovementComponent::ComputeFloorDist(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, FFindFloorResult& OutFloorResult, float SweepRadius, const FHitResult* DownwardSweepResult) const
+{
+	if (!VRBaseCharacterMovementCVars::FloorCache)
+	{
+		ComputeFloorDist_Impl(CapsuleLocation, LineDistance, SweepDistance, OutFloorResult, SweepRadius, DownwardSweepResult);
+		return;
+	}
+
+	const float CapsuleHalfHeight = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+	// A supplied downward sweep is already free, teleports always get a fresh floor
+	if (!DownwardSweepResult && !bJustTeleported &&
+		FloorCache.Find(CapsuleLocation, LineDistance, SweepDistance, SweepRadius, CapsuleHalfHeight, VRBaseCharacterMovementCVars::FloorCacheTolerance, (uint64)FMath::Max(0, VRBaseCharacterMovementCVars::FloorCacheMaxFrames), OutFloorResult))
+	{
+		INC_DWORD_STAT(STAT_VRFloorCacheHits);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_VRFloorCacheMisses);
+	ComputeFloorDist_Impl(CapsuleLocation, LineDistance, SweepDistance, OutFloorResult, SweepRadius, DownwardSweepResult);
+	FloorCache.Add(CapsuleLocation, LineDistance, SweepDistance, SweepRadius, CapsuleHalfHeight, OutFloorResult);
+}
+
+void UVRBaseCharacterMovementComponent::ComputeFloorDist_Impl(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, FFindFloorResult& OutFloorResult, float SweepRadius, const FHitResult* DownwardSweepResult) const
 {
 	UE_LOG(LogVRBaseCharacterMovement, VeryVerbose, TEXT("[Role:%d] ComputeFloorDist: %s at location %s"), (int32)CharacterOwner->GetLocalRole(), *GetNameSafe(CharacterOwner), *CapsuleLocation.ToString());
 	OutFloorResult.Clear();
@@ -862,6 +914,12 @@ void UVRBaseCharacterMovementComponent::PerformMoveAction_Custom(EVRMoveAction M
 
 bool UVRBaseCharacterMovementComponent::CheckForMoveAction()
 {
+	// Any move action can relocate the character, don't trust floors from before it
+	if (MoveActionArray.MoveActions.Num() > 0)
+	{
+		InvalidateFloorCache();
+	}
+
 	for (FVRMoveActionContainer& MoveAction : MoveActionArray.MoveActions)
 	{
 		switch (MoveAction.MoveAction)
@@ -1102,6 +1160,12 @@ bool UVRBaseCharacterMovementComponent::DoMAPauseTracking(FVRMoveActionContainer
 		OwningCharacter->bTrackingPaused = MoveAction.MoveActionFlags > 0;
 		OwningCharacter->PausedTrackingLoc = MoveAction.MoveActionLoc;
 		OwningCharacter->PausedTrackingRot = MoveAction.MoveActionRot.Yaw;
+
+		// The paused pose doesn't come from the camera, so it can't wake a sleeping root on its own
+		if (UVRRootComponent* VRRoot = Cast<UVRRootComponent>(OwningCharacter->GetRootComponent()))
+		{
+			VRRoot->WakeRemoteTick();
+		}
 		return true;
 	}
 	return false;
@@ -1481,10 +1545,33 @@ void UVRBaseCharacterMovementComponent::PerformMovement(float DeltaSeconds)
 	}
 }
 
+void UVRBaseCharacterMovementComponent::ResetPredictionData_Client()
+{
+	Super::ResetPredictionData_Client();
+	MoveDeltaHistory.Reset();
+}
+
+void UVRBaseCharacterMovementComponent::ResetPredictionData_Server()
+{
+	Super::ResetPredictionData_Server();
+	MoveDeltaHistory.Reset();
+}
+
+void UVRBaseCharacterMovementComponent::OnClientTimeStampResetDetected()
+{
+	Super::OnClientTimeStampResetDetected();
+
+	// Stored time stamps are from before the reset and would match the wrong moves
+	MoveDeltaHistory.Reset();
+}
+
 void UVRBaseCharacterMovementComponent::OnClientCorrectionReceived(class FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode)
 {
 	Super::OnClientCorrectionReceived(ClientData, TimeStamp, NewLocation, NewVelocity, NewBase, NewBaseBoneName, bHasBase, bBaseRelativePosition, ServerMovementMode);
 
+	// Corrected moves are replayed, go back to a full capsule location until the server acks one again
+	MoveDeltaHistory.Reset();
+
 
 	// If we got corrected then lets teleport our grips, this means that we were out of sync with the server or the server moved us
 	if (BaseVRCharacterOwner)
@@ -35,6 +35,7 @@
 #include "Runtime/Launch/Resources/Version.h"
 #include "GameFramework/CharacterMovementReplication.h"
 #include "Interfaces/NetworkPredictionInterface.h"
+#include "Misc/VRServerMoveBatchSubsystem.h"
 
 //#include "PerfCountersHelpers.h"
 
@@ -56,6 +57,11 @@ DECLARE_CYCLE_STAT(TEXT("Char NavProjectLocation"), STAT_CharNavProjectLocation,
 DECLARE_CYCLE_STAT(TEXT("Char AdjustFloorHeight"), STAT_CharAdjustFloorHeight, STATGROUP_Character);
 DECLARE_CYCLE_STAT(TEXT("Char ProcessLanded"), STAT_CharProcessLanded, STATGROUP_Character);
 
+DECLARE_CYCLE_STAT(TEXT("Serial ServerMoves"), STAT_VRSerialServerMoves, STATGROUP_VRServerMoveBatching);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Serial ServerMove Packets"), STAT_VRSerialServerMovePackets, STATGROUP_VRServerMoveBatching);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched ServerMove Packets"), STAT_VRBatchedServerMovePackets, STATGROUP_VRServerMoveBatching);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Moves Pre-Rejected"), STAT_VRBatchedServerMovesPreRejected, STATGROUP_VRServerMoveBatching);
+
 namespace CharacterMovementConstants
 {
 	// MAGIC NUMBERS
@@ -648,11 +654,144 @@ void UVRCharacterMovementComponent::ServerMove_PerformMovement(const FCharacterN
 	// Validate move only after old and first dual portion, after all moves are completed.
 	if (MoveData.NetworkMoveType == FCharacterNetworkMoveData::ENetworkMoveType::NewMove)
 	{
-		ServerMoveHandleClientErrorVR(ClientTimeStamp, DeltaTime, ClientAccel, MoveData.Location, ClientControlRotation.Yaw, MoveData.MovementBase, MoveData.MovementBaseBoneName, MoveData.MovementMode);
+		if (bDeferBatchedMoveError)
+		{
+			// The check and apply steps run after every batched character has moved
+			bHasBatchedMoveError = ServerMoveBeginClientErrorVR(ClientTimeStamp, DeltaTime, ClientAccel, MoveData.Location, ClientControlRotation.Yaw, MoveData.MovementBase, MoveData.MovementBaseBoneName, MoveData.MovementMode, BatchedMoveErrorState);
+		}
+		else
+		{
+			ServerMoveHandleClientErrorVR(ClientTimeStamp, DeltaTime, ClientAccel, MoveData.Location, ClientControlRotation.Yaw, MoveData.MovementBase, MoveData.MovementBaseBoneName, MoveData.MovementMode);
+		}
 		//ServerMoveHandleClientError(ClientTimeStamp, DeltaTime, ClientAccel, MoveData.Location, MoveData.MovementBase, MoveData.MovementBaseBoneName, MoveData.MovementMode);
 	}
 }
 
+void UVRCharacterMovementComponent::ServerMove_HandleMoveData(const FCharacterNetworkMoveDataContainer& MoveDataContainer)
+{
+	UVRServerMoveBatchSubsystem* BatchSubsystem = nullptr;
+
+	// Only our own container type can be copied into the batch
+	if (UVRServerMoveBatchSubsystem::IsBatchingServerMoves() && &MoveDataContainer == &VRNetworkMoveDataContainer)
+	{
+		if (UWorld* World = GetWorld())
+		{
+			BatchSubsystem = World->GetSubsystem<UVRServerMoveBatchSubsystem>();
+		}
+	}
+
+	if (!BatchSubsystem)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_VRSerialServerMoves);
+		INC_DWORD_STAT(STAT_VRSerialServerMovePackets);
+		Super::ServerMove_HandleMoveData(MoveDataContainer);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_VRBatchedServerMovePackets);
+
+	if (NumBatchedMoveContainers <= 0)
+	{
+		BatchSubsystem->QueueComponent(this);
+	}
+
+	if (BatchedMoveContainers.Num() <= NumBatchedMoveContainers)
+	{
+		BatchedMoveContainers.Add(new FVRCharacterNetworkMoveDataContainer());
+		BatchedMoveSkipped.Add(false);
+	}
+
+	BatchedMoveContainers[NumBatchedMoveContainers].CopyMoveData(MoveDataContainer);
+	BatchedMoveSkipped[NumBatchedMoveContainers] = false;
+	++NumBatchedMoveContainers;
+}
+
+void UVRCharacterMovementComponent::PreValidateBatchedMoves()
+{
+	// Only rejects moves that ServerMove_PerformMovement would also reject
+	// TimeStamp resets and the auto accept after unseating are left to the serial path
+	if (!HasValidData() || !HasPredictionData_Server() || bJustUnseated)
+	{
+		return;
+	}
+
+	const FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+
+	// Without a reset the current timestamp only moves forward, so a move that is invalid now will still be invalid when its turn comes.
+	// Moves in a container are oldest first, so anything older than a rejected move is rejected as well.
+	auto IsMoveStale = [this, ServerData](const FCharacterNetworkMoveData* MoveData, bool& bOutResetDetected)
+	{
+		bool bTimeStampResetDetected = false;
+		const bool bValid = IsClientTimeStampValid(MoveData->TimeStamp, *ServerData, bTimeStampResetDetected);
+		bOutResetDetected |= bTimeStampResetDetected;
+		return !bValid && !bTimeStampResetDetected;
+	};
+
+	for (int32 i = 0; i < NumBatchedMoveContainers; ++i)
+	{
+		FVRCharacterNetworkMoveDataContainer& Container = BatchedMoveContainers[i];
+		bool bResetDetected = false;
+
+		if (IsMoveStale(Container.GetNewMoveData(), bResetDetected))
+		{
+			BatchedMoveSkipped[i] = true;
+			INC_DWORD_STAT(STAT_VRBatchedServerMovesPreRejected);
+		}
+		else if (!bResetDetected && Container.bHasPendingMove && IsMoveStale(Container.GetPendingMoveData(), bResetDetected))
+		{
+			Container.bHasPendingMove = false;
+			Container.bHasOldMove = false;
+			INC_DWORD_STAT(STAT_VRBatchedServerMovesPreRejected);
+		}
+		else if (!bResetDetected && Container.bHasOldMove && IsMoveStale(Container.GetOldMoveData(), bResetDetected))
+		{
+			Container.bHasOldMove = false;
+			INC_DWORD_STAT(STAT_VRBatchedServerMovesPreRejected);
+		}
+
+		if (bResetDetected)
+		{
+			break;
+		}
+	}
+}
+
+void UVRCharacterMovementComponent::PerformBatchedMoves()
+{
+	bHasBatchedMoveError = false;
+
+	for (int32 i = 0; i < NumBatchedMoveContainers; ++i)
+	{
+		// Only the final new move defers its error handling, earlier ones run in order as they still drive the falling / landing leash
+		bDeferBatchedMoveError = (i == NumBatchedMoveContainers - 1);
+
+		if (!BatchedMoveSkipped[i])
+		{
+			Super::ServerMove_HandleMoveData(BatchedMoveContainers[i]);
+		}
+	}
+
+	bDeferBatchedMoveError = false;
+	NumBatchedMoveContainers = 0;
+}
+
+void UVRCharacterMovementComponent::CheckBatchedMoveError()
+{
+	if (bHasBatchedMoveError)
+	{
+		BatchedMoveErrorState.bNeedsCorrection = ServerMoveCheckClientErrorVR(BatchedMoveErrorState);
+	}
+}
+
+void UVRCharacterMovementComponent::ApplyBatchedMoveError()
+{
+	if (bHasBatchedMoveError)
+	{
+		bHasBatchedMoveError = false;
+		ServerMoveEndClientErrorVR(BatchedMoveErrorState);
+	}
+}
+
 /*void UVRCharacterMovementComponent::CallServerMove
 (
 	const class FSavedMove_Character* NewCMove,
@@ -1395,6 +1534,9 @@ UVRCharacterMovementComponent::UVRCharacterMovementComponent(const FObjectInitia
 	PostPhysicsTickFunction.bStartWithTickEnabled = false;
 	PrimaryComponentTick.TickGroup = TG_PrePhysics;
 	VRRootCapsule = NULL;
+	NumBatchedMoveContainers = 0;
+	bHasBatchedMoveError = false;
+	bDeferBatchedMoveError = false;
 	//VRCameraCollider = NULL;
 	// 0.1f is low slide and still impacts surfaces well
 	// This variable is a bit of a hack, it reduces the movement of the pawn in the direction of relative movement
@@ -4058,12 +4200,24 @@ bool UVRCharacterMovementComponent::ServerCheckClientErrorVR(float ClientTimeSta
 }
 
 void UVRCharacterMovementComponent::ServerMoveHandleClientErrorVR(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& RelativeClientLoc, float ClientYaw, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	FVRServerMoveErrorState ErrorState;
+	if (!ServerMoveBeginClientErrorVR(ClientTimeStamp, DeltaTime, Accel, RelativeClientLoc, ClientYaw, ClientMovementBase, ClientBaseBoneName, ClientMovementMode, ErrorState))
+	{
+		return;
+	}
+
+	ErrorState.bNeedsCorrection = ServerMoveCheckClientErrorVR(ErrorState);
+	ServerMoveEndClientErrorVR(ErrorState);
+}
+
+bool UVRCharacterMovementComponent::ServerMoveBeginClientErrorVR(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& RelativeClientLoc, float ClientYaw, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode, FVRServerMoveErrorState& OutState)
 {
 	if (!ShouldUsePackedMovementRPCs())
 	{
 		if (RelativeClientLoc == FVector(1.f, 2.f, 3.f)) // first part of double servermove
 		{
-			return;
+			return false;
 		}
 	}
 
@@ -4078,7 +4232,7 @@ void UVRCharacterMovementComponent::ServerMoveHandleClientErrorVR(float ClientTi
 		const AGameNetworkManager* GameNetworkManager = (const AGameNetworkManager*)(AGameNetworkManager::StaticClass()->GetDefaultObject());
 		if (GameNetworkManager->WithinUpdateDelayBounds(PC, ServerData->LastUpdateTime))
 		{
-			return;
+			return false;
 		}
 	}
 
@@ -4275,10 +4429,72 @@ void UVRCharacterMovementComponent::ServerMoveHandleClientErrorVR(float ClientTi
 			bInClientAuthoritativeMovementMode = true;
 	}
 
+	OutState.ClientTimeStamp = ClientTimeStamp;
+	OutState.DeltaTime = DeltaTime;
+	OutState.Accel = Accel;
+	OutState.RelativeClientLoc = RelativeClientLoc;
+	OutState.ClientYaw = ClientYaw;
+	OutState.ClientMovementBase = ClientMovementBase;
+	OutState.ClientBaseBoneName = ClientBaseBoneName;
+	OutState.ClientMovementMode = ClientMovementMode;
+	OutState.ClientLoc = ClientLoc;
+	OutState.ServerLoc = ServerLoc;
+	OutState.RelativeLocation = RelativeLocation;
+	OutState.RelativeVelocity = RelativeVelocity;
+	OutState.MovementBase = MovementBase;
+	OutState.MovementBaseBoneName = MovementBaseBoneName;
+	OutState.bServerIsFalling = bServerIsFalling;
+	OutState.bClientIsFalling = bClientIsFalling;
+	OutState.bUseLastBase = bUseLastBase;
+	OutState.bFallingWithinAcceptableError = bFallingWithinAcceptableError;
+	OutState.bDeferServerCorrectionsWhenFalling = bDeferServerCorrectionsWhenFalling;
+	OutState.bInClientAuthoritativeMovementMode = bInClientAuthoritativeMovementMode;
+	OutState.bNeedsCorrection = false;
+	return true;
+}
+
+bool UVRCharacterMovementComponent::ServerMoveCheckClientErrorVR(const FVRServerMoveErrorState& State)
+{
+	FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+	check(ServerData);
+
 	// Compute the client error from the server's position
 	// If client has accumulated a noticeable positional error, correct them.
 	bNetworkLargeClientCorrection = ServerData->bForceClientUpdate;
-	if (!bInClientAuthoritativeMovementMode && (ServerData->bForceClientUpdate || (!bFallingWithinAcceptableError && ServerCheckClientErrorVR(ClientTimeStamp, DeltaTime, Accel, ClientLoc, ClientYaw, RelativeClientLoc, ClientMovementBase, ClientBaseBoneName, ClientMovementMode))))
+
+	if (State.bInClientAuthoritativeMovementMode)
+	{
+		return false;
+	}
+
+	return ServerData->bForceClientUpdate || (!State.bFallingWithinAcceptableError && ServerCheckClientErrorVR(State.ClientTimeStamp, State.DeltaTime, State.Accel, State.ClientLoc, State.ClientYaw, State.RelativeClientLoc, State.ClientMovementBase, State.ClientBaseBoneName, State.ClientMovementMode));
+}
+
+void UVRCharacterMovementComponent::ServerMoveEndClientErrorVR(const FVRServerMoveErrorState& State)
+{
+	FNetworkPredictionData_Server_VRCharacter* ServerData = ((FNetworkPredictionData_Server_VRCharacter*)GetPredictionData_Server_Character());
+	check(ServerData);
+
+	const float ClientTimeStamp = State.ClientTimeStamp;
+	const float DeltaTime = State.DeltaTime;
+	const FVector& Accel = State.Accel;
+	const FVector& RelativeClientLoc = State.RelativeClientLoc;
+	UPrimitiveComponent* ClientMovementBase = State.ClientMovementBase;
+	const FName ClientBaseBoneName = State.ClientBaseBoneName;
+	const uint8 ClientMovementMode = State.ClientMovementMode;
+	const FVector& ClientLoc = State.ClientLoc;
+	const FVector& ServerLoc = State.ServerLoc;
+	const FVector& RelativeLocation = State.RelativeLocation;
+	const FVector& RelativeVelocity = State.RelativeVelocity;
+	UPrimitiveComponent* MovementBase = State.MovementBase;
+	const FName MovementBaseBoneName = State.MovementBaseBoneName;
+	const bool bServerIsFalling = State.bServerIsFalling;
+	const bool bClientIsFalling = State.bClientIsFalling;
+	const bool bUseLastBase = State.bUseLastBase;
+	const bool bDeferServerCorrectionsWhenFalling = State.bDeferServerCorrectionsWhenFalling;
+	const bool bInClientAuthoritativeMovementMode = State.bInClientAuthoritativeMovementMode;
+
+	if (State.bNeedsCorrection)
 	{
 		//UPrimitiveComponent* MovementBase = CharacterOwner->GetMovementBase();
 		ServerData->PendingAdjustment.NewVel = Velocity;
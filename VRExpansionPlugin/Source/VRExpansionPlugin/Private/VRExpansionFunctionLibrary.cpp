@@ -55,8 +55,9 @@ void UVRExpansionFunctionLibrary::SetActorsIgnoreAllCollision(UObject* WorldCont
 
 	if (CollisionIgnoreSubsystem)
 	{
-		// Just a temp flag to only check state on the first component pair
-		bool bIgnorefirst = true;
+		TArray<FCollisionIgnoreBatchEntry> PrimitivePairs;
+		PrimitivePairs.Reserve(PrimitiveComponents1.Num() * PrimitiveComponents2.Num());
+
 		for (int i = 0; i < PrimitiveComponents1.Num(); ++i)
 		{
 			for (int j = 0; j < PrimitiveComponents2.Num(); ++j)
@@ -81,10 +82,15 @@ void UVRExpansionFunctionLibrary::SetActorsIgnoreAllCollision(UObject* WorldCont
 					continue;
 				}
 
-				CollisionIgnoreSubsystem->SetComponentCollisionIgnoreState(true, true, PrimitiveComponents1[i], NAME_None, PrimitiveComponents2[j], NAME_None, bIgnoreCollision, bIgnorefirst);
-				bIgnorefirst = false;
+				PrimitivePairs.Add(FCollisionIgnoreBatchEntry(true, true, PrimitiveComponents1[i], NAME_None, PrimitiveComponents2[j], NAME_None));
 			}
 		}
+
+		// Filters are only checked once for the entire batch
+		if (PrimitivePairs.Num())
+		{
+			CollisionIgnoreSubsystem->SetComponentCollisionIgnoreStateBatched(PrimitivePairs, bIgnoreCollision, true);
+		}
 	}
 }
 
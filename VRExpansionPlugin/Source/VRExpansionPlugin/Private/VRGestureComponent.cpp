@@ -8,8 +8,130 @@
 #include "DrawDebugHelpers.h"
 #include "Algo/Reverse.h"
 #include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+
+DEFINE_LOG_CATEGORY(LogVRGestures);
 
 DECLARE_CYCLE_STAT(TEXT("TickGesture ~ TickingGesture"), STAT_TickGesture, STATGROUP_TickGesture);
+DECLARE_CYCLE_STAT(TEXT("TickGesture ~ RecognizeGesture"), STAT_RecognizeGesture, STATGROUP_TickGesture);
+DECLARE_CYCLE_STAT(TEXT("TickGesture ~ DTW"), STAT_GestureDTW, STATGROUP_TickGesture);
+DECLARE_CYCLE_STAT(TEXT("TickGesture ~ Pack Gestures"), STAT_PackGestures, STATGROUP_TickGesture);
+DECLARE_DWORD_COUNTER_STAT(TEXT("TickGesture ~ Lower Bound Rejections"), STAT_GestureLowerBoundRejections, STATGROUP_TickGesture);
+
+namespace VRGestureBenchmark
+{
+	static void MakeRandomGesture(FRandomStream& Stream, int32 NumSamples, TArray<FVector>& OutSamples)
+	{
+		OutSamples.Reset(NumSamples);
+		FVector Current = FVector::ZeroVector;
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			Current += FVector(0.f, Stream.FRandRange(-5.f, 5.f), Stream.FRandRange(-5.f, 5.f));
+			OutSamples.Add(Current);
+		}
+	}
+
+	// Times the reference dtw against the DTW engine on a randomly generated database
+	static void RunDTWBenchmark(const TArray<FString>& Args)
+	{
+		const int32 NumGestures = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 50;
+		const int32 InputLength = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 60;
+		const int32 Iterations = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 100;
+		const int32 BandWidth = Args.Num() > 3 ? FCString::Atoi(*Args[3]) : 10;
+
+		if (NumGestures < 1 || InputLength < 1 || Iterations < 1)
+		{
+			UE_LOG(LogVRGestures, Warning, TEXT("Usage: vr.Gestures.BenchmarkDTW [NumGestures] [InputLength] [Iterations] [BandWidth]"));
+			return;
+		}
+
+		FRandomStream Stream(0x5EED);
+
+		FVRGesture Input;
+		MakeRandomGesture(Stream, InputLength, Input.Samples);
+
+		TArray<FVRGesture> Examples;
+		Examples.SetNum(NumGestures);
+		for (FVRGesture& Example : Examples)
+		{
+			MakeRandomGesture(Stream, Stream.RandRange(FMath::Max(InputLength / 3, 1), InputLength), Example.Samples);
+		}
+
+		UVRGestureComponent* ReferenceComponent = GetMutableDefault<UVRGestureComponent>();
+		const int32 MaxSlope = ReferenceComponent->maxSlope;
+
+		float ReferenceSum = 0.f;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Iter = 0; Iter < Iterations; ++Iter)
+		{
+			for (const FVRGesture& Example : Examples)
+			{
+				ReferenceSum += ReferenceComponent->dtw(Input, Example) / Example.Samples.Num();
+			}
+		}
+		const double ReferenceTime = FPlatformTime::Seconds() - StartTime;
+
+		FVRGestureDTWEngine Engine;
+		FVRGestureSampleSoA PreparedInput;
+		TArray<FVRGestureSampleSoA> PreparedExamples;
+		PreparedExamples.SetNum(Examples.Num());
+		for (int32 i = 0; i < Examples.Num(); ++i)
+		{
+			PreparedExamples[i].SetFromSamples(Examples[i].Samples);
+		}
+
+		// Full table, should match the reference results
+		float EngineSum = 0.f;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iter = 0; Iter < Iterations; ++Iter)
+		{
+			PreparedInput.SetFromSamples(Input.Samples);
+			for (const FVRGestureSampleSoA& Example : PreparedExamples)
+			{
+				EngineSum += Engine.ComputeDTW(PreparedInput, Example, MaxSlope) / Example.Num();
+			}
+		}
+		const double EngineTime = FPlatformTime::Seconds() - StartTime;
+
+		// Banded with lower bound rejection against the best so far, as recognition runs it
+		int32 Rejections = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Iter = 0; Iter < Iterations; ++Iter)
+		{
+			PreparedInput.SetFromSamples(Input.Samples);
+			PreparedInput.BuildEnvelope(BandWidth);
+
+			float MinDist = MAX_FLT;
+			for (const FVRGestureSampleSoA& Example : PreparedExamples)
+			{
+				const float Cutoff = MinDist * Example.Num();
+				if (FVRGestureDTWEngine::LowerBound(PreparedInput, Example, Cutoff) >= Cutoff)
+				{
+					++Rejections;
+					continue;
+				}
+
+				MinDist = FMath::Min(MinDist, Engine.ComputeDTW(PreparedInput, Example, MaxSlope, BandWidth, Cutoff) / Example.Num());
+			}
+		}
+		const double BandedTime = FPlatformTime::Seconds() - StartTime;
+
+		const int32 NumChecks = Iterations * NumGestures;
+		UE_LOG(LogVRGestures, Log, TEXT("DTW benchmark: %i gestures, input length %i, %i iterations"), NumGestures, InputLength, Iterations);
+		UE_LOG(LogVRGestures, Log, TEXT("  Reference dtw:        %.3f ms total, %.3f us per gesture"), ReferenceTime * 1000.0, (ReferenceTime * 1000000.0) / NumChecks);
+		UE_LOG(LogVRGestures, Log, TEXT("  Engine (full table):  %.3f ms total, %.3f us per gesture, result delta %f"), EngineTime * 1000.0, (EngineTime * 1000000.0) / NumChecks, FMath::Abs(ReferenceSum - EngineSum));
+		UE_LOG(LogVRGestures, Log, TEXT("  Engine (band %i + LB): %.3f ms total, %.3f us per gesture, %i lower bound rejections"), BandWidth, BandedTime * 1000.0, (BandedTime * 1000000.0) / NumChecks, Rejections);
+	}
+
+	static FAutoConsoleCommand CmdBenchmarkDTW(
+		TEXT("vr.Gestures.BenchmarkDTW"),
+		TEXT("Times the reference gesture DTW against the DTW engine on random data.\n")
+		TEXT("Args: [NumGestures=50] [InputLength=60] [Iterations=100] [BandWidth=10]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunDTWBenchmark));
+}
 
 UVRGestureComponent::UVRGestureComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -27,6 +149,245 @@ UVRGestureComponent::UVRGestureComponent(const FObjectInitializer& ObjectInitial
 	bDrawSplinesCurved = true;
 	bGetGestureInWorldSpace = true;
 	SplineMeshScaler = FVector2D(1.f);
+	DTWBandWidth = 0;
+	bUseLowerBoundRejection = true;
+
+	for (bool& bValid : bPreparedInputValid)
+	{
+		bValid = false;
+	}
+}
+
+void FVRGestureSampleSoA::SetFromSamples(const TArray<FVector>& Samples, float Scaler, bool bMirror)
+{
+	const int32 NumSamples = Samples.Num();
+	X.SetNumUninitialized(NumSamples, false);
+	Y.SetNumUninitialized(NumSamples, false);
+	Z.SetNumUninitialized(NumSamples, false);
+
+	// Mirroring the input on Y is the same as mirroring the example, the distance is symmetrical
+	const float YScaler = bMirror ? -Scaler : Scaler;
+
+	for (int32 i = 0; i < NumSamples; ++i)
+	{
+		X[i] = Samples[i].X * Scaler;
+		Y[i] = Samples[i].Y * YScaler;
+		Z[i] = Samples[i].Z * Scaler;
+	}
+}
+
+void FVRGestureSampleSoA::BuildEnvelope(int32 BandWidth)
+{
+	const int32 NumSamples = Num();
+	EnvelopeBandWidth = FMath::Max(BandWidth, 0);
+	bGlobalEnvelope = EnvelopeBandWidth <= 0;
+
+	// With a band, index j of the other sequence can only match samples in [j - Band, j + Band]
+	const int32 EnvelopeNum = bGlobalEnvelope ? 1 : NumSamples + EnvelopeBandWidth;
+
+	EnvMinX.SetNumUninitialized(EnvelopeNum, false);
+	EnvMinY.SetNumUninitialized(EnvelopeNum, false);
+	EnvMinZ.SetNumUninitialized(EnvelopeNum, false);
+	EnvMaxX.SetNumUninitialized(EnvelopeNum, false);
+	EnvMaxY.SetNumUninitialized(EnvelopeNum, false);
+	EnvMaxZ.SetNumUninitialized(EnvelopeNum, false);
+
+	for (int32 j = 0; j < EnvelopeNum; ++j)
+	{
+		const int32 Start = bGlobalEnvelope ? 0 : FMath::Max(j - EnvelopeBandWidth, 0);
+		const int32 End = bGlobalEnvelope ? NumSamples - 1 : FMath::Min(j + EnvelopeBandWidth, NumSamples - 1);
+
+		float MinX = MAX_FLT, MinY = MAX_FLT, MinZ = MAX_FLT;
+		float MaxX = -MAX_FLT, MaxY = -MAX_FLT, MaxZ = -MAX_FLT;
+
+		for (int32 i = Start; i <= End; ++i)
+		{
+			MinX = FMath::Min(MinX, X[i]); MaxX = FMath::Max(MaxX, X[i]);
+			MinY = FMath::Min(MinY, Y[i]); MaxY = FMath::Max(MaxY, Y[i]);
+			MinZ = FMath::Min(MinZ, Z[i]); MaxZ = FMath::Max(MaxZ, Z[i]);
+		}
+
+		EnvMinX[j] = MinX; EnvMinY[j] = MinY; EnvMinZ[j] = MinZ;
+		EnvMaxX[j] = MaxX; EnvMaxY[j] = MaxY; EnvMaxZ[j] = MaxZ;
+	}
+}
+
+float FVRGestureDTWEngine::LowerBound(const FVRGestureSampleSoA& Input, const FVRGestureSampleSoA& Example, float Cutoff)
+{
+	const int32 ExampleNum = Example.Num();
+
+	if (Input.Num() < 1 || Input.EnvMinX.Num() < 1)
+		return 0.f;
+
+	// Past the end of the envelope nothing in the input is inside the band, the example can't be completed
+	if (!Input.bGlobalEnvelope && ExampleNum > Input.EnvMinX.Num())
+		return MAX_FLT;
+
+	float Bound = 0.f;
+
+	for (int32 j = 0; j < ExampleNum; ++j)
+	{
+		const int32 EnvIndex = Input.bGlobalEnvelope ? 0 : j;
+
+		// Every column has to be matched by at least one input sample within the envelope
+		const float DX = Example.X[j] - FMath::Clamp(Example.X[j], Input.EnvMinX[EnvIndex], Input.EnvMaxX[EnvIndex]);
+		const float DY = Example.Y[j] - FMath::Clamp(Example.Y[j], Input.EnvMinY[EnvIndex], Input.EnvMaxY[EnvIndex]);
+		const float DZ = Example.Z[j] - FMath::Clamp(Example.Z[j], Input.EnvMinZ[EnvIndex], Input.EnvMaxZ[EnvIndex]);
+
+		Bound += DX * DX + DY * DY + DZ * DZ;
+
+		if (Bound >= Cutoff)
+			break;
+	}
+
+	return Bound;
+}
+
+float FVRGestureDTWEngine::ComputeDTW(const FVRGestureSampleSoA& Input, const FVRGestureSampleSoA& Example, int32 MaxSlope, int32 BandWidth, float Cutoff)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GestureDTW);
+
+	const int32 RowCount = Input.Num() + 1;
+	const int32 ColumnCount = Example.Num() + 1;
+
+	if (RowCount < 2 || ColumnCount < 2)
+		return MAX_FLT;
+
+	const int32 Band = BandWidth > 0 ? BandWidth : RowCount + ColumnCount;
+
+	for (int32 Row = 0; Row < 2; ++Row)
+	{
+		CostRows[Row].SetNumUninitialized(ColumnCount, false);
+		SlopeIRows[Row].SetNumUninitialized(ColumnCount, false);
+		SlopeJRows[Row].SetNumUninitialized(ColumnCount, false);
+	}
+
+	// Row zero, only [0][0] is a valid start
+	{
+		float* Cost = CostRows[0].GetData();
+		int32* SlopeI = SlopeIRows[0].GetData();
+		int32* SlopeJ = SlopeJRows[0].GetData();
+
+		Cost[0] = 0.f;
+		SlopeI[0] = 0;
+		SlopeJ[0] = 0;
+
+		for (int32 j = 1; j < ColumnCount; ++j)
+		{
+			Cost[j] = MAX_FLT;
+			SlopeI[j] = 0;
+			SlopeJ[j] = 0;
+		}
+	}
+
+	const float* InX = Input.X.GetData();
+	const float* InY = Input.Y.GetData();
+	const float* InZ = Input.Z.GetData();
+	const float* ExX = Example.X.GetData();
+	const float* ExY = Example.Y.GetData();
+	const float* ExZ = Example.Z.GetData();
+
+	const int32 LastColumn = ColumnCount - 1;
+	float BestMatch = MAX_FLT;
+
+	// Rows past LastColumn + Band can't reach the last column while staying in the band
+	const int32 LastRow = FMath::Min(RowCount - 1, LastColumn + Band);
+
+	for (int32 i = 1; i <= LastRow; ++i)
+	{
+		const float* PrevCost = CostRows[(i - 1) & 1].GetData();
+		const int32* PrevSlopeJ = SlopeJRows[(i - 1) & 1].GetData();
+
+		float* Cost = CostRows[i & 1].GetData();
+		int32* SlopeI = SlopeIRows[i & 1].GetData();
+		int32* SlopeJ = SlopeJRows[i & 1].GetData();
+
+		const int32 ColumnStart = FMath::Max(1, i - Band);
+		const int32 ColumnEnd = FMath::Min(LastColumn, i + Band);
+
+		// Out of band cells the next row may read from
+		Cost[ColumnStart - 1] = MAX_FLT;
+		SlopeI[ColumnStart - 1] = 0;
+		SlopeJ[ColumnStart - 1] = 0;
+
+		if (ColumnEnd < LastColumn)
+		{
+			Cost[ColumnEnd + 1] = MAX_FLT;
+			SlopeI[ColumnEnd + 1] = 0;
+			SlopeJ[ColumnEnd + 1] = 0;
+		}
+
+		const float SampleX = InX[i - 1];
+		const float SampleY = InY[i - 1];
+		const float SampleZ = InZ[i - 1];
+
+		float RowMin = MAX_FLT;
+
+		for (int32 j = ColumnStart; j <= ColumnEnd; ++j)
+		{
+			const float DX = SampleX - ExX[j - 1];
+			const float DY = SampleY - ExY[j - 1];
+			const float DZ = SampleZ - ExZ[j - 1];
+			const float Distance = DX * DX + DY * DY + DZ * DZ;
+
+			const float Left = Cost[j - 1];
+			const float Diagonal = PrevCost[j - 1];
+			const float Up = PrevCost[j];
+
+			// Same step selection as the original table implementation
+			if (Left < Diagonal && Left < Up && SlopeI[j - 1] < MaxSlope)
+			{
+				Cost[j] = Distance + Left;
+				SlopeI[j] = SlopeJ[j - 1] + 1;
+				SlopeJ[j] = 0;
+			}
+			else if (Up < Diagonal && Up < Left && PrevSlopeJ[j] < MaxSlope)
+			{
+				Cost[j] = Distance + Up;
+				SlopeI[j] = 0;
+				SlopeJ[j] = PrevSlopeJ[j] + 1;
+			}
+			else
+			{
+				Cost[j] = Distance + Diagonal;
+				SlopeI[j] = 0;
+				SlopeJ[j] = 0;
+			}
+
+			RowMin = FMath::Min(RowMin, Cost[j]);
+		}
+
+		if (ColumnEnd == LastColumn && Cost[LastColumn] < BestMatch)
+		{
+			BestMatch = Cost[LastColumn];
+		}
+
+		// Costs only grow, if every cell in this row is past the cutoff then no later ending can beat it
+		if (RowMin >= Cutoff)
+			break;
+	}
+
+	return BestMatch;
+}
+
+const FVRGestureSampleSoA& UVRGestureComponent::GetPreparedInput(const FVRGesture& InputGesture, float Scaler, bool bScaled, bool bMirrored)
+{
+	const int32 Index = (bScaled ? 1 : 0) | (bMirrored ? 2 : 0);
+	FVRGestureSampleSoA& Prepared = PreparedInputs[Index];
+
+	if (!bPreparedInputValid[Index])
+	{
+		Prepared.SetFromSamples(InputGesture.Samples, bScaled ? Scaler : 1.f, bMirrored);
+
+		if (bUseLowerBoundRejection)
+		{
+			Prepared.BuildEnvelope(DTWBandWidth);
+		}
+
+		bPreparedInputValid[Index] = true;
+	}
+
+	return Prepared;
 }
 
 void UGesturesDatabase::FillSplineWithGesture(FVRGesture &Gesture, USplineComponent * SplineComponent, bool bCenterPointsOnSpline, bool bScaleToBounds, float OptionalBounds, bool bUseCurvedPoints, bool bFillInSplineMeshComponents, UStaticMesh * Mesh, UMaterial * MeshMat)
@@ -372,68 +733,140 @@ void UVRGestureComponent::TickGesture()
 	}
 }
 
-void UVRGestureComponent::RecognizeGesture(FVRGesture inputGesture)
+float UVRGestureComponent::CheckGestureCandidate(const FVRGesture& InputGesture, int32 GestureIndex, float Scaler, float BestDistance, FVRGestureDTWEngine& Engine)
+{
+	const FVRGesture& exampleGesture = GesturesDB->Gestures[GestureIndex];
+
+	if (!exampleGesture.GestureSettings.bEnabled || exampleGesture.Samples.Num() < 1 || InputGesture.Samples.Num() < exampleGesture.GestureSettings.Minimum_Gesture_Length)
+		return MAX_FLT;
+
+	const FVRGestureSampleSoA& PackedExample = GesturesDB->GetPackedGesture(GestureIndex);
+	const bool bScaled = exampleGesture.GestureSettings.bEnableScaling;
+	const float FirstThresholdSquared = FMath::Square(exampleGesture.GestureSettings.firstThreshold);
+	const float FullThresholdSquared = FMath::Square(exampleGesture.GestureSettings.FullThreshold);
+	const int32 ExampleNum = PackedExample.Num();
+
+	float OutDistance = MAX_FLT;
+
+	// Returns false if the first threshold check failed
+	auto CheckGesture = [&](bool bMirror) -> bool
+	{
+		const FVRGestureSampleSoA& PreparedInput = GetPreparedInput(InputGesture, Scaler, bScaled, bMirror);
+
+		// Cheap pre-filter on the newest sample
+		const float DX = PreparedInput.X[0] - PackedExample.X[0];
+		const float DY = PreparedInput.Y[0] - PackedExample.Y[0];
+		const float DZ = PreparedInput.Z[0] - PackedExample.Z[0];
+		if ((DX * DX + DY * DY + DZ * DZ) >= FirstThresholdSquared)
+			return false;
+
+		// Total cost at or past this can't be accepted
+		const float Cutoff = FMath::Min(FMath::Min(BestDistance, OutDistance), FullThresholdSquared) * ExampleNum;
+
+		if (bUseLowerBoundRejection && FVRGestureDTWEngine::LowerBound(PreparedInput, PackedExample, Cutoff) >= Cutoff)
+		{
+			INC_DWORD_STAT(STAT_GestureLowerBoundRejections);
+			return true;
+		}
+
+		float d = Engine.ComputeDTW(PreparedInput, PackedExample, maxSlope, DTWBandWidth, Cutoff) / ExampleNum;
+		if (d < OutDistance && d < FullThresholdSquared)
+		{
+			OutDistance = d;
+		}
+
+		return true;
+	};
+
+	bool bMirrorGesture = (MirroringHand != EVRGestureMirrorMode::GES_NoMirror && MirroringHand != EVRGestureMirrorMode::GES_MirrorBoth && MirroringHand == exampleGesture.GestureSettings.MirrorMode);
+
+	if (!CheckGesture(bMirrorGesture) && exampleGesture.GestureSettings.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth)
+	{
+		CheckGesture(true);
+	}
+
+	return OutDistance;
+}
+
+void UVRGestureComponent::RecognizeGesture(const FVRGesture& inputGesture)
 {
 	if (!GesturesDB || inputGesture.Samples.Num() < 1 || !bGestureChanged)
 		return;
 
+	SCOPE_CYCLE_COUNTER(STAT_RecognizeGesture);
+
 	float minDist = MAX_FLT;
 
 	int OutGestureIndex = -1;
-	bool bMirrorGesture = false;
 
 	FVector Size = inputGesture.GestureSize.GetSize();
 	float Scaler = GesturesDB->TargetGestureScale / Size.GetMax();
-	float FinalScaler = Scaler;
 
-	for (int i = 0; i < GesturesDB->Gestures.Num(); i++)
+	GesturesDB->EnsurePackedGestures();
+
+	// Input copies are scaled / mirrored once per pass instead of inside the DTW loop
+	for (bool& bValid : bPreparedInputValid)
 	{
-		FVRGesture &exampleGesture = GesturesDB->Gestures[i];
+		bValid = false;
+	}
 
-		if (!exampleGesture.GestureSettings.bEnabled || exampleGesture.Samples.Num() < 1 || inputGesture.Samples.Num() < exampleGesture.GestureSettings.Minimum_Gesture_Length)
-			continue;
+	const int32 NumGestures = GesturesDB->Gestures.Num();
 
-		FinalScaler = exampleGesture.GestureSettings.bEnableScaling ? Scaler : 1.f;
+	if (GesturesDB->ParallelRecognitionThreshold > 0 && NumGestures >= GesturesDB->ParallelRecognitionThreshold)
+	{
+		// Build every input variant up front, the workers can't build them lazily
+		GetPreparedInput(inputGesture, Scaler, false, false);
+		GetPreparedInput(inputGesture, Scaler, true, false);
+		GetPreparedInput(inputGesture, Scaler, false, true);
+		GetPreparedInput(inputGesture, Scaler, true, true);
 
-		bMirrorGesture = (MirroringHand != EVRGestureMirrorMode::GES_NoMirror && MirroringHand != EVRGestureMirrorMode::GES_MirrorBoth && MirroringHand == exampleGesture.GestureSettings.MirrorMode);
+		// Split into contiguous chunks so each one can use its own engine and its own running best as a cutoff
+		const int32 NumChunks = FMath::Clamp(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1, NumGestures);
+		const int32 ChunkSize = FMath::DivideAndRoundUp(NumGestures, NumChunks);
 
-		if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+		if (ParallelDTWEngines.Num() < NumChunks)
 		{
-			float d = dtw(inputGesture, exampleGesture, bMirrorGesture, FinalScaler) / (exampleGesture.Samples.Num());
-			if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
+			ParallelDTWEngines.SetNum(NumChunks);
+		}
+
+		ParallelResults.SetNumUninitialized(NumGestures, false);
+
+		ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			FVRGestureDTWEngine& Engine = ParallelDTWEngines[ChunkIndex];
+			const int32 Start = ChunkIndex * ChunkSize;
+			const int32 End = FMath::Min(Start + ChunkSize, NumGestures);
+
+			float ChunkBest = MAX_FLT;
+			for (int32 i = Start; i < End; ++i)
 			{
-				minDist = d;
-				OutGestureIndex = i;
+				const float d = CheckGestureCandidate(inputGesture, i, Scaler, ChunkBest, Engine);
+				ParallelResults[i] = d;
+				ChunkBest = FMath::Min(ChunkBest, d);
 			}
-		}
-		else if (exampleGesture.GestureSettings.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth)
+		});
+
+		// Reduce in order so ties go to the first gesture like the serial path
+		for (int32 i = 0; i < NumGestures; ++i)
 		{
-			bMirrorGesture = true;
-			if (GetGestureDistance(inputGesture.Samples[0] * FinalScaler, exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+			if (ParallelResults[i] < minDist)
 			{
-				float d = dtw(inputGesture, exampleGesture, bMirrorGesture, FinalScaler) / (exampleGesture.Samples.Num());
-				if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
-				{
-					minDist = d;
-					OutGestureIndex = i;
-				}
+				minDist = ParallelResults[i];
+				OutGestureIndex = i;
 			}
 		}
-
-		/*if (exampleGesture.MirrorMode == EVRGestureMirrorMode::GES_MirrorBoth)
+	}
+	else
+	{
+		for (int32 i = 0; i < NumGestures; i++)
 		{
-			bMirrorGesture = true;
-
-			if (GetGestureDistance(inputGesture.Samples[0], exampleGesture.Samples[0], bMirrorGesture) < FMath::Square(exampleGesture.GestureSettings.firstThreshold))
+			const float d = CheckGestureCandidate(inputGesture, i, Scaler, minDist, DTWEngine);
+			if (d < minDist)
 			{
-				float d = dtw(inputGesture, exampleGesture, bMirrorGesture) / (exampleGesture.Samples.Num());
-				if (d < minDist && d < FMath::Square(exampleGesture.GestureSettings.FullThreshold))
-				{
-					minDist = d;
-					OutGestureIndex = i;
-				}
+				minDist = d;
+				OutGestureIndex = i;
 			}
-		}*/
+		}
 	}
 
 	if (/*minDist < FMath::Square(globalThreshold) && */OutGestureIndex != -1)
@@ -445,7 +878,7 @@ void UVRGestureComponent::RecognizeGesture(FVRGesture inputGesture)
 	}
 }
 
-float UVRGestureComponent::dtw(FVRGesture seq1, FVRGesture seq2, bool bMirrorGesture, float Scaler)
+float UVRGestureComponent::dtw(const FVRGesture& seq1, const FVRGesture& seq2, bool bMirrorGesture, float Scaler)
 {
 
 	// #TODO: Skip copying the array and reversing it in the future, we only ever use the reversed value.
@@ -579,6 +1012,66 @@ void UGesturesDatabase::RecalculateGestures(bool bScaleToDatabase)
 	{
 		Gestures[i].CalculateSizeOfGesture(bScaleToDatabase, TargetGestureScale);
 	}
+
+	PackGestures();
+}
+
+void UGesturesDatabase::PostLoad()
+{
+	Super::PostLoad();
+	PackGestures();
+}
+
+#if WITH_EDITOR
+void UGesturesDatabase::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	PackGestures();
+}
+#endif
+
+static FORCEINLINE uint32 GetGestureSamplesHash(const TArray<FVector>& Samples)
+{
+	return FCrc::MemCrc32(Samples.GetData(), Samples.Num() * Samples.GetTypeSize());
+}
+
+void UGesturesDatabase::PackGesture(int32 GestureIndex)
+{
+	// Samples are stored newest first already, which is the order the DTW walks them in
+	PackedGestures[GestureIndex].SetFromSamples(Gestures[GestureIndex].Samples);
+	PackedGestureHashes[GestureIndex] = GetGestureSamplesHash(Gestures[GestureIndex].Samples);
+}
+
+void UGesturesDatabase::PackGestures()
+{
+	SCOPE_CYCLE_COUNTER(STAT_PackGestures);
+
+	PackedGestures.SetNum(Gestures.Num());
+	PackedGestureHashes.SetNum(Gestures.Num());
+
+	for (int32 i = 0; i < Gestures.Num(); ++i)
+	{
+		PackGesture(i);
+	}
+}
+
+void UGesturesDatabase::EnsurePackedGestures()
+{
+	if (PackedGestures.Num() != Gestures.Num())
+	{
+		PackGestures();
+		return;
+	}
+
+	// Hashing is linear in the samples, far cheaper than the DTW pass it guards
+	for (int32 i = 0; i < Gestures.Num(); ++i)
+	{
+		if (PackedGestures[i].Num() != Gestures[i].Samples.Num() || PackedGestureHashes[i] != GetGestureSamplesHash(Gestures[i].Samples))
+		{
+			SCOPE_CYCLE_COUNTER(STAT_PackGestures);
+			PackGesture(i);
+		}
+	}
 }
 
 bool UGesturesDatabase::ImportSplineAsGesture(USplineComponent * HostSplineComponent, FString GestureName, bool bKeepSplineCurves, float SegmentLen, bool bScaleToDatabase)
@@ -670,6 +1163,7 @@ bool UGesturesDatabase::ImportSplineAsGesture(USplineComponent * HostSplineCompo
 
 	NewGesture.CalculateSizeOfGesture(bScaleToDatabase, this->TargetGestureScale);
 	Gestures.Add(NewGesture);
+	PackGestures();
 	return true;
 }
 
@@ -787,5 +1281,6 @@ void UVRGestureComponent::SaveRecording(FVRGesture &Recording, FString Recording
 		Recording.CalculateSizeOfGesture(bScaleRecordingToDatabase, GesturesDB->TargetGestureScale);
 		Recording.Name = RecordingName;
 		GesturesDB->Gestures.Add(Recording);
+		GesturesDB->PackGestures();
 	}
 }
@@ -6,11 +6,22 @@
 #include "AI/NavigationSystemBase.h"
 #include "VRBaseCharacterMovementComponent.h"
 #include "VRPathFollowingComponent.h"
+#include "Misc/VRClientAuthThrowBatchSubsystem.h"
 //#include "VRBPDatatypes.h"
 #include "Engine/Player.h"
 //#include "Runtime/Engine/Private/EnginePrivate.h"
 
 
+bool AVRBasePlayerController::Server_GetClientAuthReplicationBatch_Validate(const TArray<FVRClientAuthMovementBatchEntry>& MovementBatch)
+{
+	return true;
+}
+
+void AVRBasePlayerController::Server_GetClientAuthReplicationBatch_Implementation(const TArray<FVRClientAuthMovementBatchEntry>& MovementBatch)
+{
+	UVRClientAuthThrowBatchSubsystem::ApplyClientAuthMovementBatch(this, MovementBatch);
+}
+
 AVRPlayerController::AVRPlayerController(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
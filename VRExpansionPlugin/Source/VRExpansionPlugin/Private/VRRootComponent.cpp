@@ -21,6 +21,27 @@ DEFINE_LOG_CATEGORY(LogVRRootComponent);
 DECLARE_CYCLE_STAT(TEXT("VRRootMovement"), STAT_VRRootMovement, STATGROUP_VRRootComponent);
 DECLARE_CYCLE_STAT(TEXT("PerformOverlapQueryVR Time"), STAT_PerformOverlapQueryVR, STATGROUP_VRRootComponent);
 DECLARE_CYCLE_STAT(TEXT("UpdateOverlapsVRRoot Time"), STAT_UpdateOverlapsVRRoot, STATGROUP_VRRootComponent);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skipped Overlap Updates"), STAT_VRRootSkippedOverlapUpdates, STATGROUP_VRRootComponent);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sleeping Remote Roots"), STAT_VRRootSleepingRemoteRoots, STATGROUP_VRRootComponent);
+
+namespace VRRootComponentCVars
+{
+	static int32 SleepRemoteTick = 0;
+	FAutoConsoleVariableRef CVarSleepRemoteTick(
+		TEXT("vre.VRRoot.SleepRemoteTick"),
+		SleepRemoteTick,
+		TEXT("When on, VR roots that are not locally controlled stop ticking while their replicated camera is still and are woken by its transform updates.\n")
+		TEXT("0: Disable, 1: Enable"),
+		ECVF_Default);
+
+	static float OverlapSkipDistance = 0.0f;
+	FAutoConsoleVariableRef CVarOverlapSkipDistance(
+		TEXT("vre.VRRoot.OverlapSkipDistance"),
+		OverlapSkipDistance,
+		TEXT("Locally controlled VR roots skip the overlap and physics volume update of movement that stays within this distance (cm) of the last full update.\n")
+		TEXT("0: Disable"),
+		ECVF_Default);
+}
 
 typedef TArray<const FOverlapInfo*, TInlineAllocator<8>> TInlineOverlapPointerArray;
 
@@ -448,6 +469,73 @@ void UVRRootComponent::BeginPlay()
 	owningVRChar = NULL;
 }
 
+void UVRRootComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bRemoteTickSleeping)
+	{
+		DEC_DWORD_STAT(STAT_VRRootSleepingRemoteRoots);
+		bRemoteTickSleeping = false;
+	}
+
+	if (USceneComponent* WakeComponent = RemoteTickWakeComponent.Get())
+	{
+		WakeComponent->TransformUpdated.Remove(RemoteTickWakeHandle);
+	}
+
+	RemoteTickWakeComponent.Reset();
+	RemoteTickWakeHandle.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UVRRootComponent::WakeRemoteTick()
+{
+	if (bRemoteTickSleeping)
+	{
+		SetRemoteTickSleeping(false);
+	}
+}
+
+void UVRRootComponent::SetRemoteTickSleeping(bool bSleep)
+{
+	if (bSleep == bRemoteTickSleeping)
+		return;
+
+	if (bSleep)
+	{
+		// Bind to the component that we read the camera pose from, it is what wakes us back up
+		if (RemoteTickWakeComponent.Get() != TargetPrimitiveComponent)
+		{
+			if (USceneComponent* OldWakeComponent = RemoteTickWakeComponent.Get())
+			{
+				OldWakeComponent->TransformUpdated.Remove(RemoteTickWakeHandle);
+			}
+
+			RemoteTickWakeComponent = TargetPrimitiveComponent;
+			RemoteTickWakeHandle = TargetPrimitiveComponent->TransformUpdated.AddUObject(this, &UVRRootComponent::OnTargetTransformUpdated);
+		}
+
+		INC_DWORD_STAT(STAT_VRRootSleepingRemoteRoots);
+	}
+	else
+	{
+		DEC_DWORD_STAT(STAT_VRRootSleepingRemoteRoots);
+	}
+
+	bRemoteTickSleeping = bSleep;
+	SetComponentTickEnabled(!bSleep);
+}
+
+void UVRRootComponent::OnTargetTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	// Also fires when we move the camera with us, only a change in its relative pose needs a tick
+	if (bRemoteTickSleeping && UpdatedComponent == TargetPrimitiveComponent &&
+		(!UpdatedComponent->GetRelativeLocation().Equals(lastCameraLoc, 0.01f) || !UpdatedComponent->GetRelativeRotation().Equals(lastCameraRot, 0.01f)))
+	{
+		SetRemoteTickSleeping(false);
+	}
+}
+
 void UVRRootComponent::SetTrackingPaused(bool bPaused)
 {
 	bPauseTracking = bPaused;
@@ -720,6 +808,11 @@ void UVRRootComponent::TickComponent(float DeltaTime, enum ELevelTick TickType,
 			lastCameraRot = curCameraRot;
 			lastCameraLoc = curCameraLoc;
 		}
+		else if (VRRootComponentCVars::SleepRemoteTick && TargetPrimitiveComponent && !(owningVRChar && owningVRChar->bTrackingPaused))
+		{
+			// Nothing to update until the camera moves again
+			SetRemoteTickSleeping(true);
+		}
 	}
 
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -1239,6 +1332,20 @@ bool UVRRootComponent::UpdateOverlapsImpl(const TOverlapArrayView* NewPendingOve
 		return false;
 	}
 
+	// Movement passes its (possibly empty) pending overlaps, other callers like collision setting changes pass none and always update.
+	// Small roomscale movement from tracking noise doesn't need a new overlap query or physics volume lookup.
+	if (VRRootComponentCVars::OverlapSkipDistance > 0.0f && NewPendingOverlaps && NewPendingOverlaps->Num() == 0 && !OverlapsAtEndLocation &&
+		FMath::IsNearlyEqual(LastOverlapUpdateHalfHeight, CapsuleHalfHeight) &&
+		FVector::DistSquared(OffsetComponentToWorld.GetLocation(), LastOverlapUpdateLocation) < FMath::Square(VRRootComponentCVars::OverlapSkipDistance) &&
+		owningVRChar && IsLocallyControlled())
+	{
+		INC_DWORD_STAT(STAT_VRRootSkippedOverlapUpdates);
+		return false;
+	}
+
+	LastOverlapUpdateLocation = OffsetComponentToWorld.GetLocation();
+	LastOverlapUpdateHalfHeight = CapsuleHalfHeight;
+
 	bool bCanSkipUpdateOverlaps = true;
 
 	// first, dispatch any pending overlaps
@@ -584,6 +584,104 @@ private:
 };
 
 
+// Capsule values of a previously replicated move that newer moves can be delta encoded against
+struct FVRMoveDeltaBase
+{
+	float TimeStamp;
+	FVector VRCapsuleLocation;
+	float CapsuleHalfHeight;
+
+	FVRMoveDeltaBase() :
+		TimeStamp(0.0f),
+		VRCapsuleLocation(FVector::ZeroVector),
+		CapsuleHalfHeight(0.0f)
+	{}
+
+	FVRMoveDeltaBase(float InTimeStamp, const FVector& InCapsuleLocation, float InCapsuleHalfHeight);
+};
+
+// Tracks the state needed for delta encoding the capsule values of moves.
+// On the server it is a ring of the last received values that acked moves are looked up in, on the client it counts moves between full sends.
+struct VREXPANSIONPLUGIN_API FVRMoveDeltaHistory
+{
+	static const int32 MaxEntries = 64;
+
+	// Oldest base that a client will delta against, the server keeps at least this much history at up to MaxEntries / MaxBaseAge moves per second
+	static constexpr float MaxBaseAge = 0.25f;
+
+	// A full capsule location is sent at least this often so that any server side mismatch can't persist
+	static const int32 KeyframeInterval = 30;
+
+	// Largest capsule delta per axis that fits the packed delta without clamping, anything further sends the full location
+	static constexpr float MaxCapsuleDelta = 40000.0f;
+
+	TArray<FVRMoveDeltaBase> Entries;
+	int32 NextEntry;
+	int32 MovesSinceKeyframe;
+
+	FVRMoveDeltaHistory() :
+		NextEntry(0),
+		MovesSinceKeyframe(0)
+	{}
+
+	void Add(const FVRMoveDeltaBase& Entry);
+
+	// Returns the entry closest to BaseTimeStamp if it is within the millisecond precision that the base age is sent at
+	const FVRMoveDeltaBase* Find(float BaseTimeStamp) const;
+
+	// Clears the history and makes the next client move a keyframe, for when the two sides may no longer agree on it
+	void Reset();
+};
+
+// Recent floor results that are reused while the capsule, its size and the floor component are unchanged.
+// Idle roomscale players only move by tracking noise, so this saves them a floor sweep every frame.
+struct VREXPANSIONPLUGIN_API FVRFloorCache
+{
+	// Room for the regular floor check and the perch check
+	static const int32 MaxEntries = 2;
+
+	struct FEntry
+	{
+		FFindFloorResult FloorResult;
+		FVector CapsuleLocation;
+		float LineDistance;
+		float SweepDistance;
+		float SweepRadius;
+		float CapsuleHalfHeight;
+		TWeakObjectPtr<UPrimitiveComponent> FloorComponent;
+		FTransform FloorTransform;
+		uint64 FrameStored;
+		bool bValid;
+
+		FEntry() :
+			CapsuleLocation(FVector::ZeroVector),
+			LineDistance(0.0f),
+			SweepDistance(0.0f),
+			SweepRadius(0.0f),
+			CapsuleHalfHeight(0.0f),
+			FloorTransform(FTransform::Identity),
+			FrameStored(0),
+			bValid(false)
+		{}
+	};
+
+	FEntry Entries[MaxEntries];
+	int32 NextEntry;
+
+	FVRFloorCache() :
+		NextEntry(0)
+	{}
+
+	// Fills OutFloorResult if an entry was stored within MaxAgeFrames for the same trace settings, within Tolerance of CapsuleLocation, and its floor hasn't moved.
+	// The floor distances are corrected for the height difference to the stored location.
+	bool Find(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, float SweepRadius, float CapsuleHalfHeight, float Tolerance, uint64 MaxAgeFrames, FFindFloorResult& OutFloorResult) const;
+
+	// Only walkable floors on non simulating components are stored
+	void Add(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, float SweepRadius, float CapsuleHalfHeight, const FFindFloorResult& FloorResult);
+
+	void Invalidate();
+};
+
 class VREXPANSIONPLUGIN_API FSavedMove_VRBaseCharacter : public FSavedMove_Character
 {
 
@@ -632,7 +730,10 @@ struct VREXPANSIONPLUGIN_API FVRCharacterNetworkMoveData : public FCharacterNetw
 public:
 
 	FVector_NetQuantize100 VRCapsuleLocation;
-	FVector/*_NetQuantize100*/ LFDiff;
+
+	// X/Y are the relative movement, pre-rounded by the root component to the precision that they are sent at
+	// Z is re-purposed as the capsule half height
+	FVector LFDiff;
 	uint16 VRCapsuleRotation;
 	EVRConjoinedMovementModes ReplicatedMovementMode;
 	FVRConditionalMoveRep ConditionalMoveReps;
@@ -642,6 +743,10 @@ public:
 	virtual ~FVRCharacterNetworkMoveData();
 	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
 	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
+
+	// Serializes VRCapsuleLocation and LFDiff, TimeStamp must already be serialized.
+	// When compact the capsule location is delta encoded against DeltaBase (saving) or the matching DeltaHistory entry (loading), and the half height is split out of LFDiff.
+	bool SerializeVRCapsuleValues(FArchive& Ar, UPackageMap* PackageMap, bool bCompact, bool bRetainRoomscale, const FVRMoveDeltaBase* DeltaBase, FVRMoveDeltaHistory* DeltaHistory);
 };
 
 struct VREXPANSIONPLUGIN_API FVRCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
@@ -662,6 +767,9 @@ public:
 	{
 	}
 
+	// Copies the received moves of another container so that they can be handled later, our data pointers keep pointing at our own storage
+	void CopyMoveData(const FCharacterNetworkMoveDataContainer& Other);
+
 	/**
  * Passes through calls to ClientFillNetworkMoveData on each FCharacterNetworkMoveData matching the client moves. Note that ClientNewMove will never be null, but others may be.
  */
@@ -37,6 +37,7 @@ struct FXRDeviceId;
 DECLARE_LOG_CATEGORY_EXTERN(LogVRMotionController, Log, All);
 //For UE4 Profiler ~ Stat Group
 DECLARE_STATS_GROUP(TEXT("TICKGrip"), STATGROUP_TickGrip, STATCAT_Advanced);
+DECLARE_STATS_GROUP(TEXT("GripDispatch"), STATGROUP_GripDispatch, STATCAT_Advanced);
 
 /** Delegate for notification when the controllers tracking changes. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FVRGripControllerOnTrackingEventSignature, const ETrackingStatus &, NewTrackingStatus);
@@ -87,11 +88,20 @@ public:
 
 	/** A utility method that calls CacheSceneInfo on ParentComponent and all of its descendants */
 	void GatherLateUpdatePrimitives(USceneComponent* ParentComponent);
-	void ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent* MotionController, TArray<FBPActorGripInformation> & GripArray);
+	void ProcessGripArrayLateUpdatePrimitives(UGripMotionControllerComponent* MotionController, const TArray<FBPActorGripInformation> & GripArray);
 
 	/** Generates a LateUpdatePrimitiveInfo for the given component if it has a SceneProxy and appends it to the current LateUpdatePrimitives array */
 	void CacheSceneInfo(USceneComponent* Component);
 
+	struct FLateUpdatePrimitive
+	{
+		FPrimitiveSceneInfo* SceneInfo;
+		/** Scene index at the time of caching, -1 once processed this frame */
+		int32 Index;
+		/** FPersistentPrimitiveIndex, used to re-resolve the primitive if the scene indices have shifted since caching */
+		int32 PersistentIndex;
+	};
+
 	struct FLateUpdateState
 	{
 		FLateUpdateState()
@@ -103,7 +113,7 @@ public:
 		/** Parent world transform used to reconstruct new world transforms for late update scene proxies */
 		FTransform ParentToWorld;
 		/** Primitives that need late update before rendering */
-		TMap<FPrimitiveSceneInfo*, int32> Primitives;
+		TArray<FLateUpdatePrimitive> Primitives;
 		/** Late Update Info Stale, if this is found true do not late update */
 		bool bSkip;
 		/** Frame tracking number - used to flag if the game and render threads get badly out of sync */
@@ -113,6 +123,31 @@ public:
 	FLateUpdateState UpdateStates[2];
 	int32 LateUpdateGameWriteIndex;
 	int32 LateUpdateRenderReadIndex;
+
+private:
+
+	/** Descendants of a late update root, kept between frames and only rebuilt when the attachment under it changes */
+	struct FLateUpdateHierarchy
+	{
+		/** Breadth first, root first */
+		TArray<TWeakObjectPtr<USceneComponent>> Components;
+		TArray<int32> ParentIndices;
+		TArray<int32> ChildCounts;
+		uint32 LastUsedGather = 0;
+
+		bool IsValidFor(const USceneComponent* Root) const;
+		void Rebuild(USceneComponent* Root);
+	};
+
+	TMap<TObjectKey<USceneComponent>, FLateUpdateHierarchy> CachedHierarchies;
+
+	/** Scene infos already added this gather, a component can be reached from more than one root */
+	TSet<FPrimitiveSceneInfo*> GatheredSceneInfos;
+
+	/** Reused when checking grip scripts */
+	TArray<UVRGripScriptBase*> GripScriptsScratch;
+
+	uint32 GatherCount;
 };
 
 /**
@@ -269,6 +304,20 @@ public:
 
 	FTransform LastSmoothRelativeTransform;
 
+	// Polls the controller ahead of its tick and hands the raw pose to the shared smoothing bank, see UVRTrackingSmoothingSubsystem
+	// UpdateTracking then uses this frames polled state and the banks filtered pose instead of polling and filtering again
+	void PrePollTrackingForSmoothing();
+
+	// Registers the 1 Euro smoothing with the tracking smoothing subsystem when banked smoothing is on
+	void UpdateBankedSmoothingRegistration();
+
+	bool bRegisteredForBankedSmoothing;
+	uint64 PrePolledTrackingFrame;
+	FVector PrePolledPosition;
+	FRotator PrePolledOrientation;
+	bool bPrePolledTrackedState;
+	ETrackingStatus PrePolledLastTrackingStatus;
+
 	// Type of velocity calculation to use for the motion controller
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GripMotionController|ComponentVelocity")
 		EVRVelocityType VelocityCalculationType;
@@ -872,6 +921,13 @@ public:
 	UPROPERTY(EditAnywhere, Category = "GripMotionController|Networking|Smoothing", meta = (editcondition = "bUseExponentialSmoothing"))
 		float NetworkNoSmoothUpdateDistance = 100.f;
 
+	// Buffered snapshot interpolation, overrides the lerp and exponential smoothing when enabled
+	// NetworkNoSmoothUpdateDistance still applies and snaps on large jumps
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GripMotionController|Networking|Smoothing", meta = (editcondition = "bSmoothReplicatedMotion"))
+		FBPVRSnapshotInterpolationSettings SnapshotInterpolation;
+
+	FVRSnapshotBuffer SnapshotBuffer;
+
 	// Whether to replicate even if no tracking (FPS or test characters)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "GripMotionController|Networking")
 		bool bReplicateWithoutTracking;
@@ -1081,6 +1137,14 @@ public:
 	//UFUNCTION(Reliable, NetMulticast)
 	bool NotifyGrip(FBPActorGripInformation &NewGrip, bool bIsReInit = false);
 
+	// Rebuilds the cached interface / grip script dispatch information for all grips on this object
+	// Call this if you add, remove, or change the transform override type of grip scripts while the object is held
+	UFUNCTION(BlueprintCallable, Category = "GripMotionController")
+	void RefreshGripDispatchCache(UObject* GrippedObjectToRefresh);
+
+	// Resolves the interface target and grip scripts for a grip and stores them in its dispatch cache
+	void BuildGripDispatchCache(FBPActorGripInformation& Grip, UPrimitiveComponent* root, AActor* actor);
+
 	UFUNCTION(Reliable, NetMulticast)
 	void NotifyDrop(const FBPActorGripInformation &NewDrop, bool bSimulate);
 
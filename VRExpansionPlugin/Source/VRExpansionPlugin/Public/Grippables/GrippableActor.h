@@ -13,6 +13,7 @@
 #include "Engine/ActorChannel.h"
 #include "Grippables/GrippableDataTypes.h"
 #include "Grippables/GrippablePhysicsReplication.h"
+#include "Misc/BucketUpdateSubsystem.h"
 #include "GrippableActor.generated.h"
 
 class UGripMotionControllerComponent;
@@ -92,6 +93,9 @@ public:
 	UFUNCTION()
 	bool PollReplicationEvent();
 
+	// Entry in the bucket update subsystem while client auth throwing
+	FBucketUpdateHandle ClientAuthBucketHandle;
+
 	UFUNCTION(Category = "Networking")
 		void CeaseReplicationBlocking();
 
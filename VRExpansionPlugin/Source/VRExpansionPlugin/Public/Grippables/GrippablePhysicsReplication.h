@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Physics/PhysicsInterfaceUtils.h"
 #include "PhysicsReplication.h"
+#include "VRBPDatatypes.h"
 
 
 
@@ -24,6 +25,7 @@
 
 //#if PHYSICS_INTERFACE_PHYSX
 struct FAsyncPhysicsRepCallbackDataVR;
+class AVRBasePlayerController;
 class FPhysicsReplicationAsyncCallbackVR;
 
 class FPhysicsReplicationVR : public FPhysicsReplication
@@ -79,6 +81,21 @@ public:
 	void CopyTo(FRepMovement& other) const;
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
 	bool GatherActorsMovement(AActor* OwningActor);
+
+	// Profile that the quantization levels were set from, sent ahead of the movement so the receiver reads it back the same way
+	EVRMovementQuantizationProfile QuantizationProfile;
+
+	// Sets the quantization levels from a profile, call before gathering so that the velocity range is applied
+	void SetQuantizationProfile(EVRMovementQuantizationProfile NewProfile);
+
+	// Location / rotation / velocity quantization and the velocity range of a profile, a zero max velocity is unclamped
+	static void GetQuantizationSettings(EVRMovementQuantizationProfile Profile, EVectorQuantization& OutLocationLevel, ERotatorQuantization& OutRotationLevel, EVectorQuantization& OutVelocityLevel, float& OutMaxLinearVelocity, float& OutMaxAngularVelocity);
+
+	// Clamps the velocities to the range of the current profile, GatherActorsMovement already applies this
+	void ClampVelocitiesToProfile();
+
+	// Exact number of bits that NetSerialize writes for the current values
+	int64 GetSerializedBits() const;
 };
 
 template<>
@@ -91,6 +108,29 @@ struct TStructOpsTypeTraits<FRepMovementVR> : public TStructOpsTypeTraitsBase2<F
 	};
 };
 
+// A single objects client auth movement inside of a batched throw replication RPC
+USTRUCT()
+struct VREXPANSIONPLUGIN_API FVRClientAuthMovementBatchEntry
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY()
+		TObjectPtr<AActor> MovedActor;
+
+	UPROPERTY()
+		FRepMovementVR Movement;
+
+	FVRClientAuthMovementBatchEntry() :
+		MovedActor(nullptr)
+	{}
+
+	FVRClientAuthMovementBatchEntry(AActor* InActor, const FRepMovementVR& InMovement) :
+		MovedActor(InActor),
+		Movement(InMovement)
+	{}
+};
+
 USTRUCT(BlueprintType)
 struct VREXPANSIONPLUGIN_API FVRClientAuthReplicationData
 {
@@ -110,12 +150,19 @@ public:
 	float TimeAtInitialThrow;
 	bool bIsCurrentlyClientAuth;
 
+	// Taken from the grip interfaces advanced settings when the throw starts
+	EVRMovementQuantizationProfile QuantizationProfile;
+
+	// Local player controller that batches the throws movement, resolved when the throw starts
+	TWeakObjectPtr<AVRBasePlayerController> BatchingController;
+
 	FVRClientAuthReplicationData() :
 		bUseClientAuthThrowing(false),
 		UpdateRate(30),
 		LastActorTransform(FTransform::Identity),
 		TimeAtInitialThrow(0.0f),
-		bIsCurrentlyClientAuth(false)
+		bIsCurrentlyClientAuth(false),
+		QuantizationProfile(EVRMovementQuantizationProfile::VRQUANT_Default)
 	{
 
 	}
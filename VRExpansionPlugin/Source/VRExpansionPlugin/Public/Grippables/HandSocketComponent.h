@@ -213,6 +213,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Hand Socket Data", meta = (bIgnoreSelf = "true"))
 		static bool GetAnimationSequenceAsPoseSnapShot(UAnimSequence * InAnimationSequence, FPoseSnapshot& OutPoseSnapShot, USkeletalMeshComponent* TargetMesh = nullptr, bool bSkipRootBone = false, bool bFlipHand = false);
 
+	/**
+	* Clears the cached pose snapshots, they are built once per animation / target mesh / handedness and reused for every grip after
+	* Only needed if animation data is changed at runtime, editor modifications of the assets clear the cache on their own
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Hand Socket Data", meta = (bIgnoreSelf = "true"))
+		static void ClearCachedPoseSnapShots();
+
 	// Returns the target relative transform of the hand
 	//UFUNCTION(BlueprintCallable, Category = "Hand Socket Data")
 	FTransform GetHandRelativePlacement();
@@ -5,16 +5,31 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "Tickable.h"
+#include "UObject/ObjectKey.h"
 #include "BucketUpdateSubsystem.generated.h"
 //#include "GrippablePhysicsReplication.generated.h"
 
 
 //DECLARE_DYNAMIC_MULTICAST_DELEGATE(FVRPhysicsReplicationDelegate, void, Return);
 
+DECLARE_STATS_GROUP(TEXT("BucketUpdates"), STATGROUP_BucketUpdates, STATCAT_Advanced);
+
 
 DECLARE_DELEGATE_RetVal(bool, FBucketUpdateTickSignature);
 DECLARE_DYNAMIC_DELEGATE(FDynamicBucketUpdateTickSignature);
 
+// Identifies a single bucket entry, returned from the native registration functions so that it can be removed without a search
+struct VREXPANSIONPLUGIN_API FBucketUpdateHandle
+{
+	uint64 ID = 0;
+
+	bool IsValid() const { return ID != 0; }
+	void Reset() { ID = 0; }
+
+	bool operator==(const FBucketUpdateHandle& Other) const { return ID == Other.ID; }
+	bool operator!=(const FBucketUpdateHandle& Other) const { return ID != Other.ID; }
+};
+
 USTRUCT()
 struct VREXPANSIONPLUGIN_API FUpdateBucketDrop
 {
@@ -25,6 +40,10 @@ public:
 	
 	FName FunctionName;
 
+	// Set by the container when added
+	uint64 HandleID;
+	TObjectKey<UObject> OwnerKey;
+
 	bool ExecuteBoundCallback();
 	bool IsBoundToObjectFunction(UObject * Obj, FName & FuncName);
 	bool IsBoundToObjectDelegate(FDynamicBucketUpdateTickSignature & DynEvent);
@@ -32,9 +51,36 @@ public:
 	FUpdateBucketDrop();
 	FUpdateBucketDrop(FDynamicBucketUpdateTickSignature & DynCallback);
 	FUpdateBucketDrop(UObject * Obj, FName FuncName);
+	FUpdateBucketDrop(FBucketUpdateTickSignature && NativeCallback, FName FuncName = NAME_None);
 };
 
 
+// Per bucket information for profiling
+USTRUCT(BlueprintType, Category = "BucketUpdateSubsystem")
+struct VREXPANSIONPLUGIN_API FBPBucketUpdateStats
+{
+	GENERATED_BODY()
+public:
+
+	UPROPERTY(BlueprintReadOnly, Category = "BucketUpdateSubsystem")
+		int32 UpdateHTZ = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "BucketUpdateSubsystem")
+		int32 NumCallbacks = 0;
+
+	// Callbacks that were fired on the last subsystem tick
+	UPROPERTY(BlueprintReadOnly, Category = "BucketUpdateSubsystem")
+		int32 CallbacksFiredLastTick = 0;
+
+	// Time spent in this buckets callbacks on the last subsystem tick
+	UPROPERTY(BlueprintReadOnly, Category = "BucketUpdateSubsystem")
+		float LastTickTimeMs = 0.0f;
+
+	// Number of ticks that this bucket had callbacks deferred by the frame budget
+	UPROPERTY(BlueprintReadOnly, Category = "BucketUpdateSubsystem")
+		int32 OverBudgetCount = 0;
+};
+
 USTRUCT()
 struct VREXPANSIONPLUGIN_API FUpdateBucket
 {
@@ -45,15 +91,46 @@ public:
 	float nUpdateRate;
 	float nUpdateCount;
 
+	// Callbacks before this index have already fired in the current period
+	int32 NextCallbackIndex;
+
+	// Profiling
+	int32 CallbacksFiredLastUpdate;
+	double LastUpdateTime;
+	int32 OverBudgetCount;
+
 	TArray<FUpdateBucketDrop> Callbacks;
 
-	bool Update(float DeltaTime);
+	// Index into Callbacks for each handle in this bucket
+	TMap<uint64, int32> HandleIndices;
+
+	// Fires the callbacks that are due, if bSpreadLoad then they are distributed evenly across the period instead of all firing on one frame
+	// Stops early once FPlatformTime::Seconds() passes BudgetEndTime, this buckets deferred callbacks are the first of it to fire on its next update
+	// The container rotates which bucket starts each update so that a shared budget doesn't starve the same buckets every frame
+	// Callbacks that asked to be removed are appended to OutRemovedHandles so the container can update its lookups
+	bool Update(float DeltaTime, bool bSpreadLoad, double BudgetEndTime, TArray<TPair<uint64, TObjectKey<UObject>>>& OutRemovedHandles);
+
+	// Removes without disturbing which callbacks have already fired this period, returns the removed handle
+	uint64 RemoveCallbackAt(int32 Index, TObjectKey<UObject>* OutOwnerKey = nullptr);
 
-	FUpdateBucket() {}
+	void AddCallback(FUpdateBucketDrop && NewDrop);
+
+	FUpdateBucket() :
+		nUpdateRate(0.0f),
+		nUpdateCount(0.0f),
+		NextCallbackIndex(0),
+		CallbacksFiredLastUpdate(0),
+		LastUpdateTime(0.0),
+		OverBudgetCount(0)
+	{}
 
 	FUpdateBucket(uint32 UpdateHTZ) :
 		nUpdateRate(1.0f / UpdateHTZ),
-		nUpdateCount(0.0f)
+		nUpdateCount(0.0f),
+		NextCallbackIndex(0),
+		CallbacksFiredLastUpdate(0),
+		LastUpdateTime(0.0),
+		OverBudgetCount(0)
 	{
 	}
 };
@@ -68,8 +145,27 @@ public:
 	bool bNeedsUpdate;
 	TMap<uint32, FUpdateBucket> ReplicationBuckets;
 
+	// Lookup tables so that removal and queries don't need to scan every bucket
+	TMap<uint64, uint32> HandleBuckets;
+	TMultiMap<TObjectKey<UObject>, uint64> ObjectHandles;
+	uint64 NextHandleID;
+
+	// Reused between updates to avoid allocating every tick
+	TArray<TPair<uint64, TObjectKey<UObject>>> RemovedHandles;
+	TArray<uint32> BucketUpdateOrder;
+
+	// Which bucket goes first on the next update, advanced every update
+	uint32 NextStartingBucket;
+
 	void UpdateBuckets(float DeltaTime);
 
+	// Native path, the callback is invoked directly instead of through reflection
+	// Owner is optional and only used to find the entry with the object based queries
+	// FunctionName is optional and lets the function name based queries match the entry
+	FBucketUpdateHandle AddBucketCallback(uint32 UpdateHTZ, FBucketUpdateTickSignature && Callback, UObject* Owner, FName FunctionName = NAME_None);
+	bool RemoveBucketCallback(FBucketUpdateHandle Handle);
+	bool IsHandleInBucket(FBucketUpdateHandle Handle) const;
+
 	bool AddBucketObject(uint32 UpdateHTZ, UObject* InObject, FName FunctionName);
 	bool AddBucketObject(uint32 UpdateHTZ, FDynamicBucketUpdateTickSignature &Delegate);
 
@@ -88,11 +184,24 @@ public:
 	bool IsObjectFunctionInBucket(UObject * ObjectToRemove, FName FunctionName);
 	bool IsObjectDelegateInBucket(FDynamicBucketUpdateTickSignature &DynEvent);
 
+	void GetBucketStats(TArray<FBPBucketUpdateStats>& OutStats) const;
+
 	FUpdateBucketContainer()
 	{
 		bNeedsUpdate = false;
+		NextHandleID = 0;
+		NextStartingBucket = 0;
 	};
 
+private:
+
+	FBucketUpdateHandle AddDrop(uint32 UpdateHTZ, FUpdateBucketDrop && NewDrop, UObject* Owner);
+
+	// Returns the bucket and index of an entry, nullptr if it isn't in one
+	FUpdateBucket* FindHandle(uint64 HandleID, int32& OutIndex);
+	bool RemoveByHandleID(uint64 HandleID);
+	void ForgetHandle(uint64 HandleID, const TObjectKey<UObject>& OwnerKey);
+
 };
 
 UCLASS()
@@ -120,6 +229,39 @@ public:
 	// If one of the bucket contains an entry with the function already then the existing one is removed and the new one is added
 	bool AddObjectToBucket(int32 UpdateHTZ, UObject* InObject, FName FunctionName);
 
+	// Adds a native member function to an update bucket, it is called directly instead of through ProcessEvent
+	// Unlike the function name version this does not replace existing entries, remove the old handle first
+	// Return false from the function to be removed from the bucket
+	// Pass the FunctionName (GET_FUNCTION_NAME_CHECKED) if the entry should also be found by the function name based queries
+	template<typename UserClass>
+	FBucketUpdateHandle AddNativeObjectToBucket(int32 UpdateHTZ, UserClass* InObject, bool (UserClass::*InFunc)(), FName FunctionName = NAME_None)
+	{
+		if (!InObject || !InFunc || UpdateHTZ < 1)
+			return FBucketUpdateHandle();
+
+		return BucketContainer.AddBucketCallback(UpdateHTZ, FBucketUpdateTickSignature::CreateUObject(InObject, InFunc), InObject, FunctionName);
+	}
+
+	// Adds a lambda to an update bucket, if an Owner is passed in then it won't be called after the owner is destroyed
+	template<typename FunctorType>
+	FBucketUpdateHandle AddLambdaToBucket(int32 UpdateHTZ, FunctorType&& InFunctor, UObject* Owner = nullptr)
+	{
+		if (UpdateHTZ < 1)
+			return FBucketUpdateHandle();
+
+		if (Owner)
+		{
+			return BucketContainer.AddBucketCallback(UpdateHTZ, FBucketUpdateTickSignature::CreateWeakLambda(Owner, Forward<FunctorType>(InFunctor)), Owner);
+		}
+
+		return BucketContainer.AddBucketCallback(UpdateHTZ, FBucketUpdateTickSignature::CreateLambda(Forward<FunctorType>(InFunctor)), nullptr);
+	}
+
+	// Removes an entry added through the native functions and resets the handle
+	bool RemoveFromBucketByHandle(FBucketUpdateHandle& Handle);
+
+	bool IsHandleInBucket(const FBucketUpdateHandle& Handle) const;
+
 	// Adds an object to an update bucket with the set HTZ, calls the passed in UFUNCTION name
 	// If one of the bucket contains an entry with the function already then the existing one is removed and the new one is added
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Object to Bucket Updates", ScriptName = "AddObjectToBucket"), Category = "BucketUpdateSubsystem")
@@ -148,6 +290,10 @@ public:
 	UFUNCTION(BlueprintPure, Category = "BucketUpdateSubsystem")
 		bool IsActive();
 
+	// Returns the callback count and last tick cost of each active bucket
+	UFUNCTION(BlueprintCallable, Category = "BucketUpdateSubsystem")
+		void GetBucketStats(TArray<FBPBucketUpdateStats>& OutStats);
+
 	// FTickableGameObject functions
 	/**
 	 * Function called every frame on this GripScript. Override this function to implement custom logic to be executed every frame.
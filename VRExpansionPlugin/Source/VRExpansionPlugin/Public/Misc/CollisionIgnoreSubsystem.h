@@ -13,6 +13,7 @@
 #include "Chaos/SimCallbackObject.h"
 #include "Chaos/SimCallbackInput.h"
 #include "Chaos/ParticleHandle.h"
+#include "Containers/Queue.h"
 //#include "Chaos/ContactModification.h"
 //#include "PBDRigidsSolver.h"
 
@@ -24,6 +25,7 @@
 
 
 DECLARE_LOG_CATEGORY_EXTERN(VRE_CollisionIgnoreLog, Log, All);
+DECLARE_STATS_GROUP(TEXT("CollisionIgnore"), STATGROUP_CollisionIgnore, STATCAT_Advanced);
 
 
 USTRUCT()
@@ -53,6 +55,35 @@ struct FChaosParticlePair
 			(ParticleHandle1 == Other.ParticleHandle1 || ParticleHandle1 == Other.ParticleHandle0)
 			);
 	}
+
+	// Order independent so that either particle ordering finds the same pair
+	friend uint32 GetTypeHash(const FChaosParticlePair& InKey)
+	{
+		return GetTypeHash(InKey.ParticleHandle0) ^ GetTypeHash(InKey.ParticleHandle1);
+	}
+};
+
+enum class EChaosParticlePairDeltaType : uint8
+{
+	AddPair,
+	RemovePair,
+	ClearPairs
+};
+
+// A single change to the physics thread ignore set
+struct FChaosParticlePairDelta
+{
+	FChaosParticlePair Pair;
+	EChaosParticlePairDeltaType DeltaType;
+
+	FChaosParticlePairDelta() :
+		DeltaType(EChaosParticlePairDeltaType::AddPair)
+	{}
+
+	FChaosParticlePairDelta(const FChaosParticlePair& InPair, EChaosParticlePairDeltaType InDeltaType) :
+		Pair(InPair),
+		DeltaType(InDeltaType)
+	{}
 };
 
 /*
@@ -63,11 +94,8 @@ struct FSimCallbackInputVR : public Chaos::FSimCallbackInput
 	virtual ~FSimCallbackInputVR() {}
 	void Reset() 
 	{
-		ParticlePairs.Empty();
 	}
 
-	TArray<FChaosParticlePair> ParticlePairs;
-
 	bool bIsInitialized;
 };
 
@@ -78,16 +106,30 @@ struct FSimCallbackNoOutputVR : public Chaos::FSimCallbackOutput
 
 class FCollisionIgnoreSubsystemAsyncCallback : public Chaos::TSimCallbackObject<FSimCallbackInputVR, FSimCallbackNoOutputVR, Chaos::ESimCallbackOptions::ContactModification>
 {
+public:
+
+	// Queues an add / remove for the physics thread pair set, only call from the game thread.
+	// Deltas go through a queue instead of the per step input so that none are lost if inputs get coalesced between steps.
+	void QueuePairDelta_External(const FChaosParticlePair& Pair, EChaosParticlePairDeltaType DeltaType)
+	{
+		PendingPairDeltas.Enqueue(FChaosParticlePairDelta(Pair, DeltaType));
+	}
 
 private:
 	
 	virtual void OnPreSimulate_Internal() override
 	{
-		// Copy paired bodies here?
-
-		// Actually use input data to input our paired bodies and copy over here
+		ConsumePairDeltas_Internal();
 	}
 
+	// Applies all pending game thread changes to the persistent pair set
+	void ConsumePairDeltas_Internal();
+
+	TQueue<FChaosParticlePairDelta, EQueueMode::Spsc> PendingPairDeltas;
+
+	// Physics thread owned set of ignored particle pairs, hashed so that the contact lookup is constant time
+	TSet<FChaosParticlePair> ParticlePairs_Internal;
+
 	/**
 	* Called once per simulation step. Allows user to modify contacts
 	*
@@ -150,6 +192,9 @@ public:
 	UPROPERTY()
 	FName BoneName2;
 
+	// Cached when the pair is created so that removals don't need to touch possibly destroyed handles
+	FChaosParticlePair ParticlePair;
+
 	// Flip our elements to retain a default ordering in an array
 	void FlipElements()
 	{
@@ -186,6 +231,35 @@ public:
 	TArray<FCollisionIgnorePair> PairArray;
 };
 
+// A single primitive pair entry for the batched collision ignore call
+struct FCollisionIgnoreBatchEntry
+{
+	UPrimitiveComponent* Prim1;
+	FName OptionalBoneName1;
+	bool bIterateChildren1;
+	UPrimitiveComponent* Prim2;
+	FName OptionalBoneName2;
+	bool bIterateChildren2;
+
+	FCollisionIgnoreBatchEntry() :
+		Prim1(nullptr),
+		OptionalBoneName1(NAME_None),
+		bIterateChildren1(false),
+		Prim2(nullptr),
+		OptionalBoneName2(NAME_None),
+		bIterateChildren2(false)
+	{}
+
+	FCollisionIgnoreBatchEntry(bool bInIterateChildren1, bool bInIterateChildren2, UPrimitiveComponent* InPrim1, FName InOptionalBoneName1, UPrimitiveComponent* InPrim2, FName InOptionalBoneName2) :
+		Prim1(InPrim1),
+		OptionalBoneName1(InOptionalBoneName1),
+		bIterateChildren1(bInIterateChildren1),
+		Prim2(InPrim2),
+		OptionalBoneName2(InOptionalBoneName2),
+		bIterateChildren2(bInIterateChildren2)
+	{}
+};
+
 UCLASS()
 class VREXPANSIONPLUGIN_API UCollisionIgnoreSubsystem : public UWorldSubsystem
 {
@@ -202,8 +276,13 @@ public:
 
 	FCollisionIgnoreSubsystemAsyncCallback* ContactModifierCallback;
 
+	// Seeds the physics thread pair set with every tracked pair, only needed when the callback is first registered
+	// After that changes are sent as deltas through QueuePairDelta
 	void ConstructInput();
 
+	// Sends a single pair change to the contact modification callback if it is active
+	void QueuePairDelta(const FCollisionIgnorePair& IgnorePair, EChaosParticlePairDeltaType DeltaType);
+
 	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override
 	{
 		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
@@ -244,12 +323,18 @@ public:
 	void InitiateIgnore();
 
 	void SetComponentCollisionIgnoreState(bool bIterateChildren1, bool bIterateChildren2, UPrimitiveComponent* Prim1, FName OptionalBoneName1, UPrimitiveComponent* Prim2, FName OptionalBoneName2, bool bIgnoreCollision, bool bCheckFilters = false);
+
+	// Batched version of SetComponentCollisionIgnoreState, only checks filters and updates the timer once for all of the pairs
+	void SetComponentCollisionIgnoreStateBatched(const TArray<FCollisionIgnoreBatchEntry>& PrimitivePairs, bool bIgnoreCollision, bool bCheckFilters = false);
 	void RemoveComponentCollisionIgnoreState(UPrimitiveComponent* Prim1);
 	bool IsComponentIgnoringCollision(UPrimitiveComponent* Prim1);
 	bool AreComponentsIgnoringCollisions(UPrimitiveComponent* Prim1, UPrimitiveComponent* Prim2);
 	bool HasCollisionIgnorePairs();
 private:
 
+	// Returns false if the input was invalid and nothing was processed
+	bool SetComponentCollisionIgnoreState_Impl(bool bIterateChildren1, bool bIterateChildren2, UPrimitiveComponent* Prim1, FName OptionalBoneName1, UPrimitiveComponent* Prim2, FName OptionalBoneName2, bool bIgnoreCollision);
+
 	FTimerHandle UpdateHandle;
 
 };
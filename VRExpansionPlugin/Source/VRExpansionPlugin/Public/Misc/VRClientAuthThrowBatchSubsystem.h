@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Grippables/GrippablePhysicsReplication.h"
+#include "VRClientAuthThrowBatchSubsystem.generated.h"
+
+class AVRBasePlayerController;
+
+DECLARE_STATS_GROUP(TEXT("VRClientAuthThrowBatching"), STATGROUP_VRClientAuthThrowBatching, STATCAT_Advanced);
+
+/*
+* Gathers the client auth throwing movement of grippable actors when vre.BatchClientAuthThrows is on.
+* Movement polled during a frame is collected per owning player and sent after the actors have ticked as a single
+* RPC on the owning AVRBasePlayerController, the server then hands each entry to its actor.
+* Actors not owned by an AVRBasePlayerController keep sending their own RPC.
+*/
+UCLASS()
+class VREXPANSIONPLUGIN_API UVRClientAuthThrowBatchSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UVRClientAuthThrowBatchSubsystem() :
+		Super()
+	{
+	}
+
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+		// Not allowing for editor type as this is a replication subsystem
+	}
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Whether client auth throwing movement is currently batched per player
+	static bool IsBatchingClientAuthThrows();
+
+	// Returns the local AVRBasePlayerController at the top of the actors owner chain, or nullptr if it can't be batched
+	// Resolve it once when the throw starts and pass it to QueueClientAuthMovement
+	static AVRBasePlayerController* GetBatchingController(AActor* MovedActor);
+
+	// Queues the movement into this frames batch for the owning player
+	// Returns false if it couldn't be batched, the caller should send it with its own RPC then
+	static bool QueueClientAuthMovement(AVRBasePlayerController* OwningController, AActor* MovedActor, const FRepMovementVR& Movement);
+
+	// Removes the actors movement from this frames batch, returns false if it had none queued
+	// Used before ending client auth so that the last movement can be sent ahead of the end instead of after it
+	static bool TakeQueuedClientAuthMovement(AActor* MovedActor, FRepMovementVR& OutMovement);
+
+	// Hands a received batch out to the actors owned by the sending player, called on the server
+	static void ApplyClientAuthMovementBatch(AVRBasePlayerController* SendingController, const TArray<FVRClientAuthMovementBatchEntry>& MovementBatch);
+
+private:
+
+	struct FPlayerBatch
+	{
+		TWeakObjectPtr<AVRBasePlayerController> OwningController;
+		TArray<FVRClientAuthMovementBatchEntry> Entries;
+	};
+
+	void FlushBatches(UWorld* TickedWorld, ELevelTick TickType, float DeltaSeconds);
+
+	// Batches are kept around between frames to reuse their allocations, usually there is only the one local player
+	TArray<FPlayerBatch> PlayerBatches;
+	TArray<FVRClientAuthMovementBatchEntry> SendScratch;
+	bool bHasQueuedMovement = false;
+	FDelegateHandle PostActorTickHandle;
+};
@@ -5,6 +5,7 @@
 //#include "UObject/ObjectMacros.h"
 #include "Components/ActorComponent.h"
 #include "EngineDefines.h"
+#include "PhysicsInterfaceDeclaresCore.h"
 #include "VREPhysicalAnimationComponent.generated.h"
 
 struct FReferenceSkeleton;
@@ -18,11 +19,21 @@ public:
 	FName BoneName;
 	//FPhysicsShapeHandle ShapeHandle;
 
+	// Baked on setup so that the tick only needs index lookups
+	int32 BoneIndex;
+	int32 ShapeIndex;
+
+	// User data of the shape at ShapeIndex when baked, if it no longer matches then the shapes were rebuilt
+	const void* ShapeUserData;
+
 	FTransform LastLocal;
 
 	FWeldedBoneDriverData() :
 		RelativeTransform(FTransform::Identity),
-		BoneName(NAME_None)
+		BoneName(NAME_None),
+		BoneIndex(INDEX_NONE),
+		ShapeIndex(INDEX_NONE),
+		ShapeUserData(nullptr)
 	{
 	}
 
@@ -37,6 +48,25 @@ public:
 	}
 };
 
+// A base welded bone and the range of BoneDriverMap entries that drive shapes on its physics actor
+struct FWeldedBoneDriverBody
+{
+	int32 BodyIndex;
+	int32 FirstDriver;
+	int32 NumDrivers;
+
+	// The actor the shapes were baked from, welding to something else changes it
+	FPhysicsActorHandle ActorHandle;
+
+	FWeldedBoneDriverBody() :
+		BodyIndex(INDEX_NONE),
+		FirstDriver(0),
+		NumDrivers(0),
+		ActorHandle(nullptr)
+	{
+	}
+};
+
 UCLASS(meta = (BlueprintSpawnableComponent), ClassGroup = Physics)
 class VREXPANSIONPLUGIN_API UVREPhysicalAnimationComponent : public UPhysicalAnimationComponent
 {
@@ -56,6 +86,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = WeldedBoneDriver)
 		float SleepThresholdMultiplier;
 
+	/** If true then all welded bodies are updated under a single physics scene write lock instead of one lock per body */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = WeldedBoneDriver)
+		bool bBatchWeldedBoneDriverUpdates;
+
 	/** The Base bone to use as the bone driver root */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = WeldedBoneDriver)
 		TArray<FName> BaseWeldedBoneDriverNames;
@@ -63,6 +97,19 @@ public:
 	UPROPERTY()
 		TArray<FWeldedBoneDriverData> BoneDriverMap;
 
+	// Baked per body ranges of BoneDriverMap
+	TArray<FWeldedBoneDriverBody> WeldedBoneDriverBodies;
+
+	// Set when the baked table no longer matches the physics state (rewelded, shapes rebuilt, physics state recreated), the next update rebuilds it
+	bool bWeldedBoneDriverDirty;
+
+	// Mesh that we are listening to for physics state creation
+	TWeakObjectPtr<USkeletalMeshComponent> PhysicsCreatedMesh;
+	FDelegateHandle PhysicsCreatedHandle;
+
+	void OnWeldedBoneDriverPhysicsCreated();
+	void BindWeldedBoneDriverPhysicsCreated(USkeletalMeshComponent* SkeleMesh);
+
 	// Call to setup the welded body driver, initializes all mappings and caches shape contexts
 	// Requires that SetSkeletalMesh be called first
 	UFUNCTION(BlueprintCallable, Category = PhysicalAnimation)
@@ -84,11 +131,19 @@ public:
 	//void OnWeldedMassUpdated(FBodyInstance* BodyInstance);
 	void UpdateWeldedBoneDriver(float DeltaTime);
 
-	FTransform GetWorldSpaceRefBoneTransform(FReferenceSkeleton& RefSkel, int32 BoneIndex, int32 ParentBoneIndex);
+	// Returns the resolved physics actor of a baked body if it still matches the table
+	FPhysicsActorHandle* GetWeldedBoneDriverActor(USkeletalMeshComponent* SkeleMesh, const FWeldedBoneDriverBody& DriverBody);
+
+	// Returns true if every base body that exists currently has a valid physics actor to bake from, names without a body are skipped like in setup
+	bool CanRebakeWeldedBoneDriver(USkeletalMeshComponent* SkeleMesh) const;
+	void UpdateWeldedBoneDriverBody(USkeletalMeshComponent* SkeleMesh, const FWeldedBoneDriverBody& DriverBody, FPhysicsActorHandle& Actor);
+
+	FTransform GetWorldSpaceRefBoneTransform(const FReferenceSkeleton& RefSkel, int32 BoneIndex, int32 ParentBoneIndex);
 	FTransform GetRefPoseBoneRelativeTransform(USkeletalMeshComponent* SkeleMesh, FName BoneName, FName ParentBoneName);
 
 	//FCalculateCustomPhysics OnCalculateCustomPhysics;
 	//void CustomPhysics(float DeltaTime, FBodyInstance* BodyInstance);
 
+	virtual void OnRegister() override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 };
@@ -1,7 +1,10 @@
 #pragma once
 #include "TimerManager.h"
+#include "Tasks/Task.h"
 #include "VRRenderTargetManager.generated.h"
 
+DECLARE_STATS_GROUP(TEXT("VRRenderTargetManager"), STATGROUP_VRRenderTargetManager, STATCAT_Advanced);
+
 class UVRRenderTargetManager;
 class UCanvasRenderTarget2D;
 class UCanvas;
@@ -10,9 +13,6 @@ class UMaterial;
 class APlayerController;
 
 
-// #TODO: Dirty rects so don't have to send entire texture?
-
-
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
 struct VREXPANSIONPLUGIN_API FBPVRReplicatedTextureStore
 {
@@ -38,6 +38,10 @@ public:
 	UPROPERTY(Transient)
 		bool bIsZipped;
 
+	// If non zero then this store only contains the listed tiles of this size (see SetFromTiles) instead of the full texture
+	UPROPERTY(Transient)
+		uint32 DeltaTileSize;
+
 	//UPROPERTY()
 	//	bool bJPG;
 	//UPROPERTY(Transient)
@@ -48,6 +52,7 @@ public:
 		Width = 0;
 		Height = 0;
 		bIsZipped = false;
+		DeltaTileSize = 0;
 	}
 
 	void Reset()
@@ -58,12 +63,17 @@ public:
 		Height = 0;
 		PixelFormat = (EPixelFormat)0;
 		bIsZipped = false;
+		DeltaTileSize = 0;
 		//bJPG = false;
 	}
 
 	void PackData();
 	void UnPackData();
 
+	// Fills the unpacked data with a tile header followed by the pixels of each listed tile, clipped to the texture bounds
+	// Header is the tile count and then each tile index, all written as pairs of uint16 so it goes through the same RLE path
+	void SetFromTiles(const TArray<uint16>& FullPixels, int32 InWidth, int32 InHeight, int32 TileSize, const TArray<int32>& TileIndices);
+
 
 	/** Network serialization */
 	// Doing a custom NetSerialize here because this is sent via RPCs and should change on every update
@@ -81,6 +91,9 @@ struct TStructOpsTypeTraits< FBPVRReplicatedTextureStore > : public TStructOpsTy
 	};
 };
 
+// Packed texture store that is shared between every proxy sending it, never modified once it is handed out
+typedef TSharedPtr<const FBPVRReplicatedTextureStore, ESPMode::ThreadSafe> FBPVRSharedTextureStore;
+
 
 USTRUCT()
 struct FRenderDataStore {
@@ -91,10 +104,55 @@ struct FRenderDataStore {
 	FIntPoint Size2D;
 	EPixelFormat PixelFormat;
 
+	// Texture version of the render target when the read back was queued
+	uint32 TextureVersion;
+
 	FRenderDataStore() {
+		TextureVersion = 0;
 	}
 };
 
+// A delta store for clients synced to BaseVersion
+struct FRenderTargetEncodeRequest
+{
+	uint32 BaseVersion;
+	TArray<int32> Tiles;
+	FBPVRSharedTextureStore Store;
+};
+
+// Read back texture data that is converted and encoded off of the game thread
+// Everything is filled in on the game thread before launching, the task only touches the job itself
+// and the game thread doesn't read the stores until the task has completed
+struct FRenderTargetEncodeJob
+{
+	TArray<FColor> ColorData;
+	FIntPoint Size2D;
+	EPixelFormat PixelFormat;
+	uint32 TextureVersion;
+	int32 TileSize;
+
+	bool bNeedsFullStore;
+	FBPVRSharedTextureStore FullStore;
+	TArray<FRenderTargetEncodeRequest> DeltaRequests;
+
+	FRenderTargetEncodeJob()
+	{
+		Size2D = FIntPoint::ZeroValue;
+		PixelFormat = (EPixelFormat)0;
+		TextureVersion = 0;
+		TileSize = 0;
+		bNeedsFullStore = false;
+	}
+
+	const FRenderTargetEncodeRequest* FindDeltaRequest(uint32 BaseVersion) const
+	{
+		return DeltaRequests.FindByPredicate([BaseVersion](const FRenderTargetEncodeRequest& Request) { return Request.BaseVersion == BaseVersion; });
+	}
+
+	// Converts to 16bit color and packs every requested store, runs on a worker thread
+	void Encode();
+};
+
 UENUM(BlueprintType)
 enum class ERenderManagerOperationType : uint8
 {
@@ -187,14 +245,52 @@ public:
 	UFUNCTION()
 		void OnRep_Manager();
 
+	// Client side buffer that the blobs are received into
 	UPROPERTY(Transient)
 	FBPVRReplicatedTextureStore TextureStore;
+
+	// Server side store that we are sending, shared with the other proxies so we only keep our own cursor (BlobNum) into it
+	FBPVRSharedTextureStore SendStore;
 	
 	UPROPERTY(Transient)
 		int32 BlobNum;
 
 	bool bWaitingForManager;
 
+	// Client side, if we have been linked to a manager before, a new one means that it was re-created and lost its texture
+	bool bHadManager;
+
+	// Server side, texture version of the store we are currently sending and its blob count for the final ack
+	uint32 PendingTextureVersion;
+	int32 PendingBlobCount;
+
+	// Server side state for the managers send scheduler
+	// Blobs up to LastAckedBlob have been acked, blobs between it and BlobNum are in flight
+	bool bStreamingBlobs;
+	int32 LastAckedBlob;
+	float SendCredit;
+	float SmoothedRTT;
+	TArray<double> BlobSendTimes;
+
+	int32 GetTotalBlobs() const
+	{
+		return SendStore.IsValid() ? FMath::DivideAndRoundUp(SendStore->PackedData.Num(), TextureBlobSize) : 0;
+	}
+
+	int32 GetBlobsInFlight() const
+	{
+		return BlobNum - LastAckedBlob;
+	}
+
+	// Sends the next blob of the send store, returns the number of bytes sent
+	int32 SendBlob();
+
+	// Drops the send store and stops sending
+	void FinishTextureSend();
+
+	// Starts sending the given store to our client
+	void BeginTextureSend(const FBPVRSharedTextureStore& Store, uint32 TextureVersion);
+
 	void SendInitMessage();
 
 	UFUNCTION()
@@ -219,6 +315,8 @@ public:
 		if(SendTimer_Handle.IsValid())
 			GetWorld()->GetTimerManager().ClearTimer(SendTimer_Handle);
 
+		SendStore.Reset();
+
 		Super::EndPlay(EndPlayReason);
 	}
 
@@ -227,7 +325,7 @@ public:
 		void SendLocalDrawOperations(const TArray<FRenderManagerOperation>& LocalRenderOperationStoreList);
 
 	UFUNCTION(Reliable, Client)
-		void InitTextureSend(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped/*, bool bIsJPG*/);
+		void InitTextureSend(int32 Width, int32 Height, int32 TotalDataCount, int32 BlobCount, EPixelFormat PixelFormat, bool bIsZipped, int32 DeltaTileSize/*, bool bIsJPG*/);
 
 	UFUNCTION(Reliable, Server, WithValidation)
 		void Ack_InitTextureSend(int32 TotalDataCount);
@@ -241,6 +339,10 @@ public:
 	UFUNCTION(Reliable, Client)
 		void ReceiveTexture(const FBPVRReplicatedTextureStore&TextureData);
 
+	// Tells the server that our manager was re-created and that it needs to send us everything again
+	UFUNCTION(Reliable, Server, WithValidation)
+		void NotifyManagerReset();
+
 };
 
 
@@ -261,12 +363,21 @@ struct FClientRepData {
 	UPROPERTY()
 		bool bIsDirty;
 
+	// Texture version that this client is known to have, delta sends only contain tiles changed after it
+	UPROPERTY()
+		uint32 AckedTextureVersion;
+
+	UPROPERTY()
+		bool bAwaitingTextureAck;
+
 	FClientRepData() 
 	{
 		PC = nullptr;
 		ReplicationProxy = nullptr;
 		bIsRelevant = false;
 		bIsDirty = false;
+		AckedTextureVersion = 0;
+		bAwaitingTextureAck = false;
 	}
 };
 
@@ -326,6 +437,41 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager")
 		bool bInitiallyReplicateTexture;
 
+	// If true then clients are only sent the tiles that changed since the last version they have, instead of the full texture
+	// If you draw to the RenderTarget directly instead of through the draw operations then call MarkRenderTargetRegionDirty
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager")
+		bool bUseDeltaTextureReplication;
+
+	// Size in pixels of the tiles that changes are tracked and sent in, set before BeginPlay
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager", meta = (ClampMin = "16", ClampMax = "512", UIMin = "16", UIMax = "512"))
+		int32 DeltaTileSize;
+
+	// Incremented every time that something is drawn to the render target
+	uint32 TextureVersion;
+
+	// Texture version that each tile was last drawn to at, 0 means that it is still the clear color
+	TArray<uint32> TileVersions;
+	FIntPoint TileCount;
+
+	// Marks the tiles touched by this region (in render target pixels) as changed
+	void MarkDirtyRegion(const FBox2D& Region);
+
+	// Returns the bounds that an operation can draw to in render target pixels, returns false if it can't be known
+	bool GetOperationBounds(const FRenderManagerOperation& Operation, FBox2D& OutBounds) const;
+
+	// Gathers the tiles that changed after BaseVersion, returns false if a full send would be cheaper
+	bool GatherDirtyTiles(uint32 BaseVersion, const FIntPoint& TextureSize, TArray<int32>& OutTiles) const;
+
+	// Call this if you drew to the render target outside of the managers draw operations so that the region is re-sent to clients
+	UFUNCTION(BlueprintCallable, Category = "VRRenderTargetManager|DrawingFunctions")
+		void MarkRenderTargetRegionDirty(FVector2D RegionMin, FVector2D RegionMax);
+
+	// Called by the proxy when its client acked the full texture send
+	void OnClientTextureAcked(ARenderTargetReplicationProxy* Proxy, uint32 AckedVersion);
+
+	// Called by the proxy when its clients copy of the manager was re-created
+	void OnClientManagerReset(ARenderTargetReplicationProxy* Proxy);
+
 	UPROPERTY(Transient)
 		bool bIsLoadingTextureBuffer;
 
@@ -337,9 +483,43 @@ public:
 	// MaxClientRate settings in config in order to balance the bandwidth and avoid saturation
 	// If you raise this above the max replication size of a 65k byte size then you will need
 	// To adjust the max size in engine network settings.
+	// This is per client, it is only used if bUseGlobalSendScheduler is false
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager")
 		int32 MaxBytesPerSecondRate;
 
+	// If true then texture blobs for every client are sent by a single scheduler that splits MaxTotalBytesPerSecondRate
+	// between them, instead of each client sending at MaxBytesPerSecondRate on its own
+	// Opt in, when enabling it set MaxTotalBytesPerSecondRate to suit the expected client count
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager|Scheduler")
+		bool bUseGlobalSendScheduler;
+
+	// Total bytes per second to send across all clients when using the global send scheduler
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager|Scheduler", meta = (EditCondition = "bUseGlobalSendScheduler"))
+		int32 MaxTotalBytesPerSecondRate;
+
+	// Maximum number of un-acked blobs that a client can have in flight, the actual window is sized from the
+	// clients share of the budget and its round trip time
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager|Scheduler", meta = (EditCondition = "bUseGlobalSendScheduler", ClampMin = "1", UIMin = "1"))
+		int32 MaxUnackedBlobs;
+
+	// Rate that the send scheduler runs at
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "RenderTargetManager|Scheduler", meta = (EditCondition = "bUseGlobalSendScheduler"))
+		float SendSchedulerRate;
+
+	// Returns the share of the send budget that this client should get relative to the others, default is 1.0 for everyone
+	UFUNCTION(BlueprintNativeEvent, Category = "RenderTargetManager|Scheduler")
+		float GetClientSendPriority(APlayerController* PC, int32 RemainingBytes);
+
+	FTimerHandle SendScheduler_Handle;
+	double LastSendScheduleTime;
+	float SendBudgetCarry;
+
+	// Starts the send scheduler if it isn't already running
+	void StartSendScheduler();
+
+	// Hands out this steps budget to the clients that are streaming blobs
+	void RunSendScheduler();
+
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "RenderTargetManager")
 		TObjectPtr<UCanvasRenderTarget2D> RenderTarget;
 
@@ -376,9 +556,21 @@ public:
 	// Decompress the render target data to a texture and copy it to our managed render target
 	bool DeCompressRenderTarget2D();
 
+	// Copies the tiles of a delta store into our managed render target
+	bool DeCompressRenderTargetTiles();
+
 	// Queues storing the render target image to our buffer
 	void QueueImageStore();
 
+	// Launches the encode task for a completed read back
+	void StartEncodeJob(FRenderDataStore* RenderData);
+
+	// Hands the finished stores out to the clients that are waiting on them
+	void FinishEncodeJob();
+
+	TSharedPtr<FRenderTargetEncodeJob, ESPMode::ThreadSafe> PendingEncodeJob;
+	UE::Tasks::FTask PendingEncodeTask;
+
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
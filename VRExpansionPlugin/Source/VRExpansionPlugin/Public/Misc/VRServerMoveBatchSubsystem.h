@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VRServerMoveBatchSubsystem.generated.h"
+
+class UVRCharacterMovementComponent;
+
+DECLARE_STATS_GROUP(TEXT("VRServerMoveBatching"), STATGROUP_VRServerMoveBatching, STATCAT_Advanced);
+
+/*
+* Handles the server moves of every VR character in one batch per frame when vre.BatchServerMoves is on.
+* Moves are gathered as they are received and handled right after the net driver finishes dispatching,
+* this means that they run after every other RPC received that frame rather than in the order they arrived.
+* With vre.BatchServerMoves.ParallelChecks on the timestamp pre-validation and client error checks run on worker threads,
+* otherwise every step runs on the game thread.
+*/
+UCLASS()
+class VREXPANSIONPLUGIN_API UVRServerMoveBatchSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UVRServerMoveBatchSubsystem() :
+		Super()
+	{
+	}
+
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+		// Not allowing for editor type as this is a replication subsystem
+	}
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Whether moves should currently be batched instead of being handled as they are received
+	static bool IsBatchingServerMoves();
+
+	// Adds a component with newly queued moves to this frames batch
+	void QueueComponent(UVRCharacterMovementComponent* MovementComponent);
+
+private:
+
+	void ProcessBatchedMoves();
+
+	TArray<TWeakObjectPtr<UVRCharacterMovementComponent>> QueuedComponents;
+	TArray<UVRCharacterMovementComponent*> BatchScratch;
+	FDelegateHandle PostTickDispatchHandle;
+};
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "VRBPDatatypes.h"
+#include "VRTrackingSmoothingSubsystem.generated.h"
+
+class UGripMotionControllerComponent;
+class UVRTrackingSmoothingSubsystem;
+
+DECLARE_STATS_GROUP(TEXT("VRTrackingSmoothing"), STATGROUP_VRTrackingSmoothing, STATCAT_Advanced);
+
+USTRUCT()
+struct FVRTrackingSmoothingTickFunction : public FTickFunction
+{
+	GENERATED_USTRUCT_BODY()
+
+		UVRTrackingSmoothingSubsystem* Target;
+
+	virtual void ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FVRTrackingSmoothingTickFunction> : public TStructOpsTypeTraitsBase2<FVRTrackingSmoothingTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/*
+* Owns the 1 Euro filter bank that the locally tracked motion controllers smooth through when vr.BankedTrackingSmoothing is on.
+* Ticks ahead of the controllers, polls every registered controller and filters all of their lanes in a single pass,
+* UpdateTracking then applies the already filtered pose instead of running its own filter.
+*/
+UCLASS()
+class VREXPANSIONPLUGIN_API UVRTrackingSmoothingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UVRTrackingSmoothingSubsystem() :
+		Super()
+	{
+	}
+
+	virtual bool DoesSupportWorldType(EWorldType::Type WorldType) const override
+	{
+		return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+		// Not allowing for editor type as there is no tracking there
+	}
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Whether controllers should currently smooth through the shared bank
+	static bool IsBankingTrackingSmoothing();
+
+	// Binds the controllers smoothing filter to the bank and orders its tick after the smoothing pass
+	void RegisterController(UGripMotionControllerComponent* Controller);
+
+	// Takes the controllers smoothing filter back out of the bank
+	void UnregisterController(UGripMotionControllerComponent* Controller);
+
+private:
+
+	friend struct FVRTrackingSmoothingTickFunction;
+
+	// Polls every registered controller and filters them all at once
+	void TickSmoothing(float DeltaTime);
+
+	FVREuroLowPassFilterBank FilterBank;
+	TArray<TWeakObjectPtr<UGripMotionControllerComponent>> Controllers;
+	FVRTrackingSmoothingTickFunction SmoothingTickFunction;
+};
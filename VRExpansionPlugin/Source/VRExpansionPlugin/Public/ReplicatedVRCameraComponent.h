@@ -134,6 +134,13 @@ public:
 	// Max distance to allow smoothing before snapping entirely to the new position
 	UPROPERTY(EditAnywhere, Category = "ReplicatedCamera|Networking|Smoothing", meta = (editcondition = "bUseExponentialSmoothing"))
 		float NetworkNoSmoothUpdateDistance = 100.f;
+
+	// Buffered snapshot interpolation, overrides the lerp and exponential smoothing when enabled
+	// NetworkNoSmoothUpdateDistance still applies and snaps on large jumps
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ReplicatedCamera|Networking|Smoothing", meta = (editcondition = "bSmoothReplicatedMotion"))
+		FBPVRSnapshotInterpolationSettings SnapshotInterpolation;
+
+	FVRSnapshotBuffer SnapshotBuffer;
 	
 	UFUNCTION()
     virtual void OnRep_ReplicatedCameraTransform();
@@ -164,6 +164,8 @@ enum class EVRLerpInterpolationMode : uint8
 	DualQuatInterp
 };
 
+// Deprecated, the 1 Euro filter structs no longer use this and run on the VREuroFilter lanes instead.
+// Kept so that project code using it directly keeps compiling, it will be removed in a later version.
 template<class filterType>
 class FBasicLowPassFilter
 {
@@ -241,6 +243,189 @@ public:
 };
 
 
+namespace VREuroFilter
+{
+	// Filters NumLanes independent lanes of 1 Euro filter state, four lanes per SIMD pass, with the settings and first time state shared by all of the lanes.
+	// All arrays are NumLanes long and NumLanes must be a multiple of 4, Out can be the same array as Raw.
+	VREXPANSIONPLUGIN_API void FilterLanesUniform(const double* Raw, double* Out, double* PreviousRaw, double* PreviousDelta, double* Previous, bool bFirstTime,
+		float MinCutoff, float CutoffSlope, float DeltaCutoff, int32 NumLanes, float DeltaTime);
+
+	// Filters the lanes with per lane settings, only the blocks of 4 lanes flagged in Pending are filtered and their flag is cleared.
+	// FirstTime is non zero for lanes without history and is cleared by the filter, arrays are NumLanes long and NumLanes must be a multiple of 4.
+	VREXPANSIONPLUGIN_API void FilterLanes(const double* Raw, double* Out, double* PreviousRaw, double* PreviousDelta, double* Previous, double* FirstTime, double* Pending,
+		const double* MinCutoff, const double* CutoffSlope, const double* DeltaCutoff, int32 NumLanes, float DeltaTime);
+}
+
+// Structure of arrays 1 Euro filter state for many values, every value that was given a new raw value is filtered in a single pass.
+// Used for filtering all of the tracked devices (or hand joints) at once, the filter structs bind to a value in a bank and act as a handle to it.
+// Every value starts on a 4 lane boundary so a SIMD block never spans two values.
+class VREXPANSIONPLUGIN_API FVREuroLowPassFilterBank
+{
+public:
+
+	// Adds a value to the bank, returns the handle to set and get it with
+	int32 AddVector(float MinCutoff, float CutoffSlope, float DeltaCutoff);
+	int32 AddQuat(float MinCutoff, float CutoffSlope, float DeltaCutoff);
+	int32 AddTransform(float MinCutoff, float CutoffSlope, float DeltaCutoff);
+
+	// Frees a value, its lanes are re-used by the next value of the same type
+	void RemoveValue(int32 Handle);
+
+	bool IsValidHandle(int32 Handle) const
+	{
+		return Values.IsValidIndex(Handle) && Values[Handle].bInUse;
+	}
+
+	void SetSettings(int32 Handle, float MinCutoff, float CutoffSlope, float DeltaCutoff);
+
+	// Sets the raw value for the next Filter call, values that aren't set keep their history and last filtered value
+	void SetVector(int32 Handle, const FVector& InRawValue);
+	void SetQuat(int32 Handle, const FQuat& InRawValue);
+	void SetTransform(int32 Handle, const FTransform& InRawValue);
+
+	// Filtered values of the last filter pass that included the value
+	FVector GetVector(int32 Handle) const;
+	FQuat GetQuat(int32 Handle) const;
+	FTransform GetTransform(int32 Handle) const;
+
+	// Clears the history of a single value so that it starts fresh
+	void ResetValue(int32 Handle);
+
+	// Copies the history of a value in or out of the bank, the arrays are the values padded lane count long
+	void ReadState(int32 Handle, double* OutPreviousRaw, double* OutPreviousDelta, double* OutPrevious, bool& bOutFirstTime) const;
+	void WriteState(int32 Handle, const double* InPreviousRaw, const double* InPreviousDelta, const double* InPrevious, bool bInFirstTime);
+
+	// Removes all values, handles are invalid after this
+	void Empty();
+
+	// Filters every value that was set since the last pass
+	void Filter(float DeltaTime);
+
+	// Filters a single value right away if it was set
+	void FilterValue(int32 Handle, float DeltaTime);
+
+	int32 NumValues() const
+	{
+		return Values.Num() - FreeValues.Num();
+	}
+
+private:
+
+	enum class EValueType : uint8
+	{
+		Vector,
+		Quat,
+		Transform
+	};
+
+	struct FValueInfo
+	{
+		int32 FirstLane;
+		int32 NumLanes;
+		EValueType ValueType;
+		bool bInUse;
+	};
+
+	int32 AddValue(EValueType ValueType, int32 NumValueLanes, float MinCutoff, float CutoffSlope, float DeltaCutoff);
+
+	// Flags the lanes of a value for the next filter pass
+	void MarkPending(const FValueInfo& Info);
+
+	TArray<FValueInfo> Values;
+	TArray<int32> FreeValues;
+
+	// Per lane state
+	TArray<double> Raw;
+	TArray<double> Out;
+	TArray<double> PreviousRaw;
+	TArray<double> PreviousDelta;
+	TArray<double> Previous;
+	TArray<double> FirstTime;
+	TArray<double> Pending;
+	TArray<double> MinCutoffs;
+	TArray<double> CutoffSlopes;
+	TArray<double> DeltaCutoffs;
+	int32 NumUsedLanes = 0;
+};
+
+// Filter history for a single value of NumValueLanes doubles, padded to the SIMD width.
+// Kept inline so that the filter structs stay cheap to copy to the render thread, when bound to a bank the history lives in the bank instead.
+// Copies are never bound, copying a bound value takes a snapshot of its history out of the bank so that the copy (the render thread one for instance) carries on from it.
+template<int32 NumValueLanes>
+struct TVREuroFilterLanes
+{
+	static constexpr int32 NumLanes = (NumValueLanes + 3) & ~3;
+
+	double PreviousRaw[NumLanes];
+	double PreviousDelta[NumLanes];
+	double Previous[NumLanes];
+	bool bFirstTime;
+
+	// Bank that holds the history instead when bound
+	FVREuroLowPassFilterBank* Bank;
+	int32 BankHandle;
+
+	TVREuroFilterLanes() :
+		bFirstTime(true),
+		Bank(nullptr),
+		BankHandle(INDEX_NONE)
+	{
+		FMemory::Memzero(PreviousRaw);
+		FMemory::Memzero(PreviousDelta);
+		FMemory::Memzero(Previous);
+	}
+
+	TVREuroFilterLanes(const TVREuroFilterLanes& Other) :
+		Bank(nullptr),
+		BankHandle(INDEX_NONE)
+	{
+		Other.CopyStateTo(PreviousRaw, PreviousDelta, Previous, bFirstTime);
+	}
+
+	// Keeps the binding of this one, the incoming history is written into the bank when bound
+	TVREuroFilterLanes& operator=(const TVREuroFilterLanes& Other)
+	{
+		if (this != &Other)
+		{
+			Other.CopyStateTo(PreviousRaw, PreviousDelta, Previous, bFirstTime);
+
+			if (IsBound())
+			{
+				Bank->WriteState(BankHandle, PreviousRaw, PreviousDelta, Previous, bFirstTime);
+			}
+		}
+
+		return *this;
+	}
+
+	bool IsBound() const
+	{
+		return Bank != nullptr;
+	}
+
+	void CopyStateTo(double* OutPreviousRaw, double* OutPreviousDelta, double* OutPrevious, bool& bOutFirstTime) const
+	{
+		if (IsBound())
+		{
+			Bank->ReadState(BankHandle, OutPreviousRaw, OutPreviousDelta, OutPrevious, bOutFirstTime);
+		}
+		else
+		{
+			FMemory::Memcpy(OutPreviousRaw, PreviousRaw, sizeof(PreviousRaw));
+			FMemory::Memcpy(OutPreviousDelta, PreviousDelta, sizeof(PreviousDelta));
+			FMemory::Memcpy(OutPrevious, Previous, sizeof(Previous));
+			bOutFirstTime = bFirstTime;
+		}
+	}
+
+	// InOutValue must be NumLanes long, only used when not bound
+	void Filter(double* InOutValue, float MinCutoff, float CutoffSlope, float DeltaCutoff, float DeltaTime)
+	{
+		VREuroFilter::FilterLanesUniform(InOutValue, InOutValue, PreviousRaw, PreviousDelta, Previous, bFirstTime, MinCutoff, CutoffSlope, DeltaCutoff, NumLanes, DeltaTime);
+		bFirstTime = false;
+	}
+};
+
 /************************************************************************/
 /* 1 Euro filter smoothing algorithm									*/
 /* http://cristal.univ-lille.fr/~casiez/1euro/							*/
@@ -256,17 +441,13 @@ public:
 	FBPEuroLowPassFilter() :
 		MinCutoff(0.9f),
 		DeltaCutoff(1.0f),
-		CutoffSlope(0.007f),
-		RawFilter(FVector::ZeroVector),
-		DeltaFilter(FVector::ZeroVector)
+		CutoffSlope(0.007f)
 	{}
 
 	FBPEuroLowPassFilter(const float InMinCutoff, const float InCutoffSlope, const float InDeltaCutoff) :
 		MinCutoff(InMinCutoff),
 		DeltaCutoff(InDeltaCutoff),
-		CutoffSlope(InCutoffSlope),
-		RawFilter(FVector::ZeroVector),
-		DeltaFilter(FVector::ZeroVector)
+		CutoffSlope(InCutoffSlope)
 	{}
 
 	// The smaller the value the less jitter and the more lag with micro movements
@@ -287,10 +468,27 @@ public:
 	/** Smooth vector */
 	FVector RunFilterSmoothing(const FVector &InRawValue, const float &InDeltaTime);
 
+	// Binds this filter to a value in the bank, its history moves into the bank and it acts as a handle to that value from then on
+	void BindToBank(FVREuroLowPassFilterBank* InBank);
+
+	// Takes the history back out of the bank and frees the value
+	void UnbindFromBank();
+
+	bool IsBoundToBank() const
+	{
+		return Lanes.IsBound();
+	}
+
+	// Sets the raw value for the next filter pass of the bound bank
+	void SetBankInput(const FVector& InRawValue);
+
+	// Filtered value from the last pass of the bound bank
+	FVector GetBankOutput() const;
+
 private:
 
-	FBasicLowPassFilter<FVector> RawFilter;
-	FBasicLowPassFilter<FVector> DeltaFilter;
+	// Filter history for the X, Y, Z
+	TVREuroFilterLanes<3> Lanes;
 
 };
 
@@ -310,17 +508,13 @@ public:
 	FBPEuroLowPassFilterQuat() :
 		MinCutoff(0.9f),
 		DeltaCutoff(1.0f),
-		CutoffSlope(0.007f),
-		RawFilter(FQuat::Identity),
-		DeltaFilter(FQuat::Identity)
+		CutoffSlope(0.007f)
 	{}
 
 	FBPEuroLowPassFilterQuat(const float InMinCutoff, const float InCutoffSlope, const float InDeltaCutoff) :
 		MinCutoff(InMinCutoff),
 		DeltaCutoff(InDeltaCutoff),
-		CutoffSlope(InCutoffSlope),
-		RawFilter(FQuat::Identity),
-		DeltaFilter(FQuat::Identity)
+		CutoffSlope(InCutoffSlope)
 	{}
 
 	// The smaller the value the less jitter and the more lag with micro movements
@@ -340,10 +534,27 @@ public:
 	/** Smooth vector */
 	FQuat RunFilterSmoothing(const FQuat& InRawValue, const float& InDeltaTime);
 
+	// Binds this filter to a value in the bank, its history moves into the bank and it acts as a handle to that value from then on
+	void BindToBank(FVREuroLowPassFilterBank* InBank);
+
+	// Takes the history back out of the bank and frees the value
+	void UnbindFromBank();
+
+	bool IsBoundToBank() const
+	{
+		return Lanes.IsBound();
+	}
+
+	// Sets the raw value for the next filter pass of the bound bank
+	void SetBankInput(const FQuat& InRawValue);
+
+	// Filtered value from the last pass of the bound bank
+	FQuat GetBankOutput() const;
+
 private:
 
-	FBasicLowPassFilter<FQuat> RawFilter;
-	FBasicLowPassFilter<FQuat> DeltaFilter;
+	// Filter history for the X, Y, Z, W
+	TVREuroFilterLanes<4> Lanes;
 
 };
 
@@ -363,17 +574,13 @@ public:
 	FBPEuroLowPassFilterTrans() :
 		MinCutoff(0.1f),
 		DeltaCutoff(10.0f),
-		CutoffSlope(10.0f),
-		RawFilter(FTransform::Identity),
-		DeltaFilter(FTransform::Identity)
+		CutoffSlope(10.0f)
 	{}
 
 	FBPEuroLowPassFilterTrans(const float InMinCutoff, const float InCutoffSlope, const float InDeltaCutoff) :
 		MinCutoff(InMinCutoff),
 		DeltaCutoff(InDeltaCutoff),
-		CutoffSlope(InCutoffSlope),
-		RawFilter(FTransform::Identity),
-		DeltaFilter(FTransform::Identity)
+		CutoffSlope(InCutoffSlope)
 	{}
 
 	// The smaller the value the less jitter and the more lag with micro movements
@@ -393,10 +600,27 @@ public:
 	/** Smooth vector */
 	FTransform RunFilterSmoothing(const FTransform& InRawValue, const float& InDeltaTime);
 
+	// Binds this filter to a value in the bank, its history moves into the bank and it acts as a handle to that value from then on
+	void BindToBank(FVREuroLowPassFilterBank* InBank);
+
+	// Takes the history back out of the bank and frees the value
+	void UnbindFromBank();
+
+	bool IsBoundToBank() const
+	{
+		return Lanes.IsBound();
+	}
+
+	// Sets the raw value for the next filter pass of the bound bank
+	void SetBankInput(const FTransform& InRawValue);
+
+	// Filtered value from the last pass of the bound bank
+	FTransform GetBankOutput() const;
+
 private:
 
-	FBasicLowPassFilter<FTransform> RawFilter;
-	FBasicLowPassFilter<FTransform> DeltaFilter;
+	// Filter history for the location, rotation and scale
+	TVREuroFilterLanes<10> Lanes;
 
 };
 
@@ -795,13 +1019,20 @@ public:
 	// Doing a custom NetSerialize here because this is sent via RPCs and should change on every update
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 	{
-		bOutSuccess = true;
-
 		// Defines the level of Quantization
 		//uint8 Flags = (uint8)QuantizationLevel;
 		Ar.SerializeBits(&QuantizationLevel, 1); // Only two values 0:1
 		Ar.SerializeBits(&RotationQuantizationLevel, 1); // Only two values 0:1
 
+		bOutSuccess = SerializeTransform(Ar);
+		return bOutSuccess;
+	}
+
+	// Serializes the position and rotation with the current quantization levels, which the caller has to have already synced
+	bool SerializeTransform(FArchive& Ar)
+	{
+		bool bOutSuccess = true;
+
 		// No longer using their built in rotation rep, as controllers will rarely if ever be at 0 rot on an axis and 
 		// so the 1 bit overhead per axis is just that, overhead
 		//Rotation.SerializeCompressedShort(Ar);
@@ -899,6 +1130,169 @@ struct TStructOpsTypeTraits< FBPVRComponentPosRep > : public TStructOpsTypeTrait
 	};
 };
 
+// Settings for buffered snapshot interpolation of replicated tracked components
+USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
+struct VREXPANSIONPLUGIN_API FBPVRSnapshotInterpolationSettings
+{
+	GENERATED_BODY()
+public:
+
+	// If true then replicated updates are buffered and played back with a small delay instead of chasing the newest update
+	// Late or lost updates are covered by extrapolation, allowing lower net update rates without hitching
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SnapshotInterpolation")
+		bool bUseSnapshotInterpolation;
+
+	// Lowest playback delay in seconds
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SnapshotInterpolation", meta = (editcondition = "bUseSnapshotInterpolation", ClampMin = "0.0", UIMin = "0.0"))
+		float MinDelay;
+
+	// Highest playback delay in seconds
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SnapshotInterpolation", meta = (editcondition = "bUseSnapshotInterpolation", ClampMin = "0.0", UIMin = "0.0"))
+		float MaxDelay;
+
+	// Standard deviations of arrival jitter to add on top of the average update interval for the delay
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SnapshotInterpolation", meta = (editcondition = "bUseSnapshotInterpolation", ClampMin = "0.0", UIMin = "0.0"))
+		float JitterDeviations;
+
+	// Longest time in seconds to extrapolate past the newest update before holding in place
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SnapshotInterpolation", meta = (editcondition = "bUseSnapshotInterpolation", ClampMin = "0.0", UIMin = "0.0"))
+		float MaxExtrapolationTime;
+
+	FBPVRSnapshotInterpolationSettings() :
+		bUseSnapshotInterpolation(false),
+		MinDelay(0.02f),
+		MaxDelay(0.25f),
+		JitterDeviations(2.0f),
+		MaxExtrapolationTime(0.1f)
+	{
+	}
+};
+
+// Jitter buffer of replicated relative transforms, stamped on arrival
+struct VREXPANSIONPLUGIN_API FVRSnapshotBuffer
+{
+	struct FSnapshot
+	{
+		double Time;
+		FVector Position;
+		FQuat Rotation;
+	};
+
+	TArray<FSnapshot, TInlineAllocator<8>> Snapshots;
+	double LastArrivalTime;
+	float MeanInterval;
+	float IntervalVariance;
+	float CurrentDelay;
+
+	FVRSnapshotBuffer()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		Snapshots.Reset();
+		LastArrivalTime = -1.0;
+		MeanInterval = 0.0f;
+		IntervalVariance = 0.0f;
+		CurrentDelay = 0.0f;
+	}
+
+	// ExpectedInterval is the senders update interval, used to seed the statistics and space out bunched arrivals
+	void AddSnapshot(const FVector& Position, const FRotator& Rotation, double ArrivalTime, float ExpectedInterval, const FBPVRSnapshotInterpolationSettings& Settings);
+
+	// Returns false if there is nothing to sample yet
+	bool Sample(double CurrentTime, const FBPVRSnapshotInterpolationSettings& Settings, FVector& OutPosition, FRotator& OutRotation) const;
+};
+
+UENUM()
+enum class EVRPosePacketDevice : uint8
+{
+	Camera = 0,
+	LeftController = 1,
+	RightController = 2,
+	DeviceCount = 3 UMETA(Hidden)
+};
+
+// Camera and controller transforms sampled on the same update and sent in a single RPC
+// Only the devices that changed are written, each with its own quantization levels
+USTRUCT()
+struct VREXPANSIONPLUGIN_API FVRPosePacket
+{
+	GENERATED_USTRUCT_BODY()
+public:
+
+	// Increases with every packet the client sends, the server drops packets older than the last one it applied
+	UPROPERTY(Transient)
+		uint16 Sequence;
+
+	// Bit per EVRPosePacketDevice that is present in this packet
+	UPROPERTY(Transient)
+		uint8 DeviceFlags;
+
+	UPROPERTY(Transient)
+		FBPVRComponentPosRep Devices[(uint8)EVRPosePacketDevice::DeviceCount];
+
+	FVRPosePacket() :
+		Sequence(0),
+		DeviceFlags(0)
+	{
+	}
+
+	FORCEINLINE bool HasDevice(EVRPosePacketDevice Device) const
+	{
+		return (DeviceFlags & (1 << (uint8)Device)) != 0;
+	}
+
+	FORCEINLINE void SetDevice(EVRPosePacketDevice Device, const FBPVRComponentPosRep& Transform)
+	{
+		DeviceFlags |= (1 << (uint8)Device);
+		Devices[(uint8)Device] = Transform;
+	}
+
+	FORCEINLINE void Reset()
+	{
+		DeviceFlags = 0;
+	}
+
+	// Handles wrap around, true if this packet was sent after the one with OtherSequence
+	FORCEINLINE bool IsNewerThan(uint16 OtherSequence) const
+	{
+		return (int16)(Sequence - OtherSequence) > 0;
+	}
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+	{
+		bOutSuccess = true;
+
+		Ar.SerializeBits(&DeviceFlags, (uint8)EVRPosePacketDevice::DeviceCount);
+		Ar << Sequence;
+
+		for (uint8 i = 0; i < (uint8)EVRPosePacketDevice::DeviceCount; i++)
+		{
+			if (!(DeviceFlags & (1 << i)))
+				continue;
+
+			// Same levels the device would have sent with its own RPC
+			Ar.SerializeBits(&Devices[i].QuantizationLevel, 1);
+			Ar.SerializeBits(&Devices[i].RotationQuantizationLevel, 1);
+			bOutSuccess &= Devices[i].SerializeTransform(Ar);
+		}
+
+		return bOutSuccess;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits< FVRPosePacket > : public TStructOpsTypeTraitsBase2<FVRPosePacket>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithNetSharedSerialization = true,
+	};
+};
+
 UENUM(Blueprintable)
 enum class EGripCollisionType : uint8
 {
@@ -1222,6 +1616,21 @@ struct TStructOpsTypeTraits< FBPAdvGripPhysicsSettings > : public TStructOpsType
 	};
 };
 
+// Precision that client auth throwing movement is replicated with
+// Location grid / rotation bits / velocity range, see FRepMovementVR::GetQuantizationSettings
+UENUM(BlueprintType)
+enum class EVRMovementQuantizationProfile : uint8
+{
+	// 0.01cm location and velocity, 16 bit rotation components, full velocity range
+	VRQUANT_Default UMETA(DisplayName = "Default"),
+	// 0.1cm location and velocity, 16 bit rotation components, velocities clamped to hand thrown speeds
+	VRQUANT_SmallProp UMETA(DisplayName = "Small Prop"),
+	// 1cm location and velocity, 8 bit rotation components, velocities clamped for clutter and debris
+	VRQUANT_Coarse UMETA(DisplayName = "Coarse"),
+
+	VRQUANT_MAX UMETA(Hidden)
+};
+
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
 struct VREXPANSIONPLUGIN_API FBPAdvGripSettings
 {
@@ -1245,16 +1654,23 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AdvancedGripSettings")
 		FBPAdvGripPhysicsSettings PhysicsSettings;
 
+	// Precision used when this object replicates its client auth throwing movement
+	// Not replicated, the profile is sent along with each movement update
+	UPROPERTY(EditAnywhere, NotReplicated, BlueprintReadWrite, Category = "AdvancedGripSettings")
+		EVRMovementQuantizationProfile MovementQuantizationProfile;
+
 	FBPAdvGripSettings() :
 		GripPriority(1),
 		bSetOwnerOnGrip(1),
-		bDisallowLerping(0)
+		bDisallowLerping(0),
+		MovementQuantizationProfile(EVRMovementQuantizationProfile::VRQUANT_Default)
 	{}
 
 	FBPAdvGripSettings(int GripPrio) :
 		GripPriority(GripPrio),
 		bSetOwnerOnGrip(1),
-		bDisallowLerping(0)
+		bDisallowLerping(0),
+		MovementQuantizationProfile(EVRMovementQuantizationProfile::VRQUANT_Default)
 	{}
 };
 
@@ -1376,6 +1792,54 @@ struct TStructOpsTypeTraits< FBPSecondaryGripInfo > : public TStructOpsTypeTrait
 
 #define INVALID_VRGRIP_ID 0
 
+// Resolved per grip dispatch information, built when the grip is notified so that the tick doesn't
+// need to re-query the interface and rebuild the grip script list every frame.
+// Call RefreshGripDispatchCache on the controller if you change an objects grip scripts while it is held.
+USTRUCT()
+struct VREXPANSIONPLUGIN_API FBPGripDispatchCache
+{
+	GENERATED_BODY()
+public:
+
+	// The root component and actor that this cache was resolved against
+	TWeakObjectPtr<UPrimitiveComponent> CachedRoot;
+	TWeakObjectPtr<AActor> CachedActor;
+
+	// Grip scripts pulled from the interfaced object, held here so they don't need to be re-gathered per tick
+	UPROPERTY(Transient)
+		TArray<TObjectPtr<UVRGripScriptBase>> GripScripts;
+
+	bool bIsValid;
+	bool bRootHasInterface;
+	bool bActorHasInterface;
+
+	// If any of the grip scripts alter the world transform of the grip
+	bool bHasWorldTransformScript;
+
+	FORCEINLINE bool IsValidFor(const UPrimitiveComponent* Root, const AActor* Actor) const
+	{
+		return bIsValid && CachedRoot.Get() == Root && CachedActor.Get() == Actor;
+	}
+
+	void Reset()
+	{
+		CachedRoot.Reset();
+		CachedActor.Reset();
+		GripScripts.Reset();
+		bIsValid = false;
+		bRootHasInterface = false;
+		bActorHasInterface = false;
+		bHasWorldTransformScript = false;
+	}
+
+	FBPGripDispatchCache() :
+		bIsValid(false),
+		bRootHasInterface(false),
+		bActorHasInterface(false),
+		bHasWorldTransformScript(false)
+	{}
+};
+
 USTRUCT(BlueprintType, Category = "VRExpansionLibrary")
 struct VREXPANSIONPLUGIN_API FBPActorGripInformation
 {
@@ -1501,9 +1965,14 @@ public:
 
 	}ValueCache;
 
+	// Resolved interface and grip script information for this grip, not replicated
+	UPROPERTY(Transient, NotReplicated)
+		FBPGripDispatchCache DispatchCache;
+
 	void ClearNonReppingItems()
 	{
 		ValueCache = FGripValueCache();
+		DispatchCache.Reset();
 		bColliding = false;
 		bIsLocked = false;
 		LastLockedRotation = FQuat::Identity;
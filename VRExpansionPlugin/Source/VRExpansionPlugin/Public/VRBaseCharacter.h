@@ -22,6 +22,29 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FVRPlayerStateReplicatedSignature, c
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FVRPlayerTeleportedSignature);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FVRPlayerNetworkCorrectedSignature);
 
+class AVRBaseCharacter;
+
+USTRUCT()
+struct FVRPosePacketTickFunction : public FTickFunction
+{
+	GENERATED_USTRUCT_BODY()
+
+		AVRBaseCharacter* Target;
+
+	virtual void ExecuteTick(float DeltaTime, enum ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FVRPosePacketTickFunction> : public TStructOpsTypeTraitsBase2<FVRPosePacketTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
 USTRUCT()
 struct VREXPANSIONPLUGIN_API FRepMovementVRCharacter : public FRepMovement
 {
@@ -328,6 +351,42 @@ public:
 	UFUNCTION(Unreliable, Server, WithValidation)
 		void Server_SendTransformRightController(FBPVRComponentPosRep NewTransform);
 
+	// If true then the camera and controllers stop sending their own RPCs and the character samples all three
+	// once per PosePacketNetUpdateRate and sends them in a single pose packet, this saves the per RPC overhead and keeps the samples aligned on the server
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacter|Networking")
+		bool bUseBundledPosePacket;
+
+	// Rate per second that the bundled pose packet is sent, replaces the devices own net update rates when bundling
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "VRBaseCharacter|Networking", meta = (ClampMin = "0", UIMin = "0", EditCondition = "bUseBundledPosePacket"))
+		float PosePacketNetUpdateRate;
+
+	float PosePacketNetUpdateCount;
+
+	// Returns true if the device should leave sending its transform to the characters pose packet
+	bool IsBundlingPoseFor(const USceneComponent* Device) const;
+
+	// Ticks after the camera and controllers have updated their tracking
+	FVRPosePacketTickFunction PosePacketTickFunction;
+	friend struct FVRPosePacketTickFunction;
+
+	// Samples the devices and sends the pose packet when the rate timer elapses
+	void TickPosePacket(float DeltaTime);
+
+	UFUNCTION(Unreliable, Server, WithValidation)
+		void Server_SendPosePacket(const FVRPosePacket& PosePacket);
+
+	// Last packet the client sent, devices are only included again once they differ from it
+	FVRPosePacket OutgoingPosePacket;
+
+	// Sequence of the next packet the client sends
+	uint16 NextPosePacketSequence;
+
+	// Newest packet the server has applied, used to reject out of order packets
+	uint16 LastAppliedPosePacketSequence;
+	bool bHasAppliedPosePacket;
+
+	virtual void RegisterActorTickFunctions(bool bRegister) override;
+
 	virtual void PreReplication(IRepChangedPropertyTracker & ChangedPropertyTracker) override;
 
 	// If true will replicate the capsule height on to clients, allows for dynamic capsule height changes in multiplayer
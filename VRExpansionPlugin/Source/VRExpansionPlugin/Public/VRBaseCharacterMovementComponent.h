@@ -32,6 +32,9 @@ public:
 	FVRCharacterNetworkMoveDataContainer VRNetworkMoveDataContainer;
 	FVRCharacterMoveResponseDataContainer VRMoveResponseDataContainer;
 
+	// Capsule values of received moves on the server, and the keyframe counter on the client, for delta encoded moves
+	FVRMoveDeltaHistory MoveDeltaHistory;
+
 	bool bNotifyTeleported;
 
 	/** BaseVR Character movement component belongs to */
@@ -258,6 +261,11 @@ public:
 	virtual void PhysCustom_Climbing(float deltaTime, int32 Iterations);
 	virtual void PhysCustom_LowGrav(float deltaTime, int32 Iterations);
 
+	// The delta history no longer matches what the other side has after any of these
+	virtual void ResetPredictionData_Client() override;
+	virtual void ResetPredictionData_Server() override;
+	virtual void OnClientTimeStampResetDetected() override;
+
 	// Teleport grips on correction to fixup issues
 	virtual void OnClientCorrectionReceived(class FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode) override;
 
@@ -304,8 +312,21 @@ public:
 		const struct FCollisionResponseParams& ResponseParam
 	) const override;*/
 
+	// Checks the floor cache before sweeping when vre.FloorCache is on
 	virtual void ComputeFloorDist(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, FFindFloorResult& OutFloorResult, float SweepRadius, const FHitResult* DownwardSweepResult = NULL) const override;
 
+	// The floor sweeps of ComputeFloorDist without the cache
+	void ComputeFloorDist_Impl(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, FFindFloorResult& OutFloorResult, float SweepRadius, const FHitResult* DownwardSweepResult = NULL) const;
+
+	// Recent floor results, mutable as it is filled from the const floor checks
+	mutable FVRFloorCache FloorCache;
+
+	// Forces the next floor checks to sweep, called for move actions that relocate the character
+	void InvalidateFloorCache()
+	{
+		FloorCache.Invalidate();
+	}
+
 	// Need to use actual capsule location for step up
 	virtual bool VRClimbStepUp(const FVector& GravDir, const FVector& Delta, const FHitResult &InHit, FStepDownResult* OutStepDownResult = nullptr);
 
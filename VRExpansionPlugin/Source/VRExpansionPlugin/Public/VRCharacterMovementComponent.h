@@ -22,6 +22,60 @@ DECLARE_LOG_CATEGORY_EXTERN(LogVRCharacterMovement, Log, All);
 
 //FCharacterMoveResponseDataContainer VRMoveResponseDataContainer;
 
+// Everything ServerMoveHandleClientErrorVR needs between its prepare, check, and apply steps.
+// Split out so that batched server moves can run the error checks of all characters in parallel.
+struct FVRServerMoveErrorState
+{
+	float ClientTimeStamp;
+	float DeltaTime;
+	FVector Accel;
+	FVector RelativeClientLoc;
+	float ClientYaw;
+	UPrimitiveComponent* ClientMovementBase;
+	FName ClientBaseBoneName;
+	uint8 ClientMovementMode;
+
+	FVector ClientLoc;
+	FVector ServerLoc;
+	FVector RelativeLocation;
+	FVector RelativeVelocity;
+	UPrimitiveComponent* MovementBase;
+	FName MovementBaseBoneName;
+	bool bServerIsFalling;
+	bool bClientIsFalling;
+	bool bUseLastBase;
+	bool bFallingWithinAcceptableError;
+	bool bDeferServerCorrectionsWhenFalling;
+	bool bInClientAuthoritativeMovementMode;
+
+	// Result of the check step
+	bool bNeedsCorrection;
+
+	FVRServerMoveErrorState() :
+		ClientTimeStamp(0.0f),
+		DeltaTime(0.0f),
+		Accel(FVector::ZeroVector),
+		RelativeClientLoc(FVector::ZeroVector),
+		ClientYaw(0.0f),
+		ClientMovementBase(nullptr),
+		ClientBaseBoneName(NAME_None),
+		ClientMovementMode(0),
+		ClientLoc(FVector::ZeroVector),
+		ServerLoc(FVector::ZeroVector),
+		RelativeLocation(FVector::ZeroVector),
+		RelativeVelocity(FVector::ZeroVector),
+		MovementBase(nullptr),
+		MovementBaseBoneName(NAME_None),
+		bServerIsFalling(false),
+		bClientIsFalling(false),
+		bUseLastBase(false),
+		bFallingWithinAcceptableError(false),
+		bDeferServerCorrectionsWhenFalling(false),
+		bInClientAuthoritativeMovementMode(false),
+		bNeedsCorrection(false)
+	{}
+};
+
 
 //=============================================================================
 /**
@@ -135,8 +189,17 @@ public:
 	*/
 	virtual void ServerMoveHandleClientErrorVR(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& RelativeClientLocation, float ClientYaw, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode);
 
+	// The three steps of ServerMoveHandleClientErrorVR
+	// Begin resolves the client location and handles the falling / landing leash, returns false if no error handling is needed this move
+	// Check only writes to this component and its prediction data, batched moves can run it in parallel with other characters checks
+	// End queues the client adjustment or acks the move
+	bool ServerMoveBeginClientErrorVR(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& RelativeClientLocation, float ClientYaw, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode, FVRServerMoveErrorState& OutState);
+	bool ServerMoveCheckClientErrorVR(const FVRServerMoveErrorState& State);
+	void ServerMoveEndClientErrorVR(const FVRServerMoveErrorState& State);
+
 	/**
 	* Check for Server-Client disagreement in position or other movement state important enough to trigger a client correction.
+	* With vre.BatchServerMoves.ParallelChecks on this runs on worker threads, overrides must then only read shared state and only write to this component.
 	* @see ServerMoveHandleClientError()
 	*/
 	virtual bool ServerCheckClientErrorVR(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, float ClientYaw, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode);
@@ -167,6 +230,31 @@ public:
 
 	virtual void ServerMove_PerformMovement(const FCharacterNetworkMoveData& MoveData) override;
 
+	// Queues the moves into the UVRServerMoveBatchSubsystem when vre.BatchServerMoves is on
+	virtual void ServerMove_HandleMoveData(const FCharacterNetworkMoveDataContainer& MoveDataContainer) override;
+
+	// Batched server move steps, called by the UVRServerMoveBatchSubsystem once per frame for every character with queued moves
+	// PreValidate and CheckBatchedMoveError can be run in parallel across characters (vre.BatchServerMoves.ParallelChecks), the others are always run serially
+	void PreValidateBatchedMoves();
+	void PerformBatchedMoves();
+	void CheckBatchedMoveError();
+	void ApplyBatchedMoveError();
+
+	bool HasBatchedMoves() const
+	{
+		return NumBatchedMoveContainers > 0;
+	}
+
+	// Moves received this frame while batching, kept allocated between frames
+	TIndirectArray<FVRCharacterNetworkMoveDataContainer> BatchedMoveContainers;
+	TArray<bool> BatchedMoveSkipped;
+	int32 NumBatchedMoveContainers;
+
+	// Error handling for the final new move of the batch, deferred so that the check can run in parallel
+	FVRServerMoveErrorState BatchedMoveErrorState;
+	bool bHasBatchedMoveError;
+	bool bDeferBatchedMoveError;
+
 	FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 	FNetworkPredictionData_Server* GetPredictionData_Server() const override;
 
@@ -12,6 +12,7 @@
 #include "TimerManager.h"
 #include "VRGestureComponent.generated.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogVRGestures, Log, All);
 DECLARE_STATS_GROUP(TEXT("TICKGesture"), STATGROUP_TickGesture, STATCAT_Advanced);
 
 class USplineMeshComponent;
@@ -140,6 +141,54 @@ public:
 	}
 };
 
+// Structure of arrays copy of gesture samples for the DTW engine, with an optional envelope for the LB_Keogh lower bound
+struct VREXPANSIONPLUGIN_API FVRGestureSampleSoA
+{
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+
+	// Per index min / max of the samples within the band window, or a single box if bGlobalEnvelope
+	TArray<float> EnvMinX, EnvMinY, EnvMinZ;
+	TArray<float> EnvMaxX, EnvMaxY, EnvMaxZ;
+	int32 EnvelopeBandWidth;
+	bool bGlobalEnvelope;
+
+	FVRGestureSampleSoA() :
+		EnvelopeBandWidth(0),
+		bGlobalEnvelope(true)
+	{}
+
+	FORCEINLINE int32 Num() const
+	{
+		return X.Num();
+	}
+
+	// Fills from the sample array, pre-applying the scaler and optionally mirroring on the Y axis
+	void SetFromSamples(const TArray<FVector>& Samples, float Scaler = 1.f, bool bMirror = false);
+
+	// Builds the envelope for lower bounding, BandWidth <= 0 uses the bounds of the whole sequence
+	void BuildEnvelope(int32 BandWidth);
+};
+
+// Reusable DTW kernel, holds its own scratch rows so running it doesn't allocate after the first use
+struct VREXPANSIONPLUGIN_API FVRGestureDTWEngine
+{
+	// LB_Keogh lower bound of the DTW cost between the input (which must have an envelope of the same band) and the example.
+	// Early outs once the bound passes the cutoff.
+	static float LowerBound(const FVRGestureSampleSoA& Input, const FVRGestureSampleSoA& Example, float Cutoff = MAX_FLT);
+
+	// Rolling two row DTW, matches the full example against all endings of the input like the original dtw function.
+	// BandWidth <= 0 disables the Sakoe-Chiba band, returns MAX_FLT once every path is past the cutoff.
+	float ComputeDTW(const FVRGestureSampleSoA& Input, const FVRGestureSampleSoA& Example, int32 MaxSlope, int32 BandWidth = 0, float Cutoff = MAX_FLT);
+
+private:
+
+	TArray<float> CostRows[2];
+	TArray<int32> SlopeIRows[2];
+	TArray<int32> SlopeJRows[2];
+};
+
 /**
 * Items Database DataAsset, here we can save all of our game items
 */
@@ -156,15 +205,39 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures")
 		float TargetGestureScale;
 
+	// Databases with at least this many gestures will be checked in parallel during recognition, 0 disables it
+	// Off by default, the task fan out only pays off on large databases, profile before enabling
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures|Advanced")
+		int32 ParallelRecognitionThreshold;
+
 	UGesturesDatabase()
 	{
 		TargetGestureScale = 100.0f;
+		ParallelRecognitionThreshold = 0;
 	}
 
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	// Recalculate size of gestures and re-scale them to the TargetGestureScale (if bScaleToDatabase is true)
 	UFUNCTION(BlueprintCallable, Category = "VRGestures")
 		void RecalculateGestures(bool bScaleToDatabase = true);
 
+	// Rebuilds all of the packed gesture data
+	void PackGestures();
+
+	// Repacks any gestures whose samples changed since they were packed, Gestures can be edited directly from blueprint
+	void EnsurePackedGestures();
+
+	// Packed samples of a gesture, only valid after EnsurePackedGestures
+	FORCEINLINE const FVRGestureSampleSoA& GetPackedGesture(int32 GestureIndex) const
+	{
+		return PackedGestures[GestureIndex];
+	}
+
 	// Fills a spline component with a gesture, optionally also generates spline mesh components for it (uses ones already attached if possible)
 	UFUNCTION(BlueprintCallable, Category = "VRGestures")
 		void FillSplineWithGesture(UPARAM(ref)FVRGesture &Gesture, USplineComponent * SplineComponent, bool bCenterPointsOnSpline = true, bool bScaleToBounds = false, float OptionalBounds = 0.0f, bool bUseCurvedPoints = true, bool bFillInSplineMeshComponents = true, UStaticMesh * Mesh = nullptr, UMaterial * MeshMat = nullptr);
@@ -173,6 +246,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "VRGestures")
 		bool ImportSplineAsGesture(USplineComponent * HostSplineComponent, FString GestureName, bool bKeepSplineCurves = true, float SegmentLen = 10.0f, bool bScaleToDatabase = true);
 
+private:
+
+	void PackGesture(int32 GestureIndex);
+
+	// SoA copies of the gesture samples for the DTW engine, already in matching order (newest sample first)
+	TArray<FVRGestureSampleSoA> PackedGestures;
+
+	// Crc of the samples each packed gesture was built from, compared against the live samples before recognition
+	TArray<uint32> PackedGestureHashes;
 };
 
 
@@ -292,6 +374,33 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures")
 	int maxSlope;
 
+	// Sakoe-Chiba band width for the DTW, samples can only be matched within this many steps of each other
+	// 0 disables the band and checks the full table (original behavior)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures|Advanced")
+	int DTWBandWidth;
+
+	// If true we will run an LB_Keogh lower bound check and throw out gestures that can't beat the current best before running the full DTW
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "VRGestures|Advanced")
+	bool bUseLowerBoundRejection;
+
+	// DTW kernel and its scratch buffers
+	FVRGestureDTWEngine DTWEngine;
+
+	// Scratch copies of the input for the current recognition pass, indexed by (bScaled | bMirrored << 1)
+	FVRGestureSampleSoA PreparedInputs[4];
+	bool bPreparedInputValid[4];
+
+	// Per chunk DTW engines and per gesture results for parallel recognition, kept around to avoid re-allocating
+	TArray<FVRGestureDTWEngine> ParallelDTWEngines;
+	TArray<float> ParallelResults;
+
+	// Returns the input prepared with the given scaling / mirroring, building it for this pass if needed
+	const FVRGestureSampleSoA& GetPreparedInput(const FVRGesture& InputGesture, float Scaler, bool bScaled, bool bMirrored);
+
+	// Checks a single database gesture against the prepared inputs, returns the normalized DTW distance or MAX_FLT if it was thrown out.
+	// The inputs must already be prepared when this is called off of the game thread.
+	float CheckGestureCandidate(const FVRGesture& InputGesture, int32 GestureIndex, float Scaler, float BestDistance, FVRGestureDTWEngine& Engine);
+
 	UPROPERTY(BlueprintReadOnly, Category = "VRGestures")
 	EVRGestureState CurrentState;
 
@@ -358,11 +467,12 @@ public:
 	// Recognize gesture in the given sequence.
 	// It will always assume that the gesture ends on the last observation of that sequence.
 	// If the distance between the last observations of each sequence is too great, or if the overall DTW distance between the two sequences is too great, no gesture will be recognized.
-	void RecognizeGesture(FVRGesture inputGesture);
+	void RecognizeGesture(const FVRGesture& inputGesture);
 
 
 	// Compute the min DTW distance between seq2 and all possible endings of seq1.
-	float dtw(FVRGesture seq1, FVRGesture seq2, bool bMirrorGesture = false, float Scaler = 1.f);
+	// Reference implementation, recognition runs through the DTWEngine instead.
+	float dtw(const FVRGesture& seq1, const FVRGesture& seq2, bool bMirrorGesture = false, float Scaler = 1.f);
 
 };
 
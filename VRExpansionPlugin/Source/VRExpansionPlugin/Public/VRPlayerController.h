@@ -4,6 +4,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/LocalPlayer.h"
+#include "Grippables/GrippablePhysicsReplication.h"
 #include "VRPlayerController.generated.h"
 
 // A base player controller specifically for handling OnCameraManagerCreated.
@@ -29,6 +30,10 @@ public:
 		}
 	}
 
+	// Client auth throwing movement of all of this players thrown objects for the frame, sent by the UVRClientAuthThrowBatchSubsystem
+	UFUNCTION(UnReliable, Server, WithValidation, Category = "Networking")
+		void Server_GetClientAuthReplicationBatch(const TArray<FVRClientAuthMovementBatchEntry>& MovementBatch);
+
 };
 
 
@@ -109,6 +109,7 @@ protected:
 
 public:
 	void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void InitializeComponent() override;
 
 	bool IsLocallyControlled() const;
@@ -195,6 +196,23 @@ public:
 	FRotator lastCameraRot = FRotator::ZeroRotator;
 	bool bTickedOnce = false;
 
+	// Re-enables the tick of a remote root that went to sleep with vre.VRRoot.SleepRemoteTick
+	// Called when the camera moves and when tracking is paused or unpaused
+	void WakeRemoteTick();
+
+	// Remote roots stop ticking while their camera is still and wake on its transform updates
+	bool bRemoteTickSleeping = false;
+	TWeakObjectPtr<USceneComponent> RemoteTickWakeComponent;
+	FDelegateHandle RemoteTickWakeHandle;
+
+	void SetRemoteTickSleeping(bool bSleep);
+	void OnTargetTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	// Capsule location and half height of the last full overlap update, locally controlled roots don't update
+	// overlaps for roomscale movement closer than vre.VRRoot.OverlapSkipDistance to it
+	FVector LastOverlapUpdateLocation = FVector::ZeroVector;
+	float LastOverlapUpdateHalfHeight = -1.0f;
+
 	// While misnamed, is true if we collided with a wall/obstacle due to the HMDs movement in this frame (not movement components)
 	UPROPERTY(BlueprintReadOnly, Category = "VRExpansionLibrary")
 	bool bHadRelativeMovement;